@@ -2,32 +2,49 @@
 #define ALLOCATION_ENGINE_H
 
 #include <vector>
+#include "AllocationLadder.h"
+#include "Vehicle.h"
 
 class Zone;
 class ParkingRequest;
-class RollbackManager;
+class SlotAttributeIndex;
 
+// Slots are found through the SlotAttributeIndex, rung by rung down the
+// request's attribute ladder within each step of the zone / area search
+// order (both in AllocationLadder, shared with StaticCity), so a request
+// takes the best fitting slot of its preferred zone before trying
+// another zone.
 class AllocationEngine {
 private:
+    friend class AllocationLadder;
+
     std::vector<Zone*> zones;
-    RollbackManager* rollbackManager;
+    const SlotAttributeIndex& index;
 
-    
-    bool allocateInZone(Zone* zone, ParkingRequest& request, int& fee);
-   
-    bool allocateInSpecificArea(Zone* zone, int areaId, ParkingRequest& request, int& fee);
-    
-    int calculateBaseFee(int type) const;  
+    // -------- City for AllocationLadder --------
+    int zoneCount() const { return static_cast<int>(zones.size()); }
+    int areaCount(int zoneId) const;
+    bool mayHaveFree(int zoneId, const SlotFilter& filter) const;
+    bool allocateIn(int zoneId, int areaId, const SlotFilter& filter, ParkingRequest& request);
+    void notice(AllocationLadder::Notice notice);
 
 public:
-    
-    AllocationEngine(const std::vector<Zone*>& zones, RollbackManager* rb);
+    // Quote rules shared with StaticCity: base fee by type, plus a
+    // penalty when the slot is outside the requested zone
+    static const int CROSS_ZONE_PENALTY = AllocationLadder::CROSS_ZONE_PENALTY;
+    static int baseFee(Vehicle::VehicleType type) { return AllocationLadder::baseFee(type); }
+
+    // The caller records successful allocations for rollback
+    AllocationEngine(const std::vector<Zone*>& zones, const SlotAttributeIndex& index);
     // --------  Allocation with specific area preference --------
     bool allocateSlotWithArea(ParkingRequest& request, int preferredArea, int& totalFee, bool& crossZoneUsed);
 
     // -------- Allocation --------
     bool allocateSlot(ParkingRequest& request, int& totalFee, bool& crossZoneUsed);
+
+    // -------- Topology --------
+    void addZone(Zone* zone);
     
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,166 @@
+#ifndef ALLOCATION_LADDER_H
+#define ALLOCATION_LADDER_H
+
+#include <cstdint>
+#include "ParkingRequest.h"
+#include "ParkingSlot.h"
+#include "SpanTracer.h"
+#include "Vehicle.h"
+
+// One rung of the attribute ladder: slot flags that must be present / absent
+struct SlotFilter {
+    uint8_t required;
+    uint8_t forbidden;
+};
+
+// The allocation policy of every city: the quote, the attribute ladder
+// and the zone / area search order. AllocationEngine (ParkingSystem) and
+// StaticCity differ only in how they find a free slot, so the search is
+// written once, over a City that offers (AllocationLadder is its friend):
+//
+//   int zoneCount() const;              zones are 1..zoneCount()
+//   int areaCount(int zoneId) const;    areas are 1..areaCount(zoneId)
+//   bool mayHaveFree(int zoneId, const SlotFilter& filter) const;
+//       false only when no free slot of the zone can match the filter
+//   bool allocateIn(int zoneId, int areaId, const SlotFilter& filter, ParkingRequest& request);
+//       allocates the lowest free slot of the area that matches the filter
+//   void notice(AllocationLadder::Notice notice);
+//       the request fell back past its preferred area
+//
+// Search order: the requested zone, then the others in id order. With a
+// preferred area: that area, the other areas of the zone, the same area
+// in other zones, then the plain search. Within each step the rungs of
+// the ladder are tried in order, so the best fitting slot of a step wins
+// over a better fit further down the order.
+class AllocationLadder {
+public:
+    static const int MAX_FILTERS = 4;
+
+    // Quote: base fee by type, plus a penalty outside the requested zone
+    static const int CROSS_ZONE_PENALTY = 50;
+    static int baseFee(Vehicle::VehicleType type) { return type == Vehicle::CAR ? 100 : 50; }
+
+    enum Notice {
+        OTHER_AREA,          // preferred area full, another area of the zone
+        OTHER_ZONE,          // preferred area's zone full, same area elsewhere
+        ANY_SLOT             // no slot in any preferred area, plain search next
+    };
+
+    // Required + preferred attributes, exact fit before a slot with
+    // extras; then the same for the required ones alone. Extras are
+    // spared for requests that want them, and reserved slots only ever
+    // go to requests that require them.
+    static int filtersFor(const ParkingRequest& request, SlotFilter* out) {
+        uint8_t required = request.getRequiredAttributes();
+        uint8_t notReserved = ParkingSlot::RESERVED & ~required;
+        uint8_t wanted = required | (request.getPreferredAttributes() & ~notReserved);
+        uint8_t unwanted = ParkingSlot::ALL_ATTRIBUTES & ~wanted;
+
+        int count = 0;
+        out[count++] = { wanted, unwanted };
+        if (unwanted != notReserved)
+            out[count++] = { wanted, notReserved };
+        if (wanted != required) {
+            out[count++] = { required, unwanted };
+            if (unwanted != notReserved)
+                out[count++] = { required, notReserved };
+        }
+        return count;
+    }
+
+    template<typename City>
+    static bool allocate(City& city, ParkingRequest& request, int& fee, bool& crossZoneUsed) {
+        int requested = request.getRequestedZoneId();
+        crossZoneUsed = false;
+        fee = 0;
+
+        TRACE_SPAN(sameZoneSpan, "sameZoneSearch");
+        if (requested >= 1 && requested <= city.zoneCount() && allocateInZone(city, requested, 0, request)) {
+            fee = baseFee(request.getVehicleType());
+            return true;
+        }
+        TRACE_END(sameZoneSpan);
+
+        TRACE_SPAN(crossZoneSpan, "crossZoneSearch");
+        for (int z = 1; z <= city.zoneCount(); z++) {
+            if (z != requested && allocateInZone(city, z, 0, request)) {
+                crossZoneUsed = true;
+                fee = baseFee(request.getVehicleType()) + CROSS_ZONE_PENALTY;
+                return true;
+            }
+        }
+        TRACE_END(crossZoneSpan);
+        return false;
+    }
+
+    template<typename City>
+    static bool allocateWithArea(City& city, ParkingRequest& request, int preferredArea,
+                                 int& fee, bool& crossZoneUsed) {
+        int requested = request.getRequestedZoneId();
+        crossZoneUsed = false;
+        fee = 0;
+
+        if (requested >= 1 && requested <= city.zoneCount()) {
+            TRACE_SPAN(exactAreaSpan, "exactAreaSearch");
+            if (allocateInArea(city, requested, preferredArea, request)) {
+                fee = baseFee(request.getVehicleType());
+                return true;
+            }
+            TRACE_END(exactAreaSpan);
+
+            TRACE_SPAN(otherAreaSpan, "differentAreaSearch");
+            if (allocateInZone(city, requested, preferredArea, request)) {
+                fee = baseFee(request.getVehicleType());
+                city.notice(OTHER_AREA);
+                return true;
+            }
+            TRACE_END(otherAreaSpan);
+        }
+
+        TRACE_SPAN(crossZoneSpan, "crossZoneSameArea");
+        for (int z = 1; z <= city.zoneCount(); z++) {
+            if (z != requested && allocateInArea(city, z, preferredArea, request)) {
+                crossZoneUsed = true;
+                fee = baseFee(request.getVehicleType()) + CROSS_ZONE_PENALTY;
+                city.notice(OTHER_ZONE);
+                return true;
+            }
+        }
+        TRACE_END(crossZoneSpan);
+
+        city.notice(ANY_SLOT);
+        TRACE_SPAN(fallbackSpan, "autoFallback");
+        return allocate(city, request, fee, crossZoneUsed);
+    }
+
+private:
+    // Every rung over the zone's areas (except skipAreaId) before the next rung
+    template<typename City>
+    static bool allocateInZone(City& city, int zoneId, int skipAreaId, ParkingRequest& request) {
+        SlotFilter filters[MAX_FILTERS];
+        int filterCount = filtersFor(request, filters);
+        int areas = city.areaCount(zoneId);
+        for (int f = 0; f < filterCount; f++) {
+            if (!city.mayHaveFree(zoneId, filters[f]))
+                continue;
+            for (int a = 1; a <= areas; a++)
+                if (a != skipAreaId && city.allocateIn(zoneId, a, filters[f], request))
+                    return true;
+        }
+        return false;
+    }
+
+    template<typename City>
+    static bool allocateInArea(City& city, int zoneId, int areaId, ParkingRequest& request) {
+        if (areaId < 1 || areaId > city.areaCount(zoneId))
+            return false;
+        SlotFilter filters[MAX_FILTERS];
+        int filterCount = filtersFor(request, filters);
+        for (int f = 0; f < filterCount; f++)
+            if (city.allocateIn(zoneId, areaId, filters[f], request))
+                return true;
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "ParkingSystem.h"
+#include "AsyncParking.h"
+#include "ConsoleMute.h"
+
+// Many in-flight operations on a few threads through the coroutine API.
+//
+//   AsyncBenchmark [--clients N] [--cycles N] [--threads N]
+//
+// Spawns N client coroutines (default 5000) on an executor with --threads
+// workers (default 2). Each client runs --cycles PARK/OCCUPY/RELEASE
+// cycles with its own plates, awaiting every step. Reports throughput and
+// the peak number of operations waiting at once. Needs -std=c++20.
+
+#if defined(__cpp_impl_coroutine)
+
+typedef std::chrono::steady_clock WallClock;
+
+struct ClientCounters {
+    std::atomic<long long> ok{0};
+    std::atomic<long long> failed{0};
+    std::atomic<long long> charged{0};
+    std::atomic<int> inFlight{0};
+    std::atomic<int> peakInFlight{0};
+
+    void enter() {
+        int now = inFlight.fetch_add(1) + 1;
+        int peak = peakInFlight.load();
+        while (now > peak && !peakInFlight.compare_exchange_weak(peak, now)) {}
+    }
+    void leave(bool success) {
+        inFlight.fetch_sub(1);
+        (success ? ok : failed).fetch_add(1);
+    }
+};
+
+static Task<void> client(AsyncParkingSystem& parking, int id, int cycles, int zones, ClientCounters* counters) {
+    char text[24];
+    for (int i = 0; i < cycles; i++) {
+        // A plate parks once, so every cycle arrives in a new vehicle
+        std::snprintf(text, sizeof(text), "AC%06dC%d", id, i);
+        VehiclePlate plate(text);
+
+        counters->enter();
+        ParkResult park = co_await parking.park(plate, Vehicle::CAR, 1 + (id + i) % zones);
+        counters->leave(park.ok());
+        if (!park.ok())
+            continue;
+
+        counters->enter();
+        OperationResult occupy = co_await parking.occupy(plate, Vehicle::CAR);
+        counters->leave(occupy.ok());
+
+        counters->enter();
+        ReleaseResult release = co_await parking.release(plate, Vehicle::CAR);
+        counters->leave(release.ok());
+        if (release.ok())
+            counters->charged += release.chargePaisa;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int clients = 5000;
+    int cycles = 20;
+    int threads = 2;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--clients") == 0 && i + 1 < argc) clients = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) cycles = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else {
+            std::cerr << "usage: AsyncBenchmark [--clients N] [--cycles N] [--threads N]\n";
+            return 1;
+        }
+    }
+
+    // Enough slots that every client can hold one at a time
+    int zones = 15, areas = 3;
+    int slots = (clients + zones * areas - 1) / (zones * areas) + 1;
+    ClientCounters counters;
+    double seconds;
+    IngestStats stats;
+    {
+        ConsoleMute mute;
+        ParkingSystem system(CityLayout(zones, areas, slots));
+        AsyncExecutor executor(threads);
+        IngestConfig config;
+        config.capacity = static_cast<size_t>(clients) * 2;
+        AsyncParkingSystem parking(system, executor, config);
+
+        auto start = WallClock::now();
+        for (int c = 0; c < clients; c++)
+            executor.spawn(client(parking, c, cycles, zones, &counters));
+        executor.waitIdle();
+        seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+        stats = parking.getStats();
+    }
+
+    long long total = counters.ok + counters.failed;
+    std::printf("%d clients x %d cycles on %d executor threads\n", clients, cycles, threads);
+    std::printf("operations      %lld (%lld ok, %lld failed) in %.2f s = %.0f ops/s\n",
+                total, counters.ok.load(), counters.failed.load(), seconds, total / seconds);
+    std::printf("peak in flight  %d\n", counters.peakInFlight.load());
+    std::printf("engine batches  %llu (avg %.1f)  queue p99 %.1f us\n",
+                static_cast<unsigned long long>(stats.batches), stats.getAverageBatch(),
+                stats.queueLatency.percentile(0.99) / 1000.0);
+    std::printf("charged         %lld paisa\n", counters.charged.load());
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cerr << "AsyncBenchmark needs C++20 coroutines (build with -std=c++20)\n";
+    return 1;
+}
+
+#endif
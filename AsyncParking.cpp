@@ -0,0 +1,157 @@
+#include "AsyncParking.h"
+
+#if defined(__cpp_impl_coroutine)
+
+// -------- Executor --------
+// Self-destroying wrapper that keeps a spawned task alive until it ends
+struct AsyncExecutor::Detached {
+    struct promise_type {
+        Detached get_return_object() { return Detached{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+AsyncExecutor::Detached AsyncExecutor::runDetached(AsyncExecutor* executor, Task<void> task) {
+    co_await task;
+    executor->finished();
+}
+
+AsyncExecutor::AsyncExecutor(int threads) : stopping(false), outstanding(0) {
+    if (threads < 1)
+        threads = 1;
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(&AsyncExecutor::work, this);
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        stopping = true;
+    }
+    hasWork.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void AsyncExecutor::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        ready.push_back(handle);
+    }
+    hasWork.notify_one();
+}
+
+void AsyncExecutor::work() {
+    for (;;) {
+        std::coroutine_handle<> next;
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            hasWork.wait(lock, [this]() { return stopping || !ready.empty(); });
+            if (ready.empty())
+                return;
+            next = ready.front();
+            ready.pop_front();
+        }
+        next.resume();
+    }
+}
+
+void AsyncExecutor::spawn(Task<void> task) {
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        outstanding++;
+    }
+    post(runDetached(this, std::move(task)).handle);
+}
+
+void AsyncExecutor::finished() {
+    std::lock_guard<std::mutex> lock(guard);
+    if (--outstanding == 0)
+        idle.notify_all();
+}
+
+void AsyncExecutor::waitIdle() {
+    std::unique_lock<std::mutex> lock(guard);
+    idle.wait(lock, [this]() { return outstanding == 0; });
+}
+
+// -------- Async System --------
+static IngestConfig rejectWhenFull(IngestConfig config) {
+    config.backpressure = IngestConfig::REJECT;
+    return config;
+}
+
+AsyncParkingSystem::AsyncParkingSystem(ParkingSystem& system, AsyncExecutor& e, const IngestConfig& config)
+    : executor(e), engine(system, rejectWhenFull(config)) {
+    engine.start();
+}
+
+AsyncParkingSystem::~AsyncParkingSystem() {
+    engine.stop();
+}
+
+// Runs on the engine thread. Nothing may touch the awaiter after post():
+// a worker can resume (and finish) the coroutine immediately.
+void AsyncParkingSystem::resume(const IngestResult& result, void* context) {
+    IngestAwaiter* awaiter = static_cast<IngestAwaiter*>(context);
+    awaiter->result = result;
+    awaiter->owner->executor.post(awaiter->waiting);
+}
+
+// Returning false resumes the caller at once with a REJECTED result.
+// After a successful submit the engine may already have resumed the
+// coroutine, so the awaiter is not read again here.
+bool AsyncParkingSystem::IngestAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    waiting = handle;
+    if (owner->engine.submit(command, &AsyncParkingSystem::resume, this))
+        return true;
+    result.status = IngestResult::REJECTED;
+    return false;
+}
+
+AsyncParkingSystem::IngestAwaiter AsyncParkingSystem::submit(const IngestCommand& command) {
+    return IngestAwaiter{ this, command, IngestResult(), nullptr };
+}
+
+static AsyncStatus statusOf(const IngestResult& result) {
+    if (result.status == IngestResult::REJECTED)
+        return ASYNC_REJECTED;
+    return result.ok ? ASYNC_OK : ASYNC_FAILED;
+}
+
+Task<ParkResult> AsyncParkingSystem::park(VehiclePlate plate, Vehicle::VehicleType type, int zoneId, int areaId) {
+    IngestResult result = co_await submit(IngestCommand::park(plate, type, zoneId, areaId));
+    co_return ParkResult{ statusOf(result), result.slotId, result.zoneId, result.areaId, result.fee, result.crossZone };
+}
+
+Task<OperationResult> AsyncParkingSystem::occupy(VehiclePlate plate, Vehicle::VehicleType type) {
+    IngestResult result = co_await submit(IngestCommand::occupy(plate, type));
+    co_return OperationResult{ statusOf(result) };
+}
+
+Task<ReleaseResult> AsyncParkingSystem::release(VehiclePlate plate, Vehicle::VehicleType type) {
+    IngestResult result = co_await submit(IngestCommand::release(plate, type));
+    co_return ReleaseResult{ statusOf(result), result.charge };
+}
+
+Task<OperationResult> AsyncParkingSystem::cancel(VehiclePlate plate, Vehicle::VehicleType type) {
+    IngestResult result = co_await submit(IngestCommand::cancel(plate, type));
+    co_return OperationResult{ statusOf(result) };
+}
+
+Task<OperationResult> AsyncParkingSystem::rollback(int count) {
+    IngestResult result = co_await submit(IngestCommand::rollback(count));
+    co_return OperationResult{ statusOf(result) };
+}
+
+IngestStats AsyncParkingSystem::getStats() const {
+    return engine.getStats();
+}
+
+#endif
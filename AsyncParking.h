@@ -0,0 +1,229 @@
+#ifndef ASYNC_PARKING_H
+#define ASYNC_PARKING_H
+
+// Coroutine API over IngestEngine. Needs C++20 (-std=c++20); under older
+// standards this header is empty so the rest of the tree still builds.
+#if defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "IngestEngine.h"
+#include "Vehicle.h"
+#include "VehiclePlate.h"
+
+class ParkingSystem;
+
+// -------- Task --------
+// Lazy coroutine result: the body starts when the task is awaited and
+// resumes the awaiting coroutine directly when it finishes (no queue hop).
+template<typename T> class Task;
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> done) noexcept {
+            std::coroutine_handle<> next = done.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+    void return_value(T result) { value.emplace(std::move(result)); }
+
+    T take() {
+        if (error)
+            std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+
+    void take() {
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+template<typename T>
+class Task {
+public:
+    typedef TaskPromise<T> promise_type;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle) handle.destroy(); }
+
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() { return handle.promise().take(); }
+};
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// -------- Executor --------
+// A few worker threads resuming ready coroutines from one queue. Nothing
+// blocks a worker: operations park the coroutine and the engine thread
+// posts it back here when the result is in.
+class AsyncExecutor {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::coroutine_handle<>> ready;
+    std::mutex guard;
+    std::condition_variable hasWork;
+    std::condition_variable idle;
+    bool stopping;
+    int outstanding;           // spawned tasks not yet finished, under guard
+
+    void work();
+    void finished();
+
+    struct Detached;
+    static Detached runDetached(AsyncExecutor* executor, Task<void> task);
+
+    AsyncExecutor(const AsyncExecutor&);
+    AsyncExecutor& operator=(const AsyncExecutor&);
+
+public:
+    explicit AsyncExecutor(int threads = 2);
+    ~AsyncExecutor();          // waits for spawned tasks, then joins
+
+    void post(std::coroutine_handle<> handle);
+
+    // Runs the task to completion on the workers; nothing to join
+    void spawn(Task<void> task);
+
+    // Blocks the caller until every spawned task has finished
+    void waitIdle();
+
+    // co_await executor.schedule() moves the coroutine onto a worker
+    struct ScheduleAwaiter {
+        AsyncExecutor* executor;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { executor->post(handle); }
+        void await_resume() const noexcept {}
+    };
+    ScheduleAwaiter schedule() { return ScheduleAwaiter{ this }; }
+};
+
+// -------- Results --------
+enum AsyncStatus {
+    ASYNC_OK,
+    ASYNC_FAILED,              // refused by the system (same cases as the blocking API returning false)
+    ASYNC_REJECTED             // never ran: ingestion queue full or stopped
+};
+
+struct ParkResult {
+    AsyncStatus status;
+    int slotId;
+    int zoneId;
+    int areaId;
+    int fee;
+    bool crossZone;
+
+    bool ok() const { return status == ASYNC_OK; }
+};
+
+struct ReleaseResult {
+    AsyncStatus status;
+    int64_t chargePaisa;
+
+    bool ok() const { return status == ASYNC_OK; }
+};
+
+struct OperationResult {
+    AsyncStatus status;
+
+    bool ok() const { return status == ASYNC_OK; }
+};
+
+// -------- Async System --------
+// Every operation is queued on an IngestEngine that owns the system; the
+// awaiting coroutine is suspended (no thread held) until the engine has
+// applied it, then resumed on the executor with a structured result.
+// Thousands of operations can be in flight on a couple of threads.
+// Submits run on executor workers, so the engine always uses REJECT
+// backpressure: a full queue resolves as ASYNC_REJECTED instead of
+// spinning a worker. Size config.capacity for the operations in flight.
+class AsyncParkingSystem {
+private:
+    AsyncExecutor& executor;
+    IngestEngine engine;
+
+    struct IngestAwaiter {
+        AsyncParkingSystem* owner;
+        IngestCommand command;
+        IngestResult result;
+        std::coroutine_handle<> waiting;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        IngestResult await_resume() const { return result; }
+    };
+
+    static void resume(const IngestResult& result, void* context);
+    IngestAwaiter submit(const IngestCommand& command);
+
+    AsyncParkingSystem(const AsyncParkingSystem&);
+    AsyncParkingSystem& operator=(const AsyncParkingSystem&);
+
+public:
+    // Starts the engine; the system must not be mutated directly until
+    // this object is destroyed
+    AsyncParkingSystem(ParkingSystem& system, AsyncExecutor& executor,
+                       const IngestConfig& config = IngestConfig());
+    ~AsyncParkingSystem();
+
+    Task<ParkResult> park(VehiclePlate plate, Vehicle::VehicleType type, int zoneId, int areaId = 0);
+    Task<OperationResult> occupy(VehiclePlate plate, Vehicle::VehicleType type);
+    Task<ReleaseResult> release(VehiclePlate plate, Vehicle::VehicleType type);
+    Task<OperationResult> cancel(VehiclePlate plate, Vehicle::VehicleType type);
+    Task<OperationResult> rollback(int count);
+
+    IngestStats getStats() const;
+};
+
+#endif
+#endif
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+
+// Attribute lookups through SlotAttributeIndex against a slot scan.
+//
+//   AttributeBenchmark [--zones N] [--areas N] [--slots N] [--fill PERCENT]
+//                      [--queries N] [--seed S]
+//
+// Marks a few slots of every area as EV chargers (5%), accessible bays
+// (2%, some with a charger) and reserved permit bays (3%), then fills
+// the city to --fill percent with plain PARK traffic, which leaves the
+// special bays alone while plain ones are free. Each query asks for the
+// first free slot of a random area with a given attribute mask, once
+// from the index and once by scanning the area; the answers must agree.
+// Finally times PARK NEED EV / RELEASE cycles end to end.
+
+typedef std::chrono::steady_clock WallClock;
+
+struct AttributeQuery {
+    int zoneId;
+    int areaId;
+    uint8_t required;
+};
+
+static int scanArea(const ParkingSystem& system, const AttributeQuery& query) {
+    const ParkingArea& area = system.getZones()[query.zoneId - 1]->getParkingAreas()[query.areaId - 1];
+    uint8_t forbidden = ParkingSlot::RESERVED & ~query.required;
+    for (const ParkingSlot& slot : area.getSlots())
+        if (slot.isAvailable() && slot.hasAttributes(query.required) && !(slot.getAttributes() & forbidden))
+            return slot.getSlotId();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    CityLayout layout(200, 10, 1000);
+    int fill = 90;
+    int queryCount = 100000;
+    uint32_t seed = 3;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--zones") == 0)        layout.zoneCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--areas") == 0)   layout.areasPerZone = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--slots") == 0)   layout.slotsPerArea = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--fill") == 0)    fill = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--queries") == 0) queryCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)    seed = static_cast<uint32_t>(atoi(argv[i + 1]));
+        else {
+            std::printf("Usage: AttributeBenchmark [--zones N] [--areas N] [--slots N] [--fill PERCENT]\n"
+                        "                          [--queries N] [--seed S]\n");
+            return 1;
+        }
+    }
+    if (layout.zoneCount <= 0 || layout.areasPerZone <= 0 || layout.slotsPerArea <= 0 ||
+        fill < 0 || fill > 99 || queryCount <= 0) {
+        std::printf("❌ Need a non-empty city, --fill 0-99 and positive --queries\n");
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    VirtualClock clock;
+    ParkingSystem* system = new ParkingSystem(layout, &clock);
+    int slots = layout.getTotalSlots();
+
+    // Special bays, scattered over every area
+    int special = 0;
+    for (int z = 1; z <= layout.zoneCount; z++) {
+        for (int a = 1; a <= layout.areasPerZone; a++) {
+            for (int s = 1; s <= layout.slotsPerArea; s++) {
+                uint32_t roll = random() % 100;
+                uint8_t attributes = roll < 5 ? ParkingSlot::EV_CHARGER
+                                   : roll < 6 ? ParkingSlot::ACCESSIBLE
+                                   : roll < 7 ? ParkingSlot::ACCESSIBLE | ParkingSlot::EV_CHARGER
+                                   : roll < 10 ? ParkingSlot::RESERVED : 0;
+                if (attributes != 0)
+                    special += system->setSlotAttributes(z, a, s, s, attributes);
+            }
+        }
+    }
+
+    // Plain traffic; it takes special bays only once a zone has no plain one left
+    {
+        ConsoleMute mute;
+        int target = static_cast<int>(static_cast<long long>(slots) * fill / 100);
+        for (int vehicle = 0; slots - system->getFreeSlots() < target; vehicle++) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "P%08d", vehicle);
+            int fee = 0;
+            bool crossZone = false;
+            if (!system->createParkingRequest(VehiclePlate(text), Vehicle::CAR,
+                                              1 + static_cast<int>(random() % layout.zoneCount), fee, crossZone))
+                break;
+        }
+    }
+    std::printf("🔌 %dx%dx%d city (%d slots, %d special), %d free\n", layout.zoneCount,
+                layout.areasPerZone, layout.slotsPerArea, slots, special, system->getFreeSlots());
+
+    const uint8_t MASKS[] = { 0, ParkingSlot::EV_CHARGER, ParkingSlot::ACCESSIBLE,
+                              ParkingSlot::ACCESSIBLE | ParkingSlot::EV_CHARGER, ParkingSlot::RESERVED };
+    const char* maskNames[] = { "any", "EV", "ACCESSIBLE", "EV+ACCESSIBLE", "RESERVED" };
+    const int MASK_COUNT = sizeof(MASKS) / sizeof(MASKS[0]);
+
+    std::vector<AttributeQuery> queries(queryCount);
+    const SlotAttributeIndex& index = system->getAttributeIndex();
+    int mismatches = 0;
+
+    std::printf("   %-16s %12s %12s %8s\n", "required", "index ns", "scan ns", "found");
+    for (int m = 0; m < MASK_COUNT; m++) {
+        for (AttributeQuery& query : queries) {
+            query.zoneId = 1 + static_cast<int>(random() % layout.zoneCount);
+            query.areaId = 1 + static_cast<int>(random() % layout.areasPerZone);
+            query.required = MASKS[m];
+        }
+
+        long long checksum = 0;
+        WallClock::time_point start = WallClock::now();
+        for (const AttributeQuery& query : queries)
+            checksum += index.findFree(query.zoneId, query.areaId, query.required,
+                                       ParkingSlot::RESERVED & ~query.required);
+        double indexNanos = std::chrono::duration<double, std::nano>(WallClock::now() - start).count();
+
+        start = WallClock::now();
+        for (const AttributeQuery& query : queries)
+            checksum -= scanArea(*system, query);
+        double scanNanos = std::chrono::duration<double, std::nano>(WallClock::now() - start).count();
+
+        int found = 0;
+        for (const AttributeQuery& query : queries) {
+            int slotId = index.findFree(query.zoneId, query.areaId, query.required,
+                                        ParkingSlot::RESERVED & ~query.required);
+            if (slotId != scanArea(*system, query))
+                mismatches++;
+            found += slotId != 0;
+        }
+        if (checksum != 0)
+            mismatches++;
+
+        std::printf("   %-16s %12.0f %12.0f %7.1f%%\n", maskNames[m], indexNanos / queryCount,
+                    scanNanos / queryCount, 100.0 * found / queryCount);
+    }
+
+    // End to end: an EV driver parks and leaves again
+    int cycles = std::min(queryCount, 20000), parked = 0;
+    WallClock::time_point start = WallClock::now();
+    {
+        ConsoleMute mute;
+        for (int i = 0; i < cycles; i++) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "E%08d", i);
+            VehiclePlate plate(text);
+            int fee = 0;
+            bool crossZone = false;
+            if (system->createParkingRequestWithAttributes(plate, Vehicle::CAR,
+                                                           1 + static_cast<int>(random() % layout.zoneCount), 0,
+                                                           ParkingSlot::EV_CHARGER, 0, fee, crossZone)) {
+                parked++;
+                system->occupyParking(plate, Vehicle::CAR);
+                system->releaseParking(plate, Vehicle::CAR);
+            }
+        }
+    }
+    double cycleNanos = std::chrono::duration<double, std::nano>(WallClock::now() - start).count();
+    std::printf("   PARK NEED EV + OCCUPY + RELEASE: %.0f ns per cycle, %d of %d parked\n",
+                cycleNanos / cycles, parked, cycles);
+
+    bool clean = system->audit(false).isClean();
+    delete system;
+    if (mismatches != 0 || !clean) {
+        std::printf("❌ %d queries differ from the scan%s\n", mismatches, clean ? "" : ", audit not clean");
+        return 1;
+    }
+    std::printf("✅ Every query matches the scan\n");
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+
+// Full-city audit timing and fault-injection check.
+//
+//   AuditBenchmark [--zones N] [--areas N] [--slots N] [--fill PERCENT]
+//                  [--faults N] [--threads N] [--seed S]
+//
+// Fills the city to --fill percent through ordinary PARK / OCCUPY /
+// RELEASE / CANCEL traffic and requires a clean audit. It then times
+// full audits on 1, 2, 4 ... --threads workers (default: every core),
+// and a sweep in the short steps ServerMain --audit takes. Next it drifts
+// --faults slots each way behind the listener's back: free slots
+// silently taken (ORPHANED_SLOT) and held slots silently freed
+// (FREE_SLOT_IN_USE), which also leaves the counters wrong. The audit
+// must find exactly those slots, repair them, and leave the city clean
+// with the free count it had before.
+
+typedef std::chrono::steady_clock WallClock;
+
+static void printReport(const char* label, const AuditReport& report) {
+    std::printf("   %-22s %8.1f ms  %2d threads  %lld slots  %lld live requests\n",
+                label, report.millis, report.threads, report.slots, report.requests);
+    for (int k = 0; k < AuditIssue::KIND_COUNT; k++)
+        if (report.found[k] > 0)
+            std::printf("      %-18s %6d\n", AuditIssue::kindName(static_cast<AuditIssue::Kind>(k)), report.found[k]);
+    if (report.repaired > 0)
+        std::printf("      repaired           %6d\n", report.repaired);
+}
+
+// A sweep in ServerMain --audit steps: claims 262144 requests or checks
+// 64 zones per step. Reports the longest step, i.e. the longest hold of
+// the command lock.
+static void printSweep(const ParkingSystem& system, int threads) {
+    AuditReport report;
+    CityAudit audit(system, threads);
+    double longest = 0, total = 0;
+    int steps = 0;
+    bool done = false;
+    for (int from = 1; from <= audit.getZoneCount(); steps++) {
+        WallClock::time_point start = WallClock::now();
+        if (!done) {
+            done = audit.claimSlots(report, 262144);
+        } else {
+            audit.checkSlots(report, from, from + 63);
+            audit.checkCounters(report, from, from + 63);
+            from += 64;
+        }
+        double millis = std::chrono::duration<double, std::milli>(WallClock::now() - start).count();
+        longest = std::max(longest, millis);
+        total += millis;
+    }
+    std::printf("   %-22s %8.1f ms  %2d threads  %d steps, longest %.1f ms%s\n", "stepped sweep",
+                total, audit.getThreads(), steps, longest, report.isClean() ? "" : "  (not clean)");
+}
+
+// Changes a slot without telling its listener, as a buggy path would
+static void drift(ParkingSystem& system, ParkingSlot* slot, bool take) {
+    slot->setListener(nullptr);
+    if (take) slot->markOccupied();
+    else slot->markFree();
+    slot->setListener(&system);
+}
+
+int main(int argc, char** argv) {
+    CityLayout layout(2000, 10, 100);
+    int fill = 50;
+    int faults = 200;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    uint32_t seed = 5;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--zones") == 0)        layout.zoneCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--areas") == 0)   layout.areasPerZone = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--slots") == 0)   layout.slotsPerArea = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--fill") == 0)    fill = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--faults") == 0)  faults = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--threads") == 0) maxThreads = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)    seed = static_cast<uint32_t>(atoi(argv[i + 1]));
+        else {
+            std::printf("Usage: AuditBenchmark [--zones N] [--areas N] [--slots N] [--fill PERCENT]\n"
+                        "                      [--faults N] [--threads N] [--seed S]\n");
+            return 1;
+        }
+    }
+    if (maxThreads < 1) maxThreads = 1;
+    if (layout.zoneCount <= 0 || layout.areasPerZone <= 0 || layout.slotsPerArea <= 0 ||
+        fill < 1 || fill > 90 || faults < 0) {
+        std::printf("❌ Need a non-empty city, --fill 1-90 and --faults >= 0\n");
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    VirtualClock clock;
+    ParkingSystem* system = new ParkingSystem(layout, &clock);
+    int slots = layout.getTotalSlots();
+
+    // Traffic: every vehicle parks; most occupy, some leave again
+    {
+        ConsoleMute mute;
+        int target = static_cast<int>(static_cast<long long>(slots) * fill / 100);
+        for (int vehicle = 0; slots - system->getFreeSlots() < target; vehicle++) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "A%08d", vehicle);
+            VehiclePlate plate(text);
+            int fee = 0;
+            bool crossZone = false;
+            clock.advanceSeconds(3);
+            if (!system->createParkingRequest(plate, Vehicle::CAR, 1 + vehicle % layout.zoneCount, fee, crossZone))
+                break;
+            uint32_t roll = random() % 10;
+            if (roll == 0) {
+                system->cancelRequest(plate, Vehicle::CAR);
+            } else if (roll < 8) {
+                system->occupyParking(plate, Vehicle::CAR);
+                if (roll < 3)
+                    system->releaseParking(plate, Vehicle::CAR);
+            }
+        }
+    }
+    std::printf("🧾 %dx%dx%d city (%d slots), %d free, %zu requests\n", layout.zoneCount,
+                layout.areasPerZone, layout.slotsPerArea, slots, system->getFreeSlots(),
+                system->getRequests().size());
+
+    bool ok = true;
+    AuditReport report = system->audit(false, 1);
+    printReport("after traffic", report);
+    ok = ok && report.isClean();
+
+    for (int threads = 2; threads <= maxThreads; threads *= 2)
+        printReport("", system->audit(false, threads));
+    printSweep(*system, maxThreads);
+
+    // Drift: take free slots and free held ones, all behind the listener
+    int freeBefore = system->getFreeSlots();
+    int taken = 0, freed = 0;
+    std::vector<bool> touched(slots + 1, false);
+    for (int tries = 0; (taken < faults || freed < faults) && tries < slots * 4; tries++) {
+        int slotId = 1 + static_cast<int>(random() % slots);
+        ParkingSlot* slot = system->findSlot(slotId);
+        if (touched[slotId])
+            continue;
+        touched[slotId] = true;
+        if (slot->isAvailable() && taken < faults) {
+            drift(*system, slot, true);
+            taken++;
+        } else if (slot->isOccupied() && freed < faults) {
+            drift(*system, slot, false);
+            freed++;
+        }
+    }
+
+    report = system->audit(false, maxThreads);
+    printReport("after drift", report);
+    ok = ok && report.found[AuditIssue::ORPHANED_SLOT] == taken &&
+         report.found[AuditIssue::FREE_SLOT_IN_USE] == freed;
+
+    report = system->audit(true, maxThreads);
+    printReport("repair", report);
+
+    report = system->audit(false, maxThreads);
+    printReport("after repair", report);
+    ok = ok && report.isClean() && system->getFreeSlots() == freeBefore;
+
+    delete system;
+    if (!ok) {
+        std::printf("❌ Audit did not find or repair the injected drift exactly\n");
+        return 1;
+    }
+    std::printf("✅ Found and repaired %d taken + %d freed slots; city clean\n", taken, freed);
+    return 0;
+}
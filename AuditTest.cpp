@@ -0,0 +1,95 @@
+#include <cstdio>
+#include "ConsoleMute.h"
+#include "ParkingSystem.h"
+
+// Audit fault injection on a two-zone city.
+//
+//   AuditTest
+//
+// Slots are changed behind their listener, as a buggy path would: a free
+// slot taken with no request holding it, and a held slot marked free.
+// The audit must report exactly those slots, stay blind to zones outside
+// its range, repair both, and leave the city clean with the free count
+// it had and the affected vehicle still able to leave. Exits non-zero
+// if any expectation fails.
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("❌ %s\n", what);
+        failures++;
+    }
+}
+
+static void drift(ParkingSystem& system, ParkingSlot* slot, bool take) {
+    slot->setListener(nullptr);
+    if (take) slot->markOccupied();
+    else slot->markFree();
+    slot->setListener(&system);
+}
+
+static bool reports(const AuditReport& report, AuditIssue::Kind kind, int slotId) {
+    for (const AuditIssue& issue : report.issues)
+        if (issue.kind == kind && issue.slotId == slotId)
+            return true;
+    return false;
+}
+
+int main() {
+    ConsoleMute mute;
+    VirtualClock clock;
+    ParkingSystem system(CityLayout(2, 2, 4), &clock);
+
+    int fee = 0;
+    bool crossZone = false;
+    check(system.createParkingRequest(VehiclePlate("AUD1"), Vehicle::CAR, 2, fee, crossZone), "park AUD1");
+    check(system.occupyParking(VehiclePlate("AUD1"), Vehicle::CAR), "occupy AUD1");
+    check(system.createParkingRequest(VehiclePlate("AUD2"), Vehicle::CAR, 2, fee, crossZone), "park AUD2");
+    check(system.createParkingRequest(VehiclePlate("AUD3"), Vehicle::CAR, 1, fee, crossZone), "park AUD3");
+    check(system.audit(false, 1).isClean(), "audit clean before drift");
+    int freeBefore = system.getFreeSlots();
+
+    // -------- Inject --------
+    int heldId = system.lookupRequest(VehiclePlate("AUD1"), Vehicle::CAR)->getAllocatedSlotId();
+    int orphanId = CityLayout(2, 2, 4).getTotalSlots();          // last slot of zone 2, free
+    check(system.findSlot(orphanId)->isAvailable(), "last slot starts free");
+    drift(system, system.findSlot(heldId), false);
+    drift(system, system.findSlot(orphanId), true);
+
+    // -------- Detect --------
+    AuditReport report = system.audit(false, 1, 1, 1);
+    check(report.found[AuditIssue::ORPHANED_SLOT] == 0 && report.found[AuditIssue::FREE_SLOT_IN_USE] == 0,
+          "zone 1 audit does not see zone 2 drift");
+
+    report = system.audit(false, 2);
+    check(report.found[AuditIssue::ORPHANED_SLOT] == 1, "one orphaned slot found");
+    check(report.found[AuditIssue::FREE_SLOT_IN_USE] == 1, "one held slot marked free found");
+    check(reports(report, AuditIssue::ORPHANED_SLOT, orphanId), "orphan reported at the drifted slot");
+    check(reports(report, AuditIssue::FREE_SLOT_IN_USE, heldId), "free-in-use reported at AUD1's slot");
+    check(report.found[AuditIssue::DOUBLE_BOOKED] == 0 && report.found[AuditIssue::BAD_ALLOCATION] == 0,
+          "no double booking or bad allocation invented");
+    check(report.repaired == 0, "audit without repair changes nothing");
+    check(system.findSlot(heldId)->isAvailable() && !system.findSlot(orphanId)->isAvailable(),
+          "audit without repair leaves the drift in place");
+
+    // -------- Repair --------
+    report = system.audit(true, 2);
+    check(report.repaired >= 2, "repair fixes both slots");
+    check(!system.findSlot(heldId)->isAvailable(), "AUD1's slot is taken back");
+    check(system.findSlot(orphanId)->isAvailable(), "orphaned slot is freed");
+
+    report = system.audit(false, 2);
+    check(report.isClean(), "audit clean after repair");
+    check(system.getFreeSlots() == freeBefore, "free count back to before the drift");
+    check(system.releaseParking(VehiclePlate("AUD1"), Vehicle::CAR), "AUD1 leaves after the repair");
+    check(system.findSlot(heldId)->isAvailable(), "AUD1's slot is free after it leaves");
+    check(system.audit(false, 1).isClean(), "audit clean after AUD1 leaves");
+
+    if (failures != 0) {
+        std::printf("❌ %d audit check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("✅ Audit finds and repairs injected drift\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "BatchIngest.h"
+#include "CommandParser.h"
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const char* OP_NAMES[BatchSummary::OP_COUNT] = { "PARK", "OCCUPY", "RELEASE", "CANCEL", "ROLLBACK" };
+
+// -------- Summary --------
+BatchSummary::BatchSummary()
+    : lines(0), skipped(0), malformed(0), unsupported(0), firstBadLine(0), bytes(0), seconds(0) {
+    for (int op = 0; op < OP_COUNT; op++) {
+        succeeded[op] = 0;
+        failed[op] = 0;
+    }
+}
+
+uint64_t BatchSummary::getOperations() const {
+    uint64_t total = 0;
+    for (int op = 0; op < OP_COUNT; op++)
+        total += succeeded[op] + failed[op];
+    return total;
+}
+
+void BatchSummary::print(std::ostream& out) const {
+    uint64_t operations = getOperations();
+
+    out << "\n========== BATCH SUMMARY ==========\n";
+    out << "Lines:       " << lines << " (" << skipped << " blank/comment)\n";
+    for (int op = 0; op < OP_COUNT; op++) {
+        if (succeeded[op] + failed[op] == 0)
+            continue;
+        out << std::left << std::setw(13) << OP_NAMES[op] << std::right
+            << succeeded[op] << " ok, " << failed[op] << " failed\n";
+    }
+    if (malformed || unsupported) {
+        out << "⚠ Rejected:  " << malformed << " malformed, " << unsupported << " unsupported"
+            << " (first at line " << firstBadLine << ")\n";
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "Elapsed:     " << seconds << " s\n";
+    if (seconds > 0) {
+        out << std::setprecision(0);
+        out << "Throughput:  " << operations / seconds << " ops/s, "
+            << std::setprecision(1) << bytes / seconds / (1024.0 * 1024.0) << " MiB/s\n";
+    }
+    out << std::defaultfloat << std::setprecision(6);
+    out << "===================================\n";
+}
+
+// -------- One Line --------
+static void runLine(ParkingSystem& system, const char* line, size_t length,
+                    Command& cmd, BatchSummary& summary) {
+    summary.lines++;
+
+    size_t first = 0;
+    while (first < length && (line[first] == ' ' || line[first] == '\t' || line[first] == '\r'))
+        first++;
+    if (first == length || line[first] == '#') {
+        summary.skipped++;
+        return;
+    }
+
+    if (!CommandParser::parse(line, length, cmd)) {
+        summary.malformed++;
+        if (!summary.firstBadLine) summary.firstBadLine = summary.lines;
+        return;
+    }
+
+    int fee = 0;
+    bool crossZone = false;
+    bool ok;
+    BatchSummary::Op op;
+
+    switch (cmd.type) {
+        case Command::PARK:
+            op = BatchSummary::PARK;
+            if (cmd.requiredAttributes != 0 || cmd.preferredAttributes != 0)
+                ok = system.createParkingRequestWithAttributes(cmd.plate, cmd.vehicleType, cmd.zoneId, cmd.areaId,
+                                                               cmd.requiredAttributes, cmd.preferredAttributes,
+                                                               fee, crossZone);
+            else if (cmd.areaId == 0)
+                ok = system.createParkingRequest(cmd.plate, cmd.vehicleType, cmd.zoneId, fee, crossZone);
+            else
+                ok = system.createParkingRequestWithArea(cmd.plate, cmd.vehicleType, cmd.zoneId,
+                                                         cmd.areaId, fee, crossZone);
+            break;
+        case Command::OCCUPY:
+            op = BatchSummary::OCCUPY;
+            ok = system.occupyParking(cmd.plate, cmd.vehicleType);
+            break;
+        case Command::RELEASE:
+            op = BatchSummary::RELEASE;
+            ok = system.releaseParking(cmd.plate, cmd.vehicleType);
+            break;
+        case Command::CANCEL:
+            op = BatchSummary::CANCEL;
+            ok = system.cancelRequest(cmd.plate, cmd.vehicleType);
+            break;
+        case Command::ROLLBACK:
+            op = BatchSummary::ROLLBACK;
+            ok = system.rollbackLast(cmd.count);
+            break;
+        default:
+            summary.unsupported++;
+            if (!summary.firstBadLine) summary.firstBadLine = summary.lines;
+            return;
+    }
+
+    if (ok)
+        summary.succeeded[op]++;
+    else
+        summary.failed[op]++;
+}
+
+// -------- Stream --------
+bool BatchIngest::run(ParkingSystem& system, std::FILE* input, BatchSummary& summary) {
+    std::vector<char> block(BLOCK_SIZE);
+    size_t carried = 0;          // partial line kept from the previous block
+    Command cmd;
+    bool readError = false;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ConsoleMute mute;
+        for (;;) {
+            if (carried == block.size())
+                block.resize(block.size() * 2);   // one line longer than a block
+
+            size_t got = std::fread(block.data() + carried, 1, block.size() - carried, input);
+            summary.bytes += got;
+            size_t filled = carried + got;
+            if (got == 0) {
+                readError = std::ferror(input) != 0;
+                if (filled > 0)
+                    runLine(system, block.data(), filled, cmd, summary);   // no trailing newline
+                break;
+            }
+
+            const char* cursor = block.data();
+            const char* end = block.data() + filled;
+            for (;;) {
+                const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+                if (!newline)
+                    break;
+                runLine(system, cursor, static_cast<size_t>(newline - cursor), cmd, summary);
+                cursor = newline + 1;
+            }
+
+            carried = static_cast<size_t>(end - cursor);
+            std::memmove(block.data(), cursor, carried);
+        }
+    }
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return !readError;
+}
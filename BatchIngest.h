@@ -0,0 +1,46 @@
+#ifndef BATCH_INGEST_H
+#define BATCH_INGEST_H
+
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+
+class ParkingSystem;
+
+// Totals for one bulk run
+struct BatchSummary {
+    enum Op { PARK, OCCUPY, RELEASE, CANCEL, ROLLBACK, OP_COUNT };
+
+    uint64_t lines;
+    uint64_t skipped;             // blank lines and # comments
+    uint64_t malformed;
+    uint64_t unsupported;         // valid text-protocol commands that are not operations
+    uint64_t firstBadLine;        // 1-based, 0 = none
+    uint64_t succeeded[OP_COUNT];
+    uint64_t failed[OP_COUNT];
+    uint64_t bytes;
+    double seconds;
+
+    BatchSummary();
+
+    uint64_t getOperations() const;
+    void print(std::ostream& out) const;
+};
+
+// Non-interactive ingestion for the CLI: streams a command file (or stdin)
+// of text-protocol operation lines
+//   PARK <plate> <type> <zone> [area]
+//   OCCUPY | RELEASE | CANCEL <plate> <type>
+//   ROLLBACK <k>
+// straight into a ParkingSystem. Input is read in large blocks and every
+// line is parsed in place inside the block, so nothing is copied or
+// allocated per line. Per-operation console messages are muted.
+class BatchIngest {
+public:
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+    // Returns false only when the input cannot be read
+    static bool run(ParkingSystem& system, std::FILE* input, BatchSummary& summary);
+};
+
+#endif
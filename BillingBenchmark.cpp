@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "TariffEngine.h"
+#include "Clock.h"
+
+// End-of-day settlement benchmark for TariffEngine.
+//
+//   BillingBenchmark [--sessions N] [--zones Z] [--seed S]
+//
+// Generates one day of completed sessions (default 5M over 1000 zones,
+// a quarter of the zones on a premium plan) and prices them twice:
+// row by row through TariffEngine::price, and in one columnar pass
+// through TariffEngine::priceBatch. Both totals must match.
+
+typedef std::chrono::steady_clock WallClock;
+
+struct SessionRow {
+    int zoneId;
+    Vehicle::VehicleType type;
+    bool crossZone;
+    int64_t occupyNanos;
+    int64_t releaseNanos;
+};
+
+static double elapsedSeconds(WallClock::time_point start) {
+    return std::chrono::duration<double>(WallClock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long long sessionCount = 5000000;
+    int zoneCount = 1000;
+    unsigned int seed = 42;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--sessions") == 0)   sessionCount = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "--zones") == 0) zoneCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)  seed = static_cast<unsigned int>(atoi(argv[i + 1]));
+        else {
+            std::cout << "Usage: BillingBenchmark [--sessions N] [--zones Z] [--seed S]\n";
+            return 1;
+        }
+    }
+    if (sessionCount <= 0 || zoneCount <= 0) {
+        std::cout << "❌ --sessions and --zones must be positive\n";
+        return 1;
+    }
+
+    TariffEngine tariff;
+    std::vector<TariffBand> premiumCar = { { 0, 3000 }, { 7 * 60, 6000 }, { 10 * 60, 5000 },
+                                           { 17 * 60, 7000 }, { 21 * 60, 3000 } };
+    int premium = tariff.addPlan(TariffPlan("Car premium", 15000, 15000, 7500, premiumCar));
+    for (int z = 1; z <= zoneCount; z += 4)
+        tariff.setZonePlan(z, Vehicle::CAR, premium);
+
+    // -------- Generate one day of sessions --------
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> zoneDist(1, zoneCount);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::lognormal_distribution<double> dwellHours(0.5, 0.8);
+
+    const int64_t dayStart = VirtualClock::DEFAULT_START;
+    const int64_t nanosPerDay = 86400LL * Clock::NANOS_PER_SECOND;
+
+    std::vector<SessionRow> rows;
+    SessionColumns columns;
+    rows.reserve(sessionCount);
+    columns.reserve(sessionCount);
+
+    for (long long i = 0; i < sessionCount; i++) {
+        SessionRow row;
+        row.zoneId = zoneDist(rng);
+        row.type = uniform(rng) < 0.3 ? Vehicle::BIKE : Vehicle::CAR;
+        row.crossZone = uniform(rng) < 0.1;
+        row.occupyNanos = dayStart + static_cast<int64_t>(uniform(rng) * nanosPerDay);
+        row.releaseNanos = row.occupyNanos + static_cast<int64_t>(dwellHours(rng) * 3600.0 * Clock::NANOS_PER_SECOND);
+        rows.push_back(row);
+        columns.add(row.zoneId, row.type, row.crossZone,
+                    row.occupyNanos / Clock::NANOS_PER_SECOND, row.releaseNanos / Clock::NANOS_PER_SECOND);
+    }
+
+    // -------- Row by row --------
+    auto start = WallClock::now();
+    int64_t rowTotal = 0;
+    for (const auto& row : rows)
+        rowTotal += tariff.price(row.zoneId, row.type, row.crossZone, row.occupyNanos, row.releaseNanos);
+    double rowSeconds = elapsedSeconds(start);
+
+    // -------- Columnar batch --------
+    start = WallClock::now();
+    int64_t batchTotal = tariff.priceBatch(columns);
+    double batchSeconds = elapsedSeconds(start);
+
+    std::cout << "Sessions:  " << sessionCount << " over " << zoneCount << " zones\n";
+    std::cout << "Row-wise:  " << rowSeconds << " s  ("
+              << rowSeconds * 1e9 / sessionCount << " ns/session)\n";
+    std::cout << "Batch:     " << batchSeconds << " s  ("
+              << batchSeconds * 1e9 / sessionCount << " ns/session)\n";
+    std::cout << "Revenue:   Rs " << std::fixed << std::setprecision(2) << batchTotal / 100.0 << "\n";
+
+    if (rowTotal != batchTotal) {
+        std::cout << "❌ Totals differ: row-wise " << rowTotal << " vs batch " << batchTotal << " paisa\n";
+        return 1;
+    }
+    return 0;
+}
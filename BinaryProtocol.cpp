@@ -0,0 +1,245 @@
+#include "BinaryProtocol.h"
+#include "ParkingSystem.h"
+#include <cstring>
+
+// -------- Reading --------
+BinaryFrameReader::BinaryFrameReader(std::streambuf* in, size_t initialCapacity)
+    : source(in), capacity(initialCapacity), begin(0), end(0), broken(false) {
+    if (capacity < 2 * sizeof(BinaryHeader))
+        capacity = 2 * sizeof(BinaryHeader);
+    buffer = new char[capacity];
+}
+
+BinaryFrameReader::~BinaryFrameReader() {
+    delete[] buffer;
+}
+
+// Makes at least `needed` unread bytes available. Takes whatever else the
+// stream already holds (up to the free space) so a burst of frames costs
+// one read.
+bool BinaryFrameReader::fill(size_t needed) {
+    if (end - begin >= needed)
+        return true;
+
+    if (capacity - begin < needed) {
+        // Compact; begin is always 4-byte aligned, so frames stay aligned
+        std::memmove(buffer, buffer + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (capacity < needed) {
+        size_t larger = capacity;
+        while (larger < needed)
+            larger *= 2;
+        char* grown = new char[larger];
+        std::memcpy(grown, buffer, end);
+        delete[] buffer;
+        buffer = grown;
+        capacity = larger;
+    }
+
+    while (end - begin < needed) {
+        std::streamsize wanted = static_cast<std::streamsize>(needed - (end - begin));
+        std::streamsize available = source->in_avail();
+        std::streamsize space = static_cast<std::streamsize>(capacity - end);
+        if (available > wanted)
+            wanted = available < space ? available : space;
+
+        std::streamsize got = source->sgetn(buffer + end, wanted);
+        if (got <= 0)
+            return false;
+        end += static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool BinaryFrameReader::next(const BinaryHeader*& header, const char*& body) {
+    if (broken || !fill(sizeof(BinaryHeader)))
+        return false;
+
+    const BinaryHeader* candidate = reinterpret_cast<const BinaryHeader*>(buffer + begin);
+    uint32_t length = candidate->length;
+    if (length > MAX_FRAME || length % 4 != 0) {
+        broken = true;
+        return false;
+    }
+
+    if (!fill(sizeof(BinaryHeader) + length))
+        return false;
+
+    // fill() may have moved the buffer
+    header = reinterpret_cast<const BinaryHeader*>(buffer + begin);
+    body = buffer + begin + sizeof(BinaryHeader);
+    begin += sizeof(BinaryHeader) + length;
+    return true;
+}
+
+bool BinaryFrameReader::hasBufferedFrame() const {
+    if (end - begin < sizeof(BinaryHeader))
+        return false;
+    const BinaryHeader* pending = reinterpret_cast<const BinaryHeader*>(buffer + begin);
+    return end - begin >= sizeof(BinaryHeader) + pending->length;
+}
+
+bool BinaryFrameReader::isBroken() const {
+    return broken;
+}
+
+// -------- Writing --------
+BinaryFrameWriter::BinaryFrameWriter() : frameStart(0) {
+    buffer.reserve(64 * 1024);
+}
+
+void BinaryFrameWriter::beginFrame(const BinaryHeader& request, uint16_t status) {
+    frameStart = buffer.size();
+    buffer.resize(frameStart + sizeof(BinaryHeader));
+
+    BinaryHeader header;
+    header.length = 0;
+    header.op = request.op;
+    header.status = status;
+    header.sequence = request.sequence;
+    std::memcpy(buffer.data() + frameStart, &header, sizeof(header));
+}
+
+void* BinaryFrameWriter::appendBody(size_t bytes) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + ((bytes + 3) & ~static_cast<size_t>(3)), 0);
+    return buffer.data() + offset;
+}
+
+void BinaryFrameWriter::endFrame() {
+    uint32_t length = static_cast<uint32_t>(buffer.size() - frameStart - sizeof(BinaryHeader));
+    std::memcpy(buffer.data() + frameStart, &length, sizeof(length));
+}
+
+size_t BinaryFrameWriter::size() const {
+    return buffer.size();
+}
+
+void BinaryFrameWriter::flushTo(std::streambuf* out) {
+    if (!buffer.empty())
+        out->sputn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out->pubsync();
+    buffer.clear();
+}
+
+// -------- Dispatch --------
+static bool decodeVehicle(const BinaryHeader& header, const char* body,
+                          VehiclePlate& plate, Vehicle::VehicleType& type) {
+    if (header.length < sizeof(BinaryVehicleRequest))
+        return false;
+
+    const BinaryVehicleRequest* request = reinterpret_cast<const BinaryVehicleRequest*>(body);
+    if (request->vehicleType != 1 && request->vehicleType != 2)
+        return false;
+
+    size_t length = 0;
+    while (length < sizeof(request->plate) && request->plate[length] != '\0')
+        length++;
+
+    plate = VehiclePlate(request->plate, length);
+    type = request->vehicleType == 1 ? Vehicle::CAR : Vehicle::BIKE;
+    return plate.isValid();
+}
+
+static void writeStatus(const ParkingSystem& system, const BinaryHeader& header, BinaryFrameWriter& out) {
+    const CityLayout& layout = system.getLayout();
+    int totalSlots = layout.getTotalSlots();
+
+    out.beginFrame(header, BIN_OK);
+    BinaryStatusResponse status;
+    status.version = system.getChangeLog().getVersion();
+    status.zoneCount = layout.zoneCount;
+    status.areasPerZone = layout.areasPerZone;
+    status.slotsPerArea = layout.slotsPerArea;
+    status.freeSlots = static_cast<int32_t>(system.getFreeIndex().sumFree(1, 0));
+    std::memcpy(out.appendBody(sizeof(status)), &status, sizeof(status));
+
+    // appendBody may reallocate, so nothing above is touched after this
+    uint32_t* bitmap = static_cast<uint32_t*>(out.appendBody(((totalSlots + 31) / 32) * sizeof(uint32_t)));
+    int bit = 0;
+    for (auto zone : system.getZones())
+        for (const auto& area : zone->getParkingAreas())
+            for (const auto& slot : area.getSlots()) {
+                if (slot.isAvailable())
+                    bitmap[bit / 32] |= 1u << (bit % 32);
+                bit++;
+            }
+    out.endFrame();
+}
+
+void BinaryProtocol::handle(ParkingSystem& system, const BinaryHeader& header,
+                            const char* body, BinaryFrameWriter& out) {
+    if (header.op == BIN_STATUS) {
+        writeStatus(system, header, out);
+        return;
+    }
+    if (header.op == BIN_FREE) {
+        out.beginFrame(header, BIN_OK);
+        BinaryFreeResponse* free = static_cast<BinaryFreeResponse*>(out.appendBody(sizeof(BinaryFreeResponse)));
+        free->freeSlots = static_cast<int32_t>(system.getFreeIndex().sumFree(1, 0));
+        free->zoneCount = system.getLayout().zoneCount;
+        out.endFrame();
+        return;
+    }
+    if (header.op < BIN_PARK || header.op > BIN_CANCEL) {
+        out.beginFrame(header, BIN_UNKNOWN_OP);
+        out.endFrame();
+        return;
+    }
+
+    VehiclePlate plate;
+    Vehicle::VehicleType type;
+    if (!decodeVehicle(header, body, plate, type)) {
+        out.beginFrame(header, BIN_MALFORMED);
+        out.endFrame();
+        return;
+    }
+
+    const BinaryVehicleRequest* request = reinterpret_cast<const BinaryVehicleRequest*>(body);
+    switch (header.op) {
+        case BIN_PARK: {
+            int fee = 0;
+            bool crossZone = false;
+            bool ok;
+            if (request->areaId == 0)
+                ok = system.createParkingRequest(plate, type, request->zoneId, fee, crossZone);
+            else
+                ok = system.createParkingRequestWithArea(plate, type, request->zoneId,
+                                                         request->areaId, fee, crossZone);
+            out.beginFrame(header, ok ? BIN_OK : BIN_FAILED);
+            if (ok) {
+                const ParkingRequest* req = system.lookupRequest(plate, type);
+                BinaryParkResponse* park = static_cast<BinaryParkResponse*>(out.appendBody(sizeof(BinaryParkResponse)));
+                park->slotId = req ? req->getAllocatedSlotId() : -1;
+                park->zoneId = req ? req->getAllocatedZoneId() : -1;
+                park->areaId = req ? req->getAllocatedAreaId() : -1;
+                park->fee = fee;
+                park->crossZone = crossZone ? 1 : 0;
+            }
+            break;
+        }
+
+        case BIN_OCCUPY:
+            out.beginFrame(header, system.occupyParking(plate, type) ? BIN_OK : BIN_FAILED);
+            break;
+
+        case BIN_RELEASE: {
+            bool ok = system.releaseParking(plate, type);
+            out.beginFrame(header, ok ? BIN_OK : BIN_FAILED);
+            if (ok) {
+                const ParkingRequest* req = system.lookupRequest(plate, type);
+                BinaryReleaseResponse release;
+                release.chargePaisa = req ? req->getCharge() : 0;
+                std::memcpy(out.appendBody(sizeof(release)), &release, sizeof(release));
+            }
+            break;
+        }
+
+        default:
+            out.beginFrame(header, system.cancelRequest(plate, type) ? BIN_OK : BIN_FAILED);
+            break;
+    }
+    out.endFrame();
+}
@@ -0,0 +1,160 @@
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <vector>
+
+class ParkingSystem;
+
+// Length-prefixed binary protocol for gate controllers.
+//
+// A connection starts in the text protocol; the line "BINARY" switches
+// the rest of it to frames. Every frame is a BinaryHeader followed by
+// `length` body bytes. All integers are in host byte order (little-endian
+// on every platform we ship) and every struct below is a multiple of
+// 4 bytes, so frames and bodies stay 4-byte aligned in the buffers. Only
+// structs made of 32-bit fields are read and written in place through a
+// struct pointer; the 12-byte header leaves 8-byte fields misaligned, so
+// BinaryReleaseResponse and BinaryStatusResponse are always memcpy'd.
+//
+//   request            body                    response body (status OK)
+//   PARK               BinaryVehicleRequest    BinaryParkResponse
+//   OCCUPY / CANCEL    BinaryVehicleRequest    -
+//   RELEASE            BinaryVehicleRequest    BinaryReleaseResponse
+//   STATUS             -                       BinaryStatusResponse + free-slot bitmap
+//   FREE               -                       BinaryFreeResponse
+//
+// A response echoes the request's op and sequence; `status` carries the
+// outcome (always 0 in requests).
+
+enum BinaryOp {
+    BIN_PARK = 1,
+    BIN_OCCUPY = 2,
+    BIN_RELEASE = 3,
+    BIN_CANCEL = 4,
+    BIN_STATUS = 5,
+    BIN_FREE = 6           // free-slot total only, O(log zones); used by shard coordinators
+};
+
+enum BinaryStatus {
+    BIN_OK = 0,
+    BIN_FAILED = 1,        // the operation was refused (same cases as the text "error")
+    BIN_MALFORMED = 2,     // body too short or fields out of range
+    BIN_UNKNOWN_OP = 3
+};
+
+struct BinaryHeader {
+    uint32_t length;       // body bytes after this header (multiple of 4)
+    uint16_t op;
+    uint16_t status;
+    uint32_t sequence;     // chosen by the client, echoed back
+};
+
+struct BinaryVehicleRequest {
+    char plate[16];        // NUL-padded
+    uint8_t vehicleType;   // 1 = Car, 2 = Bike
+    uint8_t reserved[3];
+    int32_t zoneId;        // PARK only
+    int32_t areaId;        // PARK only, 0 = any
+};
+
+struct BinaryParkResponse {
+    int32_t slotId;
+    int32_t zoneId;
+    int32_t areaId;
+    int32_t fee;
+    uint8_t crossZone;
+    uint8_t reserved[3];
+};
+
+// Holds an int64_t; copy it in and out with memcpy, never in place
+struct BinaryReleaseResponse {
+    int64_t chargePaisa;
+};
+
+// Followed by ceil(totalSlots / 32) uint32 words: bit i of the bitmap
+// (word i / 32, bit i % 32) is set when the i-th slot in zone, area,
+// slot order is free. Holds a uint64_t; copy it with memcpy
+struct BinaryStatusResponse {
+    uint64_t version;      // StatusChangeLog version of this snapshot
+    int32_t zoneCount;
+    int32_t areasPerZone;
+    int32_t slotsPerArea;
+    int32_t freeSlots;
+};
+
+struct BinaryFreeResponse {
+    int32_t freeSlots;
+    int32_t zoneCount;
+};
+
+static_assert(sizeof(BinaryHeader) == 12, "BinaryHeader layout");
+static_assert(sizeof(BinaryVehicleRequest) == 28, "BinaryVehicleRequest layout");
+static_assert(sizeof(BinaryParkResponse) == 20, "BinaryParkResponse layout");
+static_assert(sizeof(BinaryReleaseResponse) == 8, "BinaryReleaseResponse layout");
+static_assert(sizeof(BinaryStatusResponse) == 24, "BinaryStatusResponse layout");
+static_assert(sizeof(BinaryFreeResponse) == 8, "BinaryFreeResponse layout");
+
+// -------- Reading --------
+// Pulls large chunks from a stream buffer and hands out frames that point
+// straight into it. A frame stays valid until the next call to next().
+class BinaryFrameReader {
+public:
+    static const uint32_t MAX_FRAME = 1 << 20;
+
+private:
+    std::streambuf* source;
+    char* buffer;
+    size_t capacity;
+    size_t begin;          // first unread byte
+    size_t end;            // one past the last buffered byte
+    bool broken;           // oversized or misaligned frame; connection is unusable
+
+    bool fill(size_t needed);
+
+    BinaryFrameReader(const BinaryFrameReader&);
+    BinaryFrameReader& operator=(const BinaryFrameReader&);
+
+public:
+    explicit BinaryFrameReader(std::streambuf* source, size_t capacity = 64 * 1024);
+    ~BinaryFrameReader();
+
+    // False at end of input or on a framing error (see isBroken)
+    bool next(const BinaryHeader*& header, const char*& body);
+
+    // True when another complete frame can be returned without blocking
+    bool hasBufferedFrame() const;
+    bool isBroken() const;
+};
+
+// -------- Writing --------
+// Accumulates response frames in a reusable buffer so a burst of requests
+// is answered with one write.
+class BinaryFrameWriter {
+private:
+    std::vector<char> buffer;
+    size_t frameStart;
+
+public:
+    BinaryFrameWriter();
+
+    // Starts a response to `request`; append the body, then endFrame()
+    void beginFrame(const BinaryHeader& request, uint16_t status);
+    void* appendBody(size_t bytes);   // zeroed, 4-byte aligned (not 8)
+    void endFrame();
+
+    size_t size() const;
+    void flushTo(std::streambuf* out);
+};
+
+// -------- Dispatch --------
+class BinaryProtocol {
+public:
+    // Executes one request frame against the system and appends its response
+    static void handle(ParkingSystem& system, const BinaryHeader& header,
+                       const char* body, BinaryFrameWriter& out);
+};
+
+#endif
@@ -0,0 +1,302 @@
+#include "CityAudit.h"
+#include "ParkingSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// -------- Issue / Report --------
+const char* AuditIssue::kindName(Kind kind) {
+    switch (kind) {
+        case ORPHANED_SLOT:    return "ORPHANED_SLOT";
+        case FREE_SLOT_IN_USE: return "FREE_SLOT_IN_USE";
+        case DOUBLE_BOOKED:    return "DOUBLE_BOOKED";
+        case BAD_ALLOCATION:   return "BAD_ALLOCATION";
+        case FREE_COUNT:       return "FREE_COUNT";
+        case OCCUPIED_COUNT:   return "OCCUPIED_COUNT";
+        case CAPACITY_COUNT:   return "CAPACITY_COUNT";
+        default:               return "UNKNOWN";
+    }
+}
+
+AuditReport::AuditReport() : threads(0), zones(0), slots(0), requests(0), repaired(0), millis(0) {
+    for (int k = 0; k < AuditIssue::KIND_COUNT; k++)
+        found[k] = 0;
+}
+
+int AuditReport::totalFound() const {
+    int total = 0;
+    for (int k = 0; k < AuditIssue::KIND_COUNT; k++)
+        total += found[k];
+    return total;
+}
+
+bool AuditReport::isClean() const {
+    return totalFound() == 0;
+}
+
+static AuditIssue makeIssue(AuditIssue::Kind kind, int zoneId, int areaId, int slotId,
+                            uint32_t request = AuditIssue::NONE) {
+    AuditIssue issue;
+    issue.kind = kind;
+    issue.zoneId = zoneId;
+    issue.areaId = areaId;
+    issue.slotId = slotId;
+    issue.request = request;
+    issue.otherRequest = AuditIssue::NONE;
+    issue.expected = issue.actual = 0;
+    issue.repaired = false;
+    return issue;
+}
+
+static void addCounterIssue(std::vector<AuditIssue>& out, AuditIssue::Kind kind,
+                            int zoneId, int areaId, int expected, int actual) {
+    if (expected == actual)
+        return;
+    AuditIssue issue = makeIssue(kind, zoneId, areaId, 0);
+    issue.expected = expected;
+    issue.actual = actual;
+    out.push_back(issue);
+}
+
+static bool issueBefore(const AuditIssue& a, const AuditIssue& b) {
+    if (a.kind != b.kind) return a.kind < b.kind;
+    if (a.zoneId != b.zoneId) return a.zoneId < b.zoneId;
+    if (a.areaId != b.areaId) return a.areaId < b.areaId;
+    return a.slotId < b.slotId;
+}
+
+// Appends every worker's findings to the report in a stable order
+static void merge(std::vector<std::vector<AuditIssue>>& perWorker, AuditReport& report) {
+    size_t first = report.issues.size();
+    for (auto& issues : perWorker) {
+        for (const AuditIssue& issue : issues)
+            report.found[issue.kind]++;
+        report.issues.insert(report.issues.end(), issues.begin(), issues.end());
+    }
+    std::sort(report.issues.begin() + first, report.issues.end(), issueBefore);
+}
+
+// -------- Constructor --------
+CityAudit::CityAudit(const ParkingSystem& s, int t)
+    : system(s), threads(t), zoneCount(s.getLayout().zoneCount),
+      sinceVersion(s.getChangeLog().getVersion()), requestEnd(s.getRequests().size()), nextRequest(0),
+      holders(static_cast<size_t>(s.getLayout().getTotalSlots()) + 1),
+      inFlux(holders.size(), 0) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+}
+
+int CityAudit::getThreads() const {
+    return threads;
+}
+
+int CityAudit::getZoneCount() const {
+    return zoneCount;
+}
+
+// -------- Helpers --------
+// Whether the request is live on the slot right now; claims recorded by
+// an earlier step may have gone stale since
+bool CityAudit::isHolder(uint32_t handle, int slotId) const {
+    const std::deque<ParkingRequest>& requests = system.getRequests();
+    if (handle >= requests.size())
+        return false;
+    const ParkingRequest& request = requests[handle];
+    ParkingRequest::RequestState state = request.getState();
+    return (state == ParkingRequest::ALLOCATED || state == ParkingRequest::OCCUPIED) &&
+           request.getAllocatedSlotId() == slotId;
+}
+
+void CityAudit::clampRange(int& fromZone, int& toZone) const {
+    if (fromZone < 1) fromZone = 1;
+    if (toZone <= 0 || toZone > zoneCount) toZone = zoneCount;
+}
+
+// Runs task(zone, worker) for every zone in range, zones handed out one
+// at a time so a crowded zone does not hold up the others
+template<typename Task>
+void CityAudit::forEachZone(int fromZone, int toZone, Task task) const {
+    const std::vector<Zone*>& zones = system.getZones();
+    int workerCount = std::max(1, std::min(threads, toZone - fromZone + 1));
+    std::atomic<int> next(fromZone);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < workerCount; t++) {
+        workers.emplace_back([&, t]() {
+            for (int z = next++; z <= toZone; z = next++)
+                task(*zones[z - 1], t);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+// -------- Claims --------
+bool CityAudit::claimSlots(AuditReport& report, size_t maxRequests) {
+    const std::deque<ParkingRequest>& requests = system.getRequests();
+    size_t end = requestEnd - nextRequest > maxRequests ? nextRequest + maxRequests : requestEnd;
+    report.threads = threads;
+
+    std::vector<std::vector<AuditIssue>> found(threads);
+    std::vector<long long> live(threads, 0);
+
+    // Requests go in chunks, they do not come by zone. A second live
+    // claim on a slot is a double booking; a stale one is replaced.
+    const size_t CHUNK = 16384;
+    std::atomic<size_t> next(nextRequest);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t start = next.fetch_add(CHUNK); start < end; start = next.fetch_add(CHUNK)) {
+                for (size_t h = start; h < std::min(start + CHUNK, end); h++) {
+                    const ParkingRequest& request = requests[h];
+                    ParkingRequest::RequestState state = request.getState();
+                    if (state != ParkingRequest::ALLOCATED && state != ParkingRequest::OCCUPIED)
+                        continue;
+                    live[t]++;
+
+                    uint32_t handle = static_cast<uint32_t>(h);
+                    int slotId = request.getAllocatedSlotId();
+                    const ParkingSlot* slot = slotId < static_cast<int>(holders.size()) ? system.findSlot(slotId) : nullptr;
+                    if (slot == nullptr || slot->getZoneId() != request.getAllocatedZoneId() ||
+                        slot->getAreaId() != request.getAllocatedAreaId()) {
+                        found[t].push_back(makeIssue(AuditIssue::BAD_ALLOCATION, request.getAllocatedZoneId(),
+                                                     request.getAllocatedAreaId(), slotId, handle));
+                        continue;
+                    }
+
+                    uint32_t holder = 0;
+                    while (!holders[slotId].compare_exchange_weak(holder, handle + 1)) {
+                        if (isHolder(holder - 1, slotId)) {
+                            AuditIssue issue = makeIssue(AuditIssue::DOUBLE_BOOKED, slot->getZoneId(),
+                                                         slot->getAreaId(), slotId, std::min(handle, holder - 1));
+                            issue.otherRequest = std::max(handle, holder - 1);
+                            found[t].push_back(issue);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    for (int t = 0; t < threads; t++) {
+        report.requests += live[t];
+        pending.insert(pending.end(), found[t].begin(), found[t].end());
+    }
+    nextRequest = end;
+    return nextRequest == requestEnd;
+}
+
+// -------- Slots --------
+bool CityAudit::checkSlots(AuditReport& report, int fromZone, int toZone) {
+    clampRange(fromZone, toZone);
+    report.threads = threads;
+
+    std::vector<const ParkingSlot*> changed;
+    if (!system.getChangeLog().changedSince(sinceVersion, changed))
+        return false;
+    for (const ParkingSlot* slot : changed)
+        if (slot->getSlotId() < static_cast<int>(inFlux.size()))
+            inFlux[slot->getSlotId()] = 1;
+
+    std::vector<std::vector<AuditIssue>> found(threads);
+    std::vector<long long> slots(threads, 0);
+
+    // Findings of the claims, if still true now
+    for (const AuditIssue& issue : pending) {
+        bool inRange = issue.zoneId >= fromZone && issue.zoneId <= toZone;
+        if (issue.kind == AuditIssue::BAD_ALLOCATION) {
+            const ParkingRequest& request = system.getRequests()[issue.request];
+            ParkingRequest::RequestState state = request.getState();
+            if ((inRange || (fromZone == 1 && (issue.zoneId < 1 || issue.zoneId > zoneCount))) &&
+                (state == ParkingRequest::ALLOCATED || state == ParkingRequest::OCCUPIED))
+                found[0].push_back(issue);
+        } else if (inRange && !inFlux[issue.slotId] && isHolder(issue.request, issue.slotId) &&
+                   isHolder(issue.otherRequest, issue.slotId)) {
+            found[0].push_back(issue);
+        }
+    }
+
+    // Every settled slot must be taken exactly when a live request holds it
+    forEachZone(fromZone, toZone, [&](const Zone& zone, int t) {
+        for (const auto& area : zone.getParkingAreas()) {
+            for (const auto& slot : area.getSlots()) {
+                int slotId = slot.getSlotId();
+                if (inFlux[slotId])
+                    continue;
+                slots[t]++;
+
+                uint32_t holder = holders[slotId].load(std::memory_order_relaxed);
+                bool held = holder != 0 && isHolder(holder - 1, slotId);
+                if (slot.isOccupied() && !held)
+                    found[t].push_back(makeIssue(AuditIssue::ORPHANED_SLOT, slot.getZoneId(),
+                                                 slot.getAreaId(), slotId));
+                else if (!slot.isOccupied() && held)
+                    found[t].push_back(makeIssue(AuditIssue::FREE_SLOT_IN_USE, slot.getZoneId(),
+                                                 slot.getAreaId(), slotId, holder - 1));
+            }
+        }
+    });
+
+    for (const ParkingSlot* slot : changed)
+        if (slot->getSlotId() < static_cast<int>(inFlux.size()))
+            inFlux[slot->getSlotId()] = 0;
+
+    report.zones += toZone - fromZone + 1;
+    for (int t = 0; t < threads; t++)
+        report.slots += slots[t];
+    merge(found, report);
+    return true;
+}
+
+// -------- Counters --------
+void CityAudit::checkCounters(AuditReport& report, int fromZone, int toZone) const {
+    clampRange(fromZone, toZone);
+    const FreeCapacityIndex& freeIndex = system.getFreeIndex();
+    const OccupancyAnalytics& analytics = system.getAnalytics();
+    std::vector<std::vector<AuditIssue>> found(threads);
+
+    // Per zone recounts, for the city-wide series
+    std::vector<int> zoneOccupied(toZone + 1, 0), zoneCapacity(toZone + 1, 0);
+
+    forEachZone(fromZone, toZone, [&](const Zone& zone, int t) {
+        int z = zone.getZoneId();
+        int zoneFree = 0;
+        for (const auto& area : zone.getParkingAreas()) {
+            int free = 0, occupied = 0, capacity = 0;
+            for (const auto& slot : area.getSlots()) {
+                if (slot.isAvailable()) free++;
+                if (slot.isOccupied()) occupied++;
+                // A closed slot counts towards capacity only while it drains a vehicle
+                if (slot.isInService() || slot.isOccupied()) capacity++;
+            }
+            int a = area.getAreaId();
+            addCounterIssue(found[t], AuditIssue::FREE_COUNT, z, a, free, freeIndex.getAreaFree(z, a));
+            addCounterIssue(found[t], AuditIssue::OCCUPIED_COUNT, z, a, occupied, analytics.getOccupied(z, a));
+            addCounterIssue(found[t], AuditIssue::CAPACITY_COUNT, z, a, capacity, analytics.getCapacity(z, a));
+            zoneFree += free;
+            zoneOccupied[z] += occupied;
+            zoneCapacity[z] += capacity;
+        }
+        addCounterIssue(found[t], AuditIssue::FREE_COUNT, z, 0, zoneFree, freeIndex.getZoneFree(z));
+        addCounterIssue(found[t], AuditIssue::OCCUPIED_COUNT, z, 0, zoneOccupied[z], analytics.getOccupied(z, 0));
+        addCounterIssue(found[t], AuditIssue::CAPACITY_COUNT, z, 0, zoneCapacity[z], analytics.getCapacity(z, 0));
+    });
+
+    if (toZone == zoneCount && zoneCount == system.getLayout().zoneCount) {
+        int occupied = 0, capacity = 0;
+        for (int z = 1; z < fromZone; z++) {
+            occupied += analytics.getOccupied(z, 0);
+            capacity += analytics.getCapacity(z, 0);
+        }
+        for (int z = fromZone; z <= toZone; z++) {
+            occupied += zoneOccupied[z];
+            capacity += zoneCapacity[z];
+        }
+        addCounterIssue(found[0], AuditIssue::OCCUPIED_COUNT, 0, 0, occupied, analytics.getOccupied(0, 0));
+        addCounterIssue(found[0], AuditIssue::CAPACITY_COUNT, 0, 0, capacity, analytics.getCapacity(0, 0));
+    }
+    merge(found, report);
+}
@@ -0,0 +1,110 @@
+#ifndef CITY_AUDIT_H
+#define CITY_AUDIT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ParkingSystem;
+
+// One inconsistency found by CityAudit
+struct AuditIssue {
+    enum Kind {
+        ORPHANED_SLOT,       // taken, but no live request holds it (lost capacity)
+        FREE_SLOT_IN_USE,    // a live request holds a slot marked free
+        DOUBLE_BOOKED,       // two live requests hold the same slot
+        BAD_ALLOCATION,      // a live request names an unknown slot, or the wrong zone / area
+        FREE_COUNT,          // FreeCapacityIndex disagrees with the slots
+        OCCUPIED_COUNT,      // OccupancyAnalytics occupied count disagrees
+        CAPACITY_COUNT,      // OccupancyAnalytics capacity disagrees
+        KIND_COUNT
+    };
+
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    Kind kind;
+    int zoneId;               // counters: 0 = city
+    int areaId;               // counters: 0 = zone total
+    int slotId;               // 0 for counters
+    uint32_t request;         // request handle (index into getRequests()), NONE if none
+    uint32_t otherRequest;    // DOUBLE_BOOKED: the second holder
+    int expected;             // counters: recounted from the slots
+    int actual;               // counters: what the counter holds
+    bool repaired;
+
+    static const char* kindName(Kind kind);
+};
+
+struct AuditReport {
+    int threads;
+    int zones;
+    long long slots;          // slots checked (those in flux are skipped)
+    long long requests;       // live requests seen
+    int found[AuditIssue::KIND_COUNT];
+    int repaired;
+    double millis;
+    std::vector<AuditIssue> issues;   // each check appends its findings by kind, zone, area, slot
+
+    AuditReport();
+    int totalFound() const;
+    bool isClean() const;
+};
+
+// Cross-checks the slots, live requests and free / occupancy counters of
+// a ParkingSystem.
+//
+// An audit pass first records which live request holds each slot
+// (claimSlots), then checks zone ranges against it (checkSlots,
+// checkCounters). Each call is read-only and split across worker
+// threads (requests in chunks, slots one zone at a time) and must not
+// overlap an operation on the system, but operations may run between
+// calls: slots that changed since the pass began (per the status change
+// log) are in flux and left to the next pass, and every holder is
+// re-checked before it is trusted. So a multi-million-slot city can be
+// audited in short steps between commands; ParkingSystem::audit runs
+// the whole pass at once.
+class CityAudit {
+private:
+    const ParkingSystem& system;
+    int threads;
+    int zoneCount;            // zones when the pass began; later ones wait for the next pass
+    uint64_t sinceVersion;    // change log version when the pass began
+    size_t requestEnd;        // requests newer than this hold only changed slots
+    size_t nextRequest;
+
+    std::vector<std::atomic<uint32_t>> holders;   // live request handle + 1 per slot id, 0 = none
+    std::vector<AuditIssue> pending;    // DOUBLE_BOOKED / BAD_ALLOCATION, reported by checkSlots
+    std::vector<uint8_t> inFlux;        // scratch for checkSlots, per slot id
+
+    bool isHolder(uint32_t handle, int slotId) const;
+
+    template<typename Task>
+    void forEachZone(int fromZone, int toZone, Task task) const;
+
+    void clampRange(int& fromZone, int& toZone) const;
+
+public:
+    // threads <= 0 uses every core
+    CityAudit(const ParkingSystem& system, int threads = 0);
+
+    int getThreads() const;
+    int getZoneCount() const;
+
+    // Sees up to maxRequests more requests; true once all have been seen
+    bool claimSlots(AuditReport& report, size_t maxRequests = SIZE_MAX);
+
+    // Slot <-> request agreement in fromZone..toZone (toZone <= 0 = last):
+    // ORPHANED_SLOT, FREE_SLOT_IN_USE, DOUBLE_BOOKED, BAD_ALLOCATION.
+    // Needs claimSlots finished. False, with nothing checked, when more
+    // slots changed since the pass began than the change log holds.
+    bool checkSlots(AuditReport& report, int fromZone = 1, int toZone = 0);
+
+    // Counters recounted from the slots of fromZone..toZone: FREE_COUNT,
+    // OCCUPIED_COUNT, CAPACITY_COUNT. City-wide series are checked with
+    // the range that ends at the last zone, trusting the counters of
+    // zones before the range (audited by earlier calls).
+    void checkCounters(AuditReport& report, int fromZone = 1, int toZone = 0) const;
+};
+
+#endif
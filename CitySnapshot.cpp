@@ -0,0 +1,177 @@
+#include "CitySnapshot.h"
+#include "Clock.h"
+#include "JsonWriter.h"
+
+// -------- Snapshot --------
+HistoryEntry HistoryEntry::capture(const ParkingRequest& req) {
+    HistoryEntry entry = {
+        req.getRequestId(), req.getVehicleNumber(), req.getVehicleType(), req.getState(),
+        req.getAllocatedZoneId(), req.getAllocatedAreaId(), req.getAllocatedSlotId(),
+        req.getRequestTimeNanos(), req.getOccupyTimeNanos(), req.getReleaseTimeNanos(),
+        req.getCharge()
+    };
+    return entry;
+}
+
+CitySnapshot::CitySnapshot()
+    : sequence(0), changeVersion(0), publishedNanos(0), totalSlots(0), freeSlots(0) {}
+
+void CitySnapshot::printZoneStatus(std::ostream& out) const {
+    out << "\n========== ZONE STATUS ==========\n";
+    for (const ZoneCounters& zone : zones) {
+        double utilization = zone.totalSlots ? 1.0 - static_cast<double>(zone.freeSlots) / zone.totalSlots : 0.0;
+        out << "Zone-" << zone.zoneId
+            << " | Total: " << zone.totalSlots
+            << " | Free: " << zone.freeSlots
+            << " | Utilization: " << utilization * 100 << "%\n";
+    }
+    out << "================================\n";
+}
+
+// Same layout as ParkingSystem::displayLastOperations, but times are
+// formatted with JsonWriter::formatTimestamp because ctime's static
+// buffer is not safe on reader threads
+void CitySnapshot::printHistory(std::ostream& out, int count) const {
+    out << "\n========== LAST " << count << " OPERATIONS ==========\n";
+    if (history.empty()) {
+        out << "No operations recorded yet.\n";
+        return;
+    }
+
+    char text[24];
+    int shown = 0;
+    for (const HistoryEntry& entry : history) {
+        if (shown >= count)
+            break;
+        shown++;
+
+        out << "Operation #" << shown << ":\n";
+        out << "  Vehicle: " << entry.plate << "\n";
+        out << "  Type: " << Vehicle::vehicleTypeName(entry.type) << "\n";
+        out << "  Status: " << ParkingRequest::stateName(entry.state) << "\n";
+        if (entry.slotId != -1) {
+            out << "  Slot: " << entry.slotId << " (Zone " << entry.zoneId
+                << ", Area " << entry.areaId << ")\n";
+        }
+
+        JsonWriter::formatTimestamp(entry.requestNanos / Clock::NANOS_PER_SECOND, text);
+        out << "  Requested: " << text << "\n";
+        if (entry.occupyNanos > 0) {
+            JsonWriter::formatTimestamp(entry.occupyNanos / Clock::NANOS_PER_SECOND, text);
+            out << "  Occupied: " << text << "\n";
+        }
+        if (entry.releaseNanos > 0) {
+            JsonWriter::formatTimestamp(entry.releaseNanos / Clock::NANOS_PER_SECOND, text);
+            out << "  Released: " << text << "\n";
+            if (entry.state == ParkingRequest::RELEASED)
+                out << "  Charge: Rs " << entry.charge / 100.0 << "\n";
+        }
+        out << "-----------------------------------\n";
+    }
+}
+
+// -------- Holder --------
+CitySnapshots::CitySnapshots()
+    : current(nullptr), sequence(0), historyDepth(0), reclaimedCount(0) {}
+
+CitySnapshots::~CitySnapshots() {
+    delete current.load();
+    for (auto& entry : retired)
+        delete entry.snapshot;
+    for (auto snapshot : spare)
+        delete snapshot;
+}
+
+void CitySnapshots::enable(int depth) {
+    historyDepth = depth > 0 ? depth : 1;
+    history.reserve(historyDepth + 1);
+}
+
+bool CitySnapshots::isEnabled() const {
+    return historyDepth > 0;
+}
+
+int CitySnapshots::getHistoryDepth() const {
+    return historyDepth;
+}
+
+// -------- Working History --------
+// Request ids only grow, so a newer id goes in front; an older one is
+// updated in place if it is still inside the window
+void CitySnapshots::recordHistory(const HistoryEntry& entry) {
+    if (history.empty() || entry.requestId > history.front().requestId) {
+        history.insert(history.begin(), entry);
+        if (static_cast<int>(history.size()) > historyDepth)
+            history.pop_back();
+        return;
+    }
+    for (auto& existing : history) {
+        if (existing.requestId == entry.requestId) {
+            existing = entry;
+            return;
+        }
+    }
+}
+
+void CitySnapshots::clearHistory() {
+    history.clear();
+}
+
+void CitySnapshots::appendHistory(const HistoryEntry& entry) {
+    if (static_cast<int>(history.size()) < historyDepth)
+        history.push_back(entry);
+}
+
+CitySnapshot* CitySnapshots::prepare() {
+    reclaim();
+    if (spare.empty())
+        return new CitySnapshot();
+
+    CitySnapshot* snapshot = spare.back();
+    spare.pop_back();
+    // clear() keeps capacity, so rebuilding does not allocate
+    snapshot->zones.clear();
+    snapshot->areas.clear();
+    return snapshot;
+}
+
+void CitySnapshots::publish(CitySnapshot* next) {
+    next->history.assign(history.begin(), history.end());
+    next->sequence = ++sequence;
+    const CitySnapshot* previous = current.exchange(next);
+    if (previous) {
+        Retired entry = { domain.advance(), const_cast<CitySnapshot*>(previous) };
+        retired.push_back(entry);
+    }
+    reclaim();
+}
+
+// Stamps only grow, so everything before the first busy entry is free
+void CitySnapshots::reclaim() {
+    if (retired.empty())
+        return;
+
+    uint64_t oldest = domain.oldestActive();
+    size_t freed = 0;
+    while (freed < retired.size() && retired[freed].stamp < oldest) {
+        if (spare.size() < static_cast<size_t>(MAX_SPARE))
+            spare.push_back(retired[freed].snapshot);
+        else
+            delete retired[freed].snapshot;
+        freed++;
+    }
+    retired.erase(retired.begin(), retired.begin() + freed);
+    reclaimedCount += freed;
+}
+
+size_t CitySnapshots::getPendingCount() const {
+    return retired.size();
+}
+
+uint64_t CitySnapshots::getReclaimedCount() const {
+    return reclaimedCount;
+}
+
+// -------- View --------
+CitySnapshotView::CitySnapshotView(const CitySnapshots& snapshots)
+    : guard(snapshots.domain), snapshot(snapshots.current.load()) {}
@@ -0,0 +1,137 @@
+#ifndef CITY_SNAPSHOT_H
+#define CITY_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "EpochDomain.h"
+#include "ParkingRequest.h"
+#include "VehiclePlate.h"
+
+struct ZoneCounters {
+    int zoneId;
+    int totalSlots;
+    int freeSlots;
+};
+
+struct AreaCounters {
+    int zoneId;
+    int areaId;
+    int totalSlots;
+    int freeSlots;
+};
+
+// A request as it was when the snapshot was taken
+struct HistoryEntry {
+    int requestId;
+    VehiclePlate plate;
+    Vehicle::VehicleType type;
+    ParkingRequest::RequestState state;
+    int zoneId;
+    int areaId;
+    int slotId;
+    int64_t requestNanos;
+    int64_t occupyNanos;
+    int64_t releaseNanos;
+    int64_t charge;          // paisa
+
+    static HistoryEntry capture(const ParkingRequest& request);
+};
+
+// Immutable view of zone counters and recent history, published by the
+// writer after every successful operation. Never modified once published.
+struct CitySnapshot {
+    uint64_t sequence;       // 1, 2, 3 ... per publish
+    uint64_t changeVersion;  // StatusChangeLog version it reflects
+    int64_t publishedNanos;
+    int totalSlots;
+    int freeSlots;
+    std::vector<ZoneCounters> zones;
+    std::vector<AreaCounters> areas;     // zone-major, same order as the city
+    std::vector<HistoryEntry> history;   // newest first
+
+    CitySnapshot();
+
+    void printZoneStatus(std::ostream& out) const;
+    void printHistory(std::ostream& out, int count) const;
+};
+
+// Read-copy-update holder for the current CitySnapshot.
+//
+// One writer (the thread that mutates ParkingSystem) builds a new
+// snapshot and swaps it in with publish(). Readers on any thread open a
+// CitySnapshotView, which pins the snapshot it saw through an
+// EpochDomain; they never take a lock and the writer never waits for
+// them. Superseded snapshots are freed once no reader can hold them, and
+// their buffers are recycled for the next build, so a steady writer
+// stops allocating.
+class CitySnapshots {
+public:
+    static const int MAX_SPARE = 4;
+
+private:
+    mutable EpochDomain domain;          // readers announce through a const holder
+    std::atomic<const CitySnapshot*> current;
+
+    struct Retired {
+        uint64_t stamp;
+        CitySnapshot* snapshot;
+    };
+    std::vector<Retired> retired;        // oldest first
+    std::vector<CitySnapshot*> spare;    // reclaimed, ready for reuse
+    std::vector<HistoryEntry> history;   // writer's working copy, newest first
+    uint64_t sequence;
+    int historyDepth;                    // 0 = disabled
+    uint64_t reclaimedCount;
+
+    void reclaim();
+
+    CitySnapshots(const CitySnapshots&);
+    CitySnapshots& operator=(const CitySnapshots&);
+
+    friend class CitySnapshotView;
+
+public:
+    CitySnapshots();
+    ~CitySnapshots();   // no reader may still hold a view
+
+    // -------- Writer --------
+    void enable(int historyDepth);
+    bool isEnabled() const;
+    int getHistoryDepth() const;
+
+    // Working history, kept incrementally so publishing copies one
+    // contiguous block instead of revisiting every request
+    void recordHistory(const HistoryEntry& entry);   // new request or changed state
+    void clearHistory();
+    void appendHistory(const HistoryEntry& entry);   // rebuild, newest first
+
+    // A blank or recycled snapshot to fill with counters, then hand to
+    // publish(), which adds the working history
+    CitySnapshot* prepare();
+    void publish(CitySnapshot* next);
+
+    size_t getPendingCount() const;      // retired, not yet reclaimable
+    uint64_t getReclaimedCount() const;
+};
+
+// Pins the snapshot current at construction for this object's lifetime.
+// null when snapshots are not enabled yet.
+class CitySnapshotView {
+private:
+    EpochGuard guard;
+    const CitySnapshot* snapshot;
+
+    CitySnapshotView(const CitySnapshotView&);
+    CitySnapshotView& operator=(const CitySnapshotView&);
+
+public:
+    explicit CitySnapshotView(const CitySnapshots& snapshots);
+
+    const CitySnapshot* get() const { return snapshot; }
+    const CitySnapshot* operator->() const { return snapshot; }
+    const CitySnapshot& operator*() const { return *snapshot; }
+};
+
+#endif
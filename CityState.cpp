@@ -0,0 +1,239 @@
+#include "CityState.h"
+#include "ParkingSystem.h"
+
+// -------- Construction --------
+CityState::CityState()
+    : zoneCount(0), areasPerZone(0), slotsPerArea(0), freeSlots(0), occupiedSlots(0), capacity(0) {}
+
+CityState::CityState(int zones, int areas, int slotsEach, const std::vector<uint8_t>& slotStates)
+    : zoneCount(zones), areasPerZone(areas), slotsPerArea(slotsEach),
+      slots(slotStates), freeSlots(0), occupiedSlots(0), capacity(0) {
+    std::vector<int32_t> areaCounts(static_cast<size_t>(zones) * areas, 0);
+    std::vector<int32_t> zoneCounts(zones, 0);
+
+    for (size_t i = 0; i < slotStates.size(); i++) {
+        SlotState state = static_cast<SlotState>(slotStates[i]);
+        if (state != CLOSED) capacity++;
+        if (state == OCCUPIED || state == DRAINING) occupiedSlots++;
+        if (state == FREE) {
+            freeSlots++;
+            areaCounts[i / slotsPerArea]++;
+            zoneCounts[i / (static_cast<size_t>(slotsPerArea) * areas)]++;
+        }
+    }
+    areaFree = PersistentArray<int32_t>(areaCounts);
+    zoneFree = PersistentArray<int32_t>(zoneCounts);
+}
+
+CityState CityState::capture(const ParkingSystem& system) {
+    const CityLayout& layout = system.getLayout();
+    std::vector<uint8_t> states;
+    states.reserve(layout.getTotalSlots());
+
+    for (auto zone : system.getZones())
+        for (const auto& area : zone->getParkingAreas())
+            for (const auto& slot : area.getSlots()) {
+                if (slot.isInService())
+                    states.push_back(slot.isOccupied() ? OCCUPIED : FREE);
+                else
+                    states.push_back(slot.isOccupied() ? DRAINING : CLOSED);
+            }
+    return CityState(layout.zoneCount, layout.areasPerZone, layout.slotsPerArea, states);
+}
+
+// -------- Helpers --------
+int CityState::areaIndex(int zoneId, int areaId) const {
+    return (zoneId - 1) * areasPerZone + (areaId - 1);
+}
+
+// The one place slot state changes, so the counters cannot drift
+void CityState::setSlot(int slotId, SlotState next) {
+    SlotState previous = static_cast<SlotState>(slots.get(slotId - 1));
+    if (previous == next)
+        return;
+
+    int freeDelta = (next == FREE) - (previous == FREE);
+    occupiedSlots += (next == OCCUPIED || next == DRAINING) - (previous == OCCUPIED || previous == DRAINING);
+    capacity += (next != CLOSED) - (previous != CLOSED);
+    slots.set(slotId - 1, next);
+
+    if (freeDelta != 0) {
+        int zone = (slotId - 1) / (slotsPerArea * areasPerZone);
+        int area = (slotId - 1) / slotsPerArea;
+        freeSlots += freeDelta;
+        zoneFree.set(zone, zoneFree.get(zone) + freeDelta);
+        areaFree.set(area, areaFree.get(area) + freeDelta);
+    }
+}
+
+int CityState::allocateInArea(int zoneId, int areaId) {
+    if (areaId < 1 || areaId > areasPerZone || areaFree.get(areaIndex(zoneId, areaId)) == 0)
+        return -1;
+
+    int first = areaIndex(zoneId, areaId) * slotsPerArea + 1;
+    for (int slotId = first; slotId < first + slotsPerArea; slotId++) {
+        if (slots.get(slotId - 1) == FREE) {
+            setSlot(slotId, OCCUPIED);
+            return slotId;
+        }
+    }
+    return -1;
+}
+
+int CityState::allocateInZone(int zoneId, int skipAreaId) {
+    if (zoneId < 1 || zoneId > zoneCount || zoneFree.get(zoneId - 1) == 0)
+        return -1;
+    for (int a = 1; a <= areasPerZone; a++) {
+        if (a == skipAreaId)
+            continue;
+        int slotId = allocateInArea(zoneId, a);
+        if (slotId > 0)
+            return slotId;
+    }
+    return -1;
+}
+
+// -------- Operations --------
+int CityState::allocate(int zoneId, int areaId, bool& crossZone) {
+    crossZone = false;
+    int slotId;
+
+    if (areaId > 0 && zoneId >= 1 && zoneId <= zoneCount) {
+        if ((slotId = allocateInArea(zoneId, areaId)) > 0)
+            return slotId;
+        if ((slotId = allocateInZone(zoneId, areaId)) > 0)
+            return slotId;
+        for (int z = 1; z <= zoneCount; z++)
+            if (z != zoneId && zoneFree.get(z - 1) > 0 && (slotId = allocateInArea(z, areaId)) > 0) {
+                crossZone = true;
+                return slotId;
+            }
+    }
+
+    if ((slotId = allocateInZone(zoneId, 0)) > 0)
+        return slotId;
+    for (int z = 1; z <= zoneCount; z++)
+        if (z != zoneId && (slotId = allocateInZone(z, 0)) > 0) {
+            crossZone = true;
+            return slotId;
+        }
+    return -1;
+}
+
+bool CityState::release(int slotId) {
+    if (slotId < 1 || slotId > static_cast<int>(slots.size()))
+        return false;
+    SlotState state = static_cast<SlotState>(slots.get(slotId - 1));
+    if (state == OCCUPIED)
+        setSlot(slotId, FREE);
+    else if (state == DRAINING)
+        setSlot(slotId, CLOSED);
+    else
+        return false;
+    return true;
+}
+
+int CityState::setAreaService(int zoneId, int areaId, bool inService) {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 1 || areaId > areasPerZone)
+        return -1;
+
+    int changed = 0;
+    int first = areaIndex(zoneId, areaId) * slotsPerArea + 1;
+    for (int slotId = first; slotId < first + slotsPerArea; slotId++) {
+        SlotState state = static_cast<SlotState>(slots.get(slotId - 1));
+        SlotState next = state;
+        if (inService)
+            next = state == CLOSED ? FREE : state == DRAINING ? OCCUPIED : state;
+        else
+            next = state == FREE ? CLOSED : state == OCCUPIED ? DRAINING : state;
+        if (next != state) {
+            setSlot(slotId, next);
+            changed++;
+        }
+    }
+    return changed;
+}
+
+int CityState::closeArea(int zoneId, int areaId) {
+    return setAreaService(zoneId, areaId, false);
+}
+
+int CityState::openArea(int zoneId, int areaId) {
+    return setAreaService(zoneId, areaId, true);
+}
+
+int CityState::closeZone(int zoneId) {
+    int changed = 0;
+    for (int a = 1; a <= areasPerZone; a++) {
+        int result = setAreaService(zoneId, a, false);
+        if (result < 0)
+            return -1;
+        changed += result;
+    }
+    return changed;
+}
+
+int CityState::openZone(int zoneId) {
+    int changed = 0;
+    for (int a = 1; a <= areasPerZone; a++) {
+        int result = setAreaService(zoneId, a, true);
+        if (result < 0)
+            return -1;
+        changed += result;
+    }
+    return changed;
+}
+
+// -------- Queries --------
+int CityState::getZoneCount() const {
+    return zoneCount;
+}
+
+int CityState::getAreasPerZone() const {
+    return areasPerZone;
+}
+
+int CityState::getSlotsPerArea() const {
+    return slotsPerArea;
+}
+
+int CityState::getFreeSlots() const {
+    return freeSlots;
+}
+
+int CityState::getOccupiedSlots() const {
+    return occupiedSlots;
+}
+
+int CityState::getCapacity() const {
+    return capacity;
+}
+
+int CityState::getZoneFree(int zoneId) const {
+    return (zoneId >= 1 && zoneId <= zoneCount) ? zoneFree.get(zoneId - 1) : 0;
+}
+
+int CityState::getAreaFree(int zoneId, int areaId) const {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 1 || areaId > areasPerZone)
+        return 0;
+    return areaFree.get(areaIndex(zoneId, areaId));
+}
+
+CityState::SlotState CityState::getSlotState(int slotId) const {
+    if (slotId < 1 || slotId > static_cast<int>(slots.size()))
+        return CLOSED;
+    return static_cast<SlotState>(slots.get(slotId - 1));
+}
+
+void CityState::collectOccupied(std::vector<int>& slotIds) const {
+    slotIds.clear();
+    for (size_t i = 0; i < slots.size(); i++) {
+        uint8_t state = slots.get(i);
+        if (state == OCCUPIED || state == DRAINING)
+            slotIds.push_back(static_cast<int>(i) + 1);
+    }
+}
+
+bool CityState::sharesSlotsWith(const CityState& other) const {
+    return slots.sharesWith(other.slots);
+}
@@ -0,0 +1,85 @@
+#ifndef CITY_STATE_H
+#define CITY_STATE_H
+
+#include <cstdint>
+#include <vector>
+#include "PersistentArray.h"
+
+class ParkingSystem;
+
+// Forkable model of a city's slots for what-if planning.
+//
+// Slot states and the per-zone / per-area free counters live in
+// PersistentArrays, so copying a CityState is O(1): the copy shares
+// everything with its parent, and each change afterwards path-copies
+// O(log n) nodes in the copy only. Any number of forks can be simulated
+// concurrently on different threads.
+//
+// Allocation follows AllocationEngine's search order (requested zone
+// first, then the other zones in id order; with an area: exact area,
+// other areas of the zone, the same area elsewhere, then anywhere), but
+// skips full zones and areas through the counters instead of scanning.
+class CityState {
+public:
+    enum SlotState : uint8_t {
+        FREE,
+        OCCUPIED,
+        CLOSED,
+        DRAINING               // closed, vehicle still parked
+    };
+
+private:
+    int zoneCount;
+    int areasPerZone;
+    int slotsPerArea;
+
+    PersistentArray<uint8_t> slots;      // slotId - 1
+    PersistentArray<int32_t> areaFree;   // (zoneId - 1) * areasPerZone + areaId - 1
+    PersistentArray<int32_t> zoneFree;   // zoneId - 1
+    int freeSlots;
+    int occupiedSlots;
+    int capacity;                        // slots in service + draining
+
+    int areaIndex(int zoneId, int areaId) const;
+    void setSlot(int slotId, SlotState next);
+    int allocateInArea(int zoneId, int areaId);
+    int allocateInZone(int zoneId, int skipAreaId);
+    int setAreaService(int zoneId, int areaId, bool inService);
+
+public:
+    CityState();
+
+    // slotStates is indexed by slotId - 1 (zone, area, slot order)
+    CityState(int zoneCount, int areasPerZone, int slotsPerArea, const std::vector<uint8_t>& slotStates);
+
+    // O(slots), once per planning run; forks are plain copies
+    static CityState capture(const ParkingSystem& system);
+
+    // -------- Operations --------
+    // Returns the slot id, or -1 when the city is full
+    int allocate(int zoneId, int areaId, bool& crossZone);
+    bool release(int slotId);
+
+    // Closing keeps parked vehicles until they leave (DRAINING).
+    // Each returns the number of slots whose service state changed.
+    int closeArea(int zoneId, int areaId);
+    int openArea(int zoneId, int areaId);
+    int closeZone(int zoneId);
+    int openZone(int zoneId);
+
+    // -------- Queries --------
+    int getZoneCount() const;
+    int getAreasPerZone() const;
+    int getSlotsPerArea() const;
+    int getFreeSlots() const;
+    int getOccupiedSlots() const;
+    int getCapacity() const;
+    int getZoneFree(int zoneId) const;
+    int getAreaFree(int zoneId, int areaId) const;
+    SlotState getSlotState(int slotId) const;
+    void collectOccupied(std::vector<int>& slotIds) const;   // O(slots)
+
+    bool sharesSlotsWith(const CityState& other) const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "Clock.h"
+
+// -------- Clock --------
+time_t Clock::nowSeconds() const {
+    return static_cast<time_t>(nowNanos() / NANOS_PER_SECOND);
+}
+
+// -------- Real Clock --------
+RealClock::RealClock()
+    : steadyAtStart(std::chrono::steady_clock::now()) {
+    epochAtStart = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t RealClock::nowNanos() const {
+    auto elapsed = std::chrono::steady_clock::now() - steadyAtStart;
+    return epochAtStart + std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+// -------- Virtual Clock --------
+VirtualClock::VirtualClock(int64_t startNanos)
+    : current(startNanos) {}
+
+int64_t VirtualClock::nowNanos() const {
+    return current;
+}
+
+void VirtualClock::set(int64_t nanos) {
+    // Time never runs backwards
+    if (nanos > current)
+        current = nanos;
+}
+
+void VirtualClock::advance(int64_t nanos) {
+    if (nanos > 0)
+        current += nanos;
+}
+
+void VirtualClock::advanceSeconds(double seconds) {
+    advance(static_cast<int64_t>(seconds * NANOS_PER_SECOND));
+}
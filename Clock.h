@@ -0,0 +1,50 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+// Time source injected into ParkingSystem.
+// All timestamps are nanoseconds since the Unix epoch.
+class Clock {
+public:
+    static const int64_t NANOS_PER_SECOND = 1000000000LL;
+
+    virtual ~Clock() {}
+    virtual int64_t nowNanos() const = 0;
+
+    time_t nowSeconds() const;
+};
+
+// -------- Real Clock --------
+// Wall-clock epoch captured once, then advanced by the monotonic
+// steady_clock, so readings never go backwards.
+class RealClock : public Clock {
+private:
+    int64_t epochAtStart;
+    std::chrono::steady_clock::time_point steadyAtStart;
+
+public:
+    RealClock();
+    int64_t nowNanos() const override;
+};
+
+// -------- Virtual Clock --------
+// Only moves when told to; used to simulate days of traffic in seconds.
+class VirtualClock : public Clock {
+private:
+    int64_t current;
+
+public:
+    static const int64_t DEFAULT_START = 1735689600LL * NANOS_PER_SECOND;   // 2025-01-01 00:00 UTC
+
+    explicit VirtualClock(int64_t startNanos = DEFAULT_START);
+    int64_t nowNanos() const override;
+
+    void set(int64_t nanos);
+    void advance(int64_t nanos);
+    void advanceSeconds(double seconds);
+};
+
+#endif
@@ -0,0 +1,322 @@
+#include "CommandParser.h"
+#include "ParkingSlot.h"
+#include <climits>
+#include <cstring>
+
+// -------- Command --------
+Command::Command()
+    : type(UNKNOWN), vehicleType(Vehicle::CAR), zoneId(0), areaId(0), toZoneId(0), count(0), version(0),
+      fromSlot(0), toSlot(0), requiredAttributes(0), preferredAttributes(0) {}
+
+// -------- Tokenizer --------
+bool CommandParser::nextToken(const char*& cursor, const char* end,
+                              const char*& token, size_t& tokenLength) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        cursor++;
+
+    if (cursor >= end)
+        return false;
+
+    token = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n')
+        cursor++;
+
+    tokenLength = static_cast<size_t>(cursor - token);
+    return true;
+}
+
+bool CommandParser::parseInt(const char* token, size_t length, int& value) {
+    if (length == 0)
+        return false;
+
+    size_t i = 0;
+    bool negative = false;
+    if (token[0] == '-') {
+        negative = true;
+        i = 1;
+        if (length == 1) return false;
+    }
+
+    int result = 0;
+    for (; i < length; i++) {
+        if (token[i] < '0' || token[i] > '9')
+            return false;
+        int digit = token[i] - '0';
+        if (result > (INT_MAX - digit) / 10)
+            return false;   // out of range; untrusted input must not overflow
+        result = result * 10 + digit;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+bool CommandParser::parseVersion(const char* token, size_t length, uint64_t& value) {
+    if (length == 0 || length > 19)
+        return false;
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (token[i] < '0' || token[i] > '9')
+            return false;
+        result = result * 10 + static_cast<uint64_t>(token[i] - '0');
+    }
+    value = result;
+    return true;
+}
+
+static bool tokenEquals(const char* token, size_t length, const char* keyword) {
+    size_t keywordLength = std::strlen(keyword);
+    if (length != keywordLength)
+        return false;
+
+    for (size_t i = 0; i < length; i++) {
+        char c = token[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != keyword[i])
+            return false;
+    }
+    return true;
+}
+
+bool CommandParser::parseVehicleType(const char* token, size_t length, Vehicle::VehicleType& type) {
+    if (tokenEquals(token, length, "1") || tokenEquals(token, length, "CAR")) {
+        type = Vehicle::CAR;
+        return true;
+    }
+    if (tokenEquals(token, length, "2") || tokenEquals(token, length, "BIKE")) {
+        type = Vehicle::BIKE;
+        return true;
+    }
+    return false;
+}
+
+// Optional "[fromZone] [toZone]"; omitted ends select the whole city
+bool CommandParser::parseZoneRange(const char*& cursor, const char* end, Command& command) {
+    const char* token;
+    size_t tokenLength;
+
+    command.zoneId = 1;
+    command.toZoneId = 0;
+    if (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.zoneId))
+        return false;
+    if (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.toZoneId))
+        return false;
+    return true;
+}
+
+// -------- Parse One Line --------
+bool CommandParser::parse(const char* line, size_t length, Command& command) {
+    const char* cursor = line;
+    const char* end = line + length;
+    const char* token;
+    size_t tokenLength;
+
+    command = Command();
+
+    if (!nextToken(cursor, end, token, tokenLength))
+        return false;
+
+    if (tokenEquals(token, tokenLength, "PARK")) {
+        command.type = Command::PARK;
+    } else if (tokenEquals(token, tokenLength, "OCCUPY")) {
+        command.type = Command::OCCUPY;
+    } else if (tokenEquals(token, tokenLength, "RELEASE")) {
+        command.type = Command::RELEASE;
+    } else if (tokenEquals(token, tokenLength, "CANCEL")) {
+        command.type = Command::CANCEL;
+    } else if (tokenEquals(token, tokenLength, "ROLLBACK")) {
+        command.type = Command::ROLLBACK;
+    } else if (tokenEquals(token, tokenLength, "STATUS")) {
+        command.type = Command::STATUS;
+        return true;
+    } else if (tokenEquals(token, tokenLength, "HISTORY")) {
+        command.type = Command::HISTORY;
+        command.count = 20;
+        if (nextToken(cursor, end, token, tokenLength) &&
+            !parseInt(token, tokenLength, command.count)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "SEARCH")) {
+        command.type = Command::SEARCH;
+        command.count = 20;
+        if (!nextToken(cursor, end, token, tokenLength)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        command.plate = VehiclePlate(token, tokenLength);
+        if (!command.plate.isValid() ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.count))) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "STATS")) {
+        command.type = Command::STATS;
+        return true;
+    } else if (tokenEquals(token, tokenLength, "ANALYTICS")) {
+        command.type = Command::ANALYTICS;
+        if ((nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.zoneId)) ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.areaId))) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "FREE")) {
+        command.type = Command::FREE;
+        if (!parseZoneRange(cursor, end, command)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "ATLEAST") || tokenEquals(token, tokenLength, "TOPK")) {
+        command.type = tokenEquals(token, tokenLength, "TOPK") ? Command::TOPK : Command::ATLEAST;
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.count) ||
+            !parseZoneRange(cursor, end, command)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "AREAS")) {
+        command.type = Command::AREAS;
+        command.count = 1;
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.zoneId) ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.count))) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "SUBSCRIBE")) {
+        command.type = Command::SUBSCRIBE;
+        command.count = 250;
+        if (nextToken(cursor, end, token, tokenLength) &&
+            (!parseInt(token, tokenLength, command.count) || command.count <= 0)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "UNSUBSCRIBE")) {
+        command.type = Command::UNSUBSCRIBE;
+        return true;
+    } else if (tokenEquals(token, tokenLength, "DELTA")) {
+        command.type = Command::DELTA;
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !parseVersion(token, tokenLength, command.version)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "BINARY")) {
+        command.type = Command::BINARY;
+        return true;
+    } else if (tokenEquals(token, tokenLength, "TRACE")) {
+        command.type = Command::TRACE;
+        command.count = -1;
+        if (nextToken(cursor, end, token, tokenLength) &&
+            (!parseInt(token, tokenLength, command.count) || command.count < 0)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "CLOSE") || tokenEquals(token, tokenLength, "OPEN") ||
+               tokenEquals(token, tokenLength, "REMOVE")) {
+        command.type = tokenEquals(token, tokenLength, "CLOSE") ? Command::CLOSE
+                     : tokenEquals(token, tokenLength, "OPEN") ? Command::OPEN : Command::REMOVE;
+        bool slotRange = command.type != Command::REMOVE;
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.zoneId) ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.areaId)) ||
+            (slotRange && nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.fromSlot)) ||
+            (slotRange && nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.toSlot))) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "ATTRIBUTES")) {
+        command.type = Command::ATTRIBUTES;
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !ParkingSlot::parseAttributes(token, tokenLength, command.requiredAttributes) ||
+            !nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.zoneId) ||
+            !nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.areaId) ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.fromSlot)) ||
+            (nextToken(cursor, end, token, tokenLength) && !parseInt(token, tokenLength, command.toSlot))) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "ADDZONE")) {
+        command.type = Command::ADDZONE;
+        return true;
+    } else if (tokenEquals(token, tokenLength, "AUDIT")) {
+        command.type = Command::AUDIT;
+        command.count = 0;
+        const char* rest = cursor;
+        if (nextToken(cursor, end, token, tokenLength) && tokenEquals(token, tokenLength, "REPAIR"))
+            command.count = 1;
+        else
+            cursor = rest;
+        if (!parseZoneRange(cursor, end, command)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    } else if (tokenEquals(token, tokenLength, "EXIT") || tokenEquals(token, tokenLength, "QUIT")) {
+        command.type = Command::EXIT;
+        return true;
+    } else {
+        return false;
+    }
+
+    if (command.type == Command::ROLLBACK) {
+        if (!nextToken(cursor, end, token, tokenLength) ||
+            !parseInt(token, tokenLength, command.count)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+        return true;
+    }
+
+    // <plate> <type>
+    if (!nextToken(cursor, end, token, tokenLength)) {
+        command.type = Command::UNKNOWN;
+        return false;
+    }
+    command.plate = VehiclePlate(token, tokenLength);
+
+    if (!nextToken(cursor, end, token, tokenLength) ||
+        !parseVehicleType(token, tokenLength, command.vehicleType)) {
+        command.type = Command::UNKNOWN;
+        return false;
+    }
+
+    if (command.type != Command::PARK)
+        return true;
+
+    // PARK: <zone> [area] [NEED <attributes>] [PREFER <attributes>]
+    if (!nextToken(cursor, end, token, tokenLength) ||
+        !parseInt(token, tokenLength, command.zoneId)) {
+        command.type = Command::UNKNOWN;
+        return false;
+    }
+    bool areaAllowed = true;
+    while (nextToken(cursor, end, token, tokenLength)) {
+        if (areaAllowed && parseInt(token, tokenLength, command.areaId)) {
+            areaAllowed = false;
+            continue;
+        }
+        areaAllowed = false;
+        uint8_t* attributes = tokenEquals(token, tokenLength, "NEED") ? &command.requiredAttributes
+                            : tokenEquals(token, tokenLength, "PREFER") ? &command.preferredAttributes : nullptr;
+        if (!attributes || !nextToken(cursor, end, token, tokenLength) ||
+            !ParkingSlot::parseAttributes(token, tokenLength, *attributes)) {
+            command.type = Command::UNKNOWN;
+            return false;
+        }
+    }
+    return true;
+}
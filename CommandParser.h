@@ -0,0 +1,100 @@
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Vehicle.h"
+#include "VehiclePlate.h"
+
+// One parsed line of the text protocol spoken by the Node bridge:
+//   PARK <plate> <type> <zone> <area> [NEED <attributes>] [PREFER <attributes>]
+//                                       (type 1=Car 2=Bike, area 0=any; attributes
+//                                        like EV,ACCESSIBLE - see ParkingSlot)
+//   OCCUPY | RELEASE | CANCEL <plate> <type>
+//   ROLLBACK <k>
+//   STATUS
+//   HISTORY [count]
+//   SEARCH <partial plate> [limit]      (prefix match, then one misread character; default 20)
+//   STATS
+//   ANALYTICS [zone] [area]             (0 or omitted = city / whole zone)
+//   FREE [fromZone] [toZone]            (free slots in a zone range)
+//   ATLEAST <n> [fromZone] [toZone]     (zones with >= n free slots)
+//   TOPK <k> [fromZone] [toZone]        (k zones with the most free slots)
+//   AREAS <zone> [n]                    (areas of a zone with >= n free, default 1)
+//   SUBSCRIBE [intervalMs]              (push coalesced STATUS deltas, default 250 ms)
+//   UNSUBSCRIBE
+//   DELTA <sinceVersion>                (pull one STATUS delta)
+//   TRACE [every]                       (no argument exports spans; 0 disables)
+//   BINARY                              (rest of the connection uses BinaryProtocol frames)
+//   CLOSE | OPEN <zone> [area] [fromSlot] [toSlot]
+//                                       (take slots out of / back into service;
+//                                        area 0 or omitted = whole zone)
+//   REMOVE <zone> [area]                (close for good)
+//   ATTRIBUTES <attributes|NONE> <zone> <area> [fromSlot] [toSlot]
+//                                       (set the attributes of a slot range)
+//   ADDZONE                             (append a zone shaped like the others)
+//   AUDIT [REPAIR] [fromZone] [toZone]  (cross-check slots, requests and counters)
+struct Command {
+    enum CommandType {
+        PARK,
+        OCCUPY,
+        RELEASE,
+        CANCEL,
+        ROLLBACK,
+        STATUS,
+        HISTORY,
+        SEARCH,
+        STATS,
+        ANALYTICS,
+        FREE,
+        ATLEAST,
+        TOPK,
+        AREAS,
+        SUBSCRIBE,
+        UNSUBSCRIBE,
+        DELTA,
+        TRACE,
+        BINARY,
+        CLOSE,
+        OPEN,
+        REMOVE,
+        ATTRIBUTES,
+        ADDZONE,
+        AUDIT,
+        EXIT,
+        UNKNOWN
+    };
+
+    CommandType type;
+    VehiclePlate plate;
+    Vehicle::VehicleType vehicleType;
+    int zoneId;
+    int areaId;
+    int toZoneId;               // end of a zone range, 0 = last zone
+    int count;                  // HISTORY/ROLLBACK count, SEARCH limit, TRACE sample rate (-1 = export),
+                                // AUDIT repair (1) or report only (0)
+    uint64_t version;           // DELTA base version
+    int fromSlot;               // CLOSE/OPEN/ATTRIBUTES slot range within the area, 0 = whole area
+    int toSlot;
+    uint8_t requiredAttributes; // PARK NEED, or the flags ATTRIBUTES sets
+    uint8_t preferredAttributes;// PARK PREFER
+
+    Command();
+};
+
+class CommandParser {
+private:
+    static bool nextToken(const char*& cursor, const char* end,
+                          const char*& token, size_t& tokenLength);
+    static bool parseInt(const char* token, size_t length, int& value);
+    static bool parseVersion(const char* token, size_t length, uint64_t& value);
+    static bool parseVehicleType(const char* token, size_t length, Vehicle::VehicleType& type);
+    static bool parseZoneRange(const char*& cursor, const char* end, Command& command);
+
+public:
+    // Parses one line in place (no copies, no heap).
+    // Returns false and sets type = UNKNOWN when the line is malformed.
+    static bool parse(const char* line, size_t length, Command& command);
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef CONSOLE_MUTE_H
+#define CONSOLE_MUTE_H
+
+#include <iostream>
+
+// Silences ParkingSystem's per-operation console messages for a scope.
+// It sets failbit on std::cout itself, so output from every thread is
+// dropped until the outermost mute goes out of scope.
+class ConsoleMute {
+private:
+    std::ios::iostate saved;
+
+    ConsoleMute(const ConsoleMute&);
+    ConsoleMute& operator=(const ConsoleMute&);
+
+public:
+    ConsoleMute() : saved(std::cout.rdstate()) { std::cout.setstate(std::ios::failbit); }
+    ~ConsoleMute() { std::cout.clear(saved); }
+};
+
+#endif
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ParkingSystem.h"
+#include "LatencyStats.h"
+#include "ConsoleMute.h"
+
+// Microbenchmark suite for every core operation.
+//
+//   CoreBenchmark [--max-slots N] [--budget-ms M] [--out FILE]
+//
+// Runs each operation on cities from 900 to 10M slots at 0%, 50%, 95%
+// and 99.9% occupancy and writes one JSON document (stdout by default)
+// so runs can be diffed. Background occupancy is spread uniformly over
+// the city, so near-full cases pay the full cost of the linear scans.
+// The lifecycle rows always need a few free slots, so where the target
+// leaves fewer than 16 the case frees that many background slots first.
+
+typedef std::chrono::steady_clock WallClock;
+
+struct BenchCity {
+    const char* label;
+    CityLayout layout;
+};
+
+static const BenchCity CITIES[] = {
+    { "900",   CityLayout(15, 3, 20) },
+    { "10K",   CityLayout(25, 4, 100) },
+    { "100K",  CityLayout(100, 10, 100) },
+    { "1M",    CityLayout(250, 20, 200) },
+    { "10M",   CityLayout(1000, 20, 500) },
+};
+
+static const double OCCUPANCY_LEVELS[] = { 0.0, 0.50, 0.95, 0.999 };
+
+struct BenchResult {
+    std::string city;
+    long long slots;
+    double occupancy;
+    std::string op;
+    LatencyStats stats;
+};
+
+static int64_t elapsedNanos(WallClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(WallClock::now() - start).count();
+}
+
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb3f97a4fe1bdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Marks a uniform pseudo-random share of slots occupied (no requests).
+static long long prefill(ParkingSystem& system, double occupancy) {
+    const uint64_t SCALE = 1000000;
+    uint64_t threshold = static_cast<uint64_t>(occupancy * SCALE);
+    long long filled = 0;
+
+    for (auto zone : system.getZones())
+        for (auto& area : zone->getParkingAreas())
+            for (auto& slot : area.getSlots())
+                if (mix(static_cast<uint64_t>(slot.getSlotId())) % SCALE < threshold) {
+                    slot.markOccupied();
+                    filled++;
+                }
+    return filled;
+}
+
+class Budget {
+private:
+    WallClock::time_point start;
+    int64_t limitNanos;
+    long long minIterations;
+    long long maxIterations;
+    long long done;
+
+public:
+    Budget(int64_t budgetMs, long long minIters, long long maxIters)
+        : start(WallClock::now()), limitNanos(budgetMs * 1000000LL),
+          minIterations(minIters), maxIterations(maxIters), done(0) {}
+
+    bool next() {
+        if (done >= maxIterations) return false;
+        if (done >= minIterations && elapsedNanos(start) > limitNanos) return false;
+        done++;
+        return true;
+    }
+};
+
+static void makePlate(char* buf, size_t size, long long n) {
+    std::snprintf(buf, size, "B%lld", n);
+}
+
+static void runCase(const BenchCity& city, double occupancy, int64_t budgetMs,
+                    std::deque<BenchResult>& results) {
+    ConsoleMute mute;
+    VirtualClock clock;
+    ParkingSystem system(city.layout, &clock);
+    const int zoneCount = city.layout.zoneCount;
+    const int areaCount = city.layout.areasPerZone;
+    long long slots = city.layout.getTotalSlots();
+
+    prefill(system, occupancy);
+
+    // results is a deque, so the references handed out here stay valid
+    auto add = [&](const char* op) -> LatencyStats& {
+        BenchResult r;
+        r.city = city.label;
+        r.slots = slots;
+        r.occupancy = occupancy;
+        r.op = op;
+        results.push_back(r);
+        return results.back().stats;
+    };
+
+    uint64_t seed = 12345;
+    auto randomZone = [&]() { seed = mix(seed + 1); return 1 + static_cast<int>(seed % zoneCount); };
+    auto randomArea = [&]() { seed = mix(seed + 1); return 1 + static_cast<int>(seed % areaCount); };
+
+    // -------- AllocationEngine (direct; cancel afterwards keeps occupancy fixed) --------
+    AllocationEngine engine(system.getZones(), system.getAttributeIndex());
+    {
+        LatencyStats& stats = add("AllocationEngine::allocateSlot");
+        Budget budget(budgetMs, 5, 20000);
+        int n = 0;
+        while (budget.next()) {
+            ParkingRequest request(n++, Vehicle("ENGINE", Vehicle::CAR, 1), randomZone(), 0);
+            int fee = 0;
+            bool crossZone = false;
+            auto t0 = WallClock::now();
+            bool ok = engine.allocateSlot(request, fee, crossZone);
+            stats.record(elapsedNanos(t0), ok);
+            request.cancel(system.findSlot(request.getAllocatedSlotId()));
+        }
+    }
+    {
+        LatencyStats& stats = add("AllocationEngine::allocateSlotWithArea");
+        Budget budget(budgetMs, 5, 20000);
+        int n = 0;
+        while (budget.next()) {
+            ParkingRequest request(n++, Vehicle("ENGINE", Vehicle::CAR, 1), randomZone(), 0);
+            int fee = 0;
+            bool crossZone = false;
+            int area = randomArea();
+            auto t0 = WallClock::now();
+            bool ok = engine.allocateSlotWithArea(request, area, fee, crossZone);
+            stats.record(elapsedNanos(t0), ok);
+            request.cancel(system.findSlot(request.getAllocatedSlotId()));
+        }
+    }
+    {
+        // Requested zone completely full: forces the cross-zone loop
+        Zone* hot = system.getZones().back();
+        std::vector<ParkingSlot*> freed;
+        for (auto& area : hot->getParkingAreas())
+            for (auto& slot : area.getSlots())
+                if (slot.isAvailable()) {
+                    slot.markOccupied();
+                    freed.push_back(&slot);
+                }
+
+        LatencyStats& stats = add("AllocationEngine::allocateSlot(crossZone)");
+        Budget budget(budgetMs, 5, 20000);
+        int n = 0;
+        while (budget.next()) {
+            ParkingRequest request(n++, Vehicle("ENGINE", Vehicle::CAR, 1), hot->getZoneId(), 0);
+            int fee = 0;
+            bool crossZone = false;
+            auto t0 = WallClock::now();
+            bool ok = engine.allocateSlot(request, fee, crossZone);
+            stats.record(elapsedNanos(t0), ok);
+            request.cancel(system.findSlot(request.getAllocatedSlotId()));
+        }
+
+        for (auto slot : freed)
+            slot->markFree();
+    }
+
+    // -------- ParkingSystem lifecycle in rounds of W fresh vehicles --------
+    long long freeSlots = 0;
+    for (auto zone : system.getZones())
+        freeSlots += zone->getFreeSlots();
+
+    // A small city near full has almost nothing free (900 slots at 99.9%
+    // leaves one); hand back background slots, one per zone per pass, so
+    // the lifecycle rows are still measured on a nearly full city
+    const long long MIN_WORKING = 8;
+    while (freeSlots < 2 * MIN_WORKING && freeSlots < slots) {
+        for (auto zone : system.getZones()) {
+            ParkingSlot* taken = nullptr;
+            for (auto& area : zone->getParkingAreas()) {
+                for (auto& slot : area.getSlots())
+                    if (!slot.isAvailable()) {
+                        taken = &slot;
+                        break;
+                    }
+                if (taken)
+                    break;
+            }
+            if (taken && freeSlots < 2 * MIN_WORKING) {
+                taken->markFree();
+                freeSlots++;
+            }
+        }
+    }
+
+    // Working set takes at most half the free slots so occupancy stays near target
+    long long working = std::min<long long>(std::min<long long>(1000, freeSlots / 2),
+                                            std::max<long long>(MIN_WORKING, slots / 100));
+
+    LatencyStats& park = add("ParkingSystem::createParkingRequest");
+    LatencyStats& parkArea = add("ParkingSystem::createParkingRequestWithArea");
+    LatencyStats& occupy = add("ParkingSystem::occupyParking");
+    LatencyStats& lookup = add("ParkingSystem::lookupRequest");
+    LatencyStats& release = add("ParkingSystem::releaseParking");
+    LatencyStats& cancel = add("ParkingSystem::cancelRequest");
+    LatencyStats& rollback = add("ParkingSystem::rollbackLast");
+    LatencyStats& status = add("zoneStatus");
+
+    long long plateCounter = 0;
+    char plate[24];
+    std::vector<VehiclePlate> batch;
+    auto roundStart = WallClock::now();
+    int rounds = 0;
+
+    while (rounds < 3 || (rounds < 50 && elapsedNanos(roundStart) < budgetMs * 3000000LL)) {
+        rounds++;
+
+        // PARK -> OCCUPY -> lookup -> RELEASE
+        batch.clear();
+        for (long long i = 0; i < working; i++) {
+            makePlate(plate, sizeof(plate), ++plateCounter);
+            batch.push_back(VehiclePlate(plate));
+            int fee;
+            bool crossZone;
+            auto t0 = WallClock::now();
+            bool ok = (i % 2 == 0)
+                ? system.createParkingRequest(batch.back(), Vehicle::CAR, randomZone(), fee, crossZone)
+                : system.createParkingRequestWithArea(batch.back(), Vehicle::CAR, randomZone(), randomArea(), fee, crossZone);
+            (i % 2 == 0 ? park : parkArea).record(elapsedNanos(t0), ok);
+        }
+        for (auto& p : batch) {
+            auto t0 = WallClock::now();
+            bool ok = system.occupyParking(p, Vehicle::CAR);
+            occupy.record(elapsedNanos(t0), ok);
+        }
+        for (auto& p : batch) {
+            auto t0 = WallClock::now();
+            bool ok = system.lookupRequest(p, Vehicle::CAR) != nullptr;
+            lookup.record(elapsedNanos(t0), ok);
+        }
+        for (auto& p : batch) {
+            auto t0 = WallClock::now();
+            bool ok = system.releaseParking(p, Vehicle::CAR);
+            release.record(elapsedNanos(t0), ok);
+        }
+
+        // PARK -> CANCEL
+        batch.clear();
+        for (long long i = 0; i < working; i++) {
+            makePlate(plate, sizeof(plate), ++plateCounter);
+            batch.push_back(VehiclePlate(plate));
+            int fee;
+            bool crossZone;
+            system.createParkingRequest(batch.back(), Vehicle::CAR, randomZone(), fee, crossZone);
+        }
+        for (auto& p : batch) {
+            auto t0 = WallClock::now();
+            bool ok = system.cancelRequest(p, Vehicle::CAR);
+            cancel.record(elapsedNanos(t0), ok);
+        }
+        // Undo the cancellations, then the allocations behind them; none of
+        // these requests moved on, so every undo must succeed or the row
+        // would time refusals
+        for (long long i = 0; i < 2 * working; i++) {
+            auto t0 = WallClock::now();
+            bool ok = system.rollbackLast(1);
+            rollback.record(elapsedNanos(t0), ok);
+            if (!ok) {
+                std::fprintf(stderr, "rollbackLast refused entry %lld of %lld (city %s)\n",
+                             i + 1, 2 * working, city.label);
+                std::exit(1);
+            }
+        }
+
+        // Zone status sweep (displayZoneStatus without printing)
+        auto t0 = WallClock::now();
+        double sink = 0;
+        for (auto zone : system.getZones())
+            sink += zone->getTotalSlots() + zone->getFreeSlots() + zone->getUtilizationRate();
+        status.record(elapsedNanos(t0), sink >= 0);
+    }
+}
+
+static void writeJson(FILE* out, const std::deque<BenchResult>& results) {
+    static const double PS[] = { 50.0, 90.0, 99.0, 99.9, 100.0 };
+
+    std::fprintf(out, "{\n  \"benchmark\": \"core\",\n  \"unit\": \"ns\",\n  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        int64_t p[5];
+        r.stats.percentiles(PS, 5, p);
+        std::fprintf(out,
+            "    {\"city\": \"%s\", \"slots\": %lld, \"occupancy\": %.3f, \"op\": \"%s\", "
+            "\"iterations\": %lld, \"failures\": %lld, \"mean\": %.1f, "
+            "\"p50\": %lld, \"p90\": %lld, \"p99\": %lld, \"p999\": %lld, \"max\": %lld}%s\n",
+            r.city.c_str(), r.slots, r.occupancy, r.op.c_str(),
+            r.stats.getCount(), r.stats.getFailures(), r.stats.getMeanNanos(),
+            (long long)p[0], (long long)p[1], (long long)p[2], (long long)p[3], (long long)p[4],
+            i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    long long maxSlots = 10000000;
+    int64_t budgetMs = 200;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--max-slots") == 0)      maxSlots = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--budget-ms") == 0) budgetMs = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--out") == 0)       outPath = argv[i + 1];
+    }
+
+    std::deque<BenchResult> results;
+    for (const auto& city : CITIES) {
+        if (city.layout.getTotalSlots() > maxSlots)
+            continue;
+        for (double occupancy : OCCUPANCY_LEVELS) {
+            std::fprintf(stderr, "city %s occupancy %.1f%%...\n", city.label, occupancy * 100);
+            runCase(city, occupancy, budgetMs, results);
+        }
+    }
+
+    FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", outPath);
+        return 1;
+    }
+    writeJson(out, results);
+    if (outPath) std::fclose(out);
+    return 0;
+}
@@ -28,71 +28,178 @@ cppProcess.on('close', (code) => {
 // For now, let's keep it simple: One-way trigger or valid response parsing?
 // The current C++ loop prints JSON. We need to capture that specific JSON for the response.
 
-let pendingResponse = null;
+// Responses come back in command order, so callers queue a handler per command.
+const pendingHandlers = [];
 
-// Improved C++ reader
+function sendCommand(cmd, handler) {
+    pendingHandlers.push(handler);
+    cppProcess.stdin.write(cmd);
+}
+
+function respondWith(res) {
+    return (json, error) => {
+        if (error) res.status(500).json({ error: "Backend Parse Error" });
+        else res.json(json);
+    };
+}
+
+// -------- Status cache (fed by SUBSCRIBE deltas) --------
+// The C++ side pushes only the slots that changed since the last version,
+// so /api/status is answered from memory instead of a full STATUS dump.
+const STATUS_INTERVAL_MS = 250;
+let statusCache = null;
+let statusVersion = 0;
+let slotsById = new Map();
+let resubscribing = false;
+const streamClients = new Set();
+
+function loadSnapshot(status, version) {
+    statusCache = status;
+    statusVersion = version;
+    slotsById = new Map();
+    for (const zone of status.zones)
+        for (const area of zone.areas)
+            for (const slot of area.slots)
+                slotsById.set(slot.id, slot);
+}
+
+function broadcast(message) {
+    for (const client of streamClients)
+        client.write(`data: ${JSON.stringify(message)}\n\n`);
+}
+
+// SUBSCRIBE answers with a full snapshot and restarts the deltas from it
+function subscribe() {
+    sendCommand(`SUBSCRIBE ${STATUS_INTERVAL_MS}\n`, (json) => {
+        if (!json || !json.status) return;
+        loadSnapshot(json.status, json.version);
+        if (resubscribing) {
+            resubscribing = false;
+            broadcast({ from: 0, to: json.version, resync: true, status: json.status });
+        }
+    });
+}
+
+// A slot or zone we have never seen means the city grew (ADDZONE) or our
+// copy is out of date; patching it would silently drop the new slots
+function coversDelta(delta) {
+    if (delta.slots.some((change) => !slotsById.has(change.id)))
+        return false;
+    return !(delta.zones || []).some((zone) => zone.id > statusCache.zones.length);
+}
+
+function applyDelta(delta) {
+    if (resubscribing) return;   // the coming snapshot already includes it
+    if (delta.resync) {
+        loadSnapshot(delta.status, delta.to);
+    } else if (!statusCache || !coversDelta(delta)) {
+        resubscribing = true;
+        subscribe();
+        return;
+    } else {
+        for (const change of delta.slots) {
+            const slot = slotsById.get(change.id);
+            if (slot) slot.isAvailable = change.isAvailable;
+        }
+        statusVersion = delta.to;
+    }
+    broadcast(delta);
+}
+
+function handleFrame(kind, jsonStr) {
+    let json;
+    try {
+        json = JSON.parse(jsonStr);
+    } catch (e) {
+        console.error("Failed to parse C++ JSON:", e);
+        if (kind === 'JSON') {
+            const handler = pendingHandlers.shift();
+            if (handler) handler(null, e);
+        }
+        return;
+    }
+
+    if (kind === 'PUSH') {
+        applyDelta(json);
+    } else {
+        const handler = pendingHandlers.shift();
+        if (handler) handler(json);
+    }
+}
+
+// Improved C++ reader: command responses are framed JSON_START/JSON_END,
+// subscription pushes PUSH_START/PUSH_END; a chunk may hold several frames.
 let buffer = '';
 cppProcess.stdout.on('data', (data) => {
     buffer += data.toString();
 
-    // Check for JSON delimiters
-    const startIdx = buffer.indexOf('JSON_START');
-    const endIdx = buffer.indexOf('JSON_END');
+    while (true) {
+        const jsonIdx = buffer.indexOf('JSON_START');
+        const pushIdx = buffer.indexOf('PUSH_START');
+        if (jsonIdx === -1 && pushIdx === -1) break;
+
+        const kind = (pushIdx !== -1 && (jsonIdx === -1 || pushIdx < jsonIdx)) ? 'PUSH' : 'JSON';
+        const startIdx = kind === 'PUSH' ? pushIdx : jsonIdx;
+        const endMarker = `${kind}_END`;
+        const endIdx = buffer.indexOf(endMarker, startIdx);
+        if (endIdx === -1) break;
 
-    if (startIdx !== -1 && endIdx !== -1) {
         const jsonStr = buffer.substring(startIdx + 10, endIdx).trim();
-        buffer = buffer.substring(endIdx + 8); // Remove processed part
-
-        try {
-            const json = JSON.parse(jsonStr);
-            if (pendingResponse) {
-                pendingResponse.json(json);
-                pendingResponse = null;
-            }
-        } catch (e) {
-            console.error("Failed to parse C++ JSON:", e);
-            if (pendingResponse) {
-                pendingResponse.status(500).json({ error: "Backend Parse Error" });
-                pendingResponse = null;
-            }
-        }
+        buffer = buffer.substring(endIdx + endMarker.length);
+        handleFrame(kind, jsonStr);
     }
 });
 
+subscribe();
+
 app.post('/api/park', (req, res) => {
     const { plate, type, zone, area } = req.body;
     // PARK <plate> <type> <zone> <area>
     // type: 1=Car, 2=Bike
     const cmd = `PARK ${plate} ${type} ${zone} ${area}\n`;
     console.log("Sending to C++:", cmd.trim());
-    cppProcess.stdin.write(cmd);
-    pendingResponse = res;
+    sendCommand(cmd, respondWith(res));
 });
 
 app.post('/api/occupy', (req, res) => {
     const { plate, type } = req.body;
     const cmd = `OCCUPY ${plate} ${type}\n`;
-    cppProcess.stdin.write(cmd);
-    pendingResponse = res;
+    sendCommand(cmd, respondWith(res));
 });
 
 app.post('/api/release', (req, res) => {
     const { plate, type } = req.body;
     const cmd = `RELEASE ${plate} ${type}\n`;
-    cppProcess.stdin.write(cmd);
-    pendingResponse = res;
+    sendCommand(cmd, respondWith(res));
 });
 
 app.get('/api/status', (req, res) => {
+    if (statusCache) {
+        res.json(statusCache);
+        return;
+    }
     const cmd = `STATUS\n`;
-    cppProcess.stdin.write(cmd);
-    pendingResponse = res;
+    sendCommand(cmd, respondWith(res));
+});
+
+// Pull form: { version, ...changes } since the caller's version
+app.get('/api/status/delta', (req, res) => {
+    const since = parseInt(req.query.since, 10) || 0;
+    sendCommand(`DELTA ${since}\n`, respondWith(res));
+});
+
+// Push form: Server-Sent Events, one message per coalesced delta
+app.get('/api/status/stream', (req, res) => {
+    res.set({ 'Content-Type': 'text/event-stream', 'Cache-Control': 'no-cache', Connection: 'keep-alive' });
+    res.flushHeaders();
+    res.write(`data: ${JSON.stringify({ version: statusVersion, status: statusCache })}\n\n`);
+    streamClients.add(res);
+    req.on('close', () => streamClients.delete(res));
 });
 
 app.get('/api/history', (req, res) => {
     const cmd = `HISTORY\n`;
-    cppProcess.stdin.write(cmd);
-    pendingResponse = res;
+    sendCommand(cmd, respondWith(res));
 });
 
 const PORT = 3001;
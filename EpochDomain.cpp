@@ -0,0 +1,59 @@
+#include "EpochDomain.h"
+#include <thread>
+
+// Spreads threads over the slots so uncontended readers claim first try
+static int preferredSlot() {
+    static std::atomic<int> nextThread(0);
+    thread_local int preferred = nextThread.fetch_add(1, std::memory_order_relaxed) % EpochDomain::MAX_READERS;
+    return preferred;
+}
+
+EpochDomain::EpochDomain() : globalEpoch(1) {
+    for (int i = 0; i < MAX_READERS; i++)
+        slots[i].epoch.store(0, std::memory_order_relaxed);
+}
+
+// -------- Readers --------
+int EpochDomain::enter() {
+    int start = preferredSlot();
+    for (;;) {
+        for (int n = 0; n < MAX_READERS; n++) {
+            int slot = (start + n) % MAX_READERS;
+            uint64_t epoch = globalEpoch.load();
+            uint64_t expected = 0;
+            if (!slots[slot].epoch.compare_exchange_strong(expected, epoch))
+                continue;
+
+            // The writer may have advanced between the load and the claim;
+            // re-announce until the announcement is current, so the writer
+            // can never miss this reader
+            uint64_t now = globalEpoch.load();
+            while (now != epoch) {
+                epoch = now;
+                slots[slot].epoch.store(epoch);
+                now = globalEpoch.load();
+            }
+            return slot;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void EpochDomain::exit(int slot) {
+    slots[slot].epoch.store(0, std::memory_order_release);
+}
+
+// -------- Writer --------
+uint64_t EpochDomain::advance() {
+    return globalEpoch.fetch_add(1);
+}
+
+uint64_t EpochDomain::oldestActive() const {
+    uint64_t oldest = NONE;
+    for (int i = 0; i < MAX_READERS; i++) {
+        uint64_t epoch = slots[i].epoch.load();
+        if (epoch != 0 && epoch < oldest)
+            oldest = epoch;
+    }
+    return oldest;
+}
@@ -0,0 +1,61 @@
+#ifndef EPOCH_DOMAIN_H
+#define EPOCH_DOMAIN_H
+
+#include <atomic>
+#include <cstdint>
+
+// Epoch-based reclamation for read-copy-update structures.
+//
+// Readers announce the global epoch in a reader slot for the length of a
+// read (EpochGuard) and never wait on anything. The writer unpublishes an
+// object, stamps it with advance() and frees it once oldestActive() has
+// moved past the stamp: every reader that could still hold it has left.
+//
+// Up to MAX_READERS reads can be in flight at once; a further reader
+// spins until a slot frees up.
+class EpochDomain {
+public:
+    static const int MAX_READERS = 64;
+    static const uint64_t NONE = ~0ULL;
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch;   // 0 = free
+    };
+
+    alignas(64) std::atomic<uint64_t> globalEpoch;
+    ReaderSlot slots[MAX_READERS];
+
+    EpochDomain(const EpochDomain&);
+    EpochDomain& operator=(const EpochDomain&);
+
+public:
+    EpochDomain();
+
+    // -------- Readers --------
+    int enter();             // returns the claimed slot
+    void exit(int slot);
+
+    // -------- Writer --------
+    // Call after unpublishing an object; the returned stamp goes with it
+    uint64_t advance();
+    // Smallest epoch announced by an active reader, or NONE. An object
+    // stamped s can be freed once this is greater than s.
+    uint64_t oldestActive() const;
+};
+
+// One read-side critical section
+class EpochGuard {
+private:
+    EpochDomain& domain;
+    int slot;
+
+    EpochGuard(const EpochGuard&);
+    EpochGuard& operator=(const EpochGuard&);
+
+public:
+    explicit EpochGuard(EpochDomain& d) : domain(d), slot(d.enter()) {}
+    ~EpochGuard() { domain.exit(slot); }
+};
+
+#endif
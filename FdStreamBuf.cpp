@@ -0,0 +1,53 @@
+#include "FdStreamBuf.h"
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+FdStreamBuf::FdStreamBuf(int descriptor) : fd(descriptor) {}
+
+int FdStreamBuf::getFd() const {
+    return fd;
+}
+
+std::streamsize FdStreamBuf::showmanyc() {
+    int pending = 0;
+    if (ioctl(fd, FIONREAD, &pending) != 0)
+        return 0;
+    return pending;
+}
+
+std::streamsize FdStreamBuf::xsgetn(char* out, std::streamsize count) {
+    for (;;) {
+        ssize_t got = ::read(fd, out, static_cast<size_t>(count));
+        if (got >= 0)
+            return got;
+        if (errno != EINTR)
+            return 0;
+    }
+}
+
+// No get area: single-character reads are not used by the frame reader
+FdStreamBuf::int_type FdStreamBuf::underflow() {
+    return traits_type::eof();
+}
+
+std::streamsize FdStreamBuf::xsputn(const char* data, std::streamsize count) {
+    std::streamsize written = 0;
+    while (written < count) {
+        ssize_t put = ::write(fd, data + written, static_cast<size_t>(count - written));
+        if (put < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        written += put;
+    }
+    return written;
+}
+
+FdStreamBuf::int_type FdStreamBuf::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    char byte = traits_type::to_char_type(c);
+    return xsputn(&byte, 1) == 1 ? c : traits_type::eof();
+}
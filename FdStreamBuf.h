@@ -0,0 +1,29 @@
+#ifndef FD_STREAM_BUF_H
+#define FD_STREAM_BUF_H
+
+#include <streambuf>
+
+// Unbuffered std::streambuf over a POSIX file descriptor (socket, pipe).
+//
+// Meant for BinaryFrameReader / BinaryFrameWriter, which do their own
+// buffering: sgetn() is one read(2) (it may return fewer bytes than
+// asked), sputn() writes everything, and in_avail() reports the bytes
+// the kernel already holds so a burst of frames is taken in one call.
+// The descriptor is not owned.
+class FdStreamBuf : public std::streambuf {
+private:
+    int fd;
+
+protected:
+    std::streamsize showmanyc() override;
+    std::streamsize xsgetn(char* out, std::streamsize count) override;
+    int_type underflow() override;
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+    int_type overflow(int_type c) override;
+
+public:
+    explicit FdStreamBuf(int fd);
+    int getFd() const;
+};
+
+#endif
@@ -0,0 +1,266 @@
+#include "FreeCapacityIndex.h"
+#include <queue>
+
+// -------- CapacityTree --------
+CapacityTree::CapacityTree(int n) : leafCount(0), size(1) {
+    assign(std::vector<int>(n, 0));
+}
+
+void CapacityTree::assign(const std::vector<int>& values) {
+    leafCount = static_cast<int>(values.size());
+    size = 1;
+    while (size < leafCount)
+        size <<= 1;
+
+    sums.assign(2 * size, 0);
+    maxes.assign(2 * size, 0);
+    for (int i = 0; i < leafCount; i++) {
+        sums[size + i] = values[i];
+        maxes[size + i] = values[i];
+    }
+    for (int node = size - 1; node >= 1; node--) {
+        sums[node] = sums[2 * node] + sums[2 * node + 1];
+        maxes[node] = maxes[2 * node] > maxes[2 * node + 1] ? maxes[2 * node] : maxes[2 * node + 1];
+    }
+}
+
+void CapacityTree::add(int leaf, int delta) {
+    if (leaf < 0 || leaf >= leafCount)
+        return;
+
+    int node = size + leaf;
+    sums[node] += delta;
+    maxes[node] += delta;
+    for (node >>= 1; node >= 1; node >>= 1) {
+        sums[node] = sums[2 * node] + sums[2 * node + 1];
+        maxes[node] = maxes[2 * node] > maxes[2 * node + 1] ? maxes[2 * node] : maxes[2 * node + 1];
+    }
+}
+
+// O(log n), or O(n) when the tree has to double (amortised O(log n))
+void CapacityTree::append(int value) {
+    if (leafCount < size) {
+        leafCount++;
+        add(leafCount - 1, value);
+        return;
+    }
+
+    std::vector<int> values(leafCount + 1);
+    for (int i = 0; i < leafCount; i++)
+        values[i] = maxes[size + i];
+    values[leafCount] = value;
+    assign(values);
+}
+
+int CapacityTree::getLeafCount() const {
+    return leafCount;
+}
+
+int CapacityTree::get(int leaf) const {
+    return (leaf >= 0 && leaf < leafCount) ? maxes[size + leaf] : 0;
+}
+
+long long CapacityTree::sum(int lo, int hi) const {
+    long long total = 0;
+    if (lo > hi)
+        return 0;
+    for (int l = lo + size, r = hi + size + 1; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) total += sums[l++];
+        if (r & 1) total += sums[--r];
+    }
+    return total;
+}
+
+int CapacityTree::max(int lo, int hi) const {
+    int best = 0;
+    if (lo > hi)
+        return 0;
+    for (int l = lo + size, r = hi + size + 1; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            if (maxes[l] > best) best = maxes[l];
+            l++;
+        }
+        if (r & 1) {
+            r--;
+            if (maxes[r] > best) best = maxes[r];
+        }
+    }
+    return best;
+}
+
+void CapacityTree::collectAtLeast(int node, int nodeLo, int nodeHi, int lo, int hi,
+                                  int minValue, std::vector<int>& leaves) const {
+    if (nodeHi < lo || nodeLo > hi || maxes[node] < minValue)
+        return;
+    if (nodeLo == nodeHi) {
+        leaves.push_back(nodeLo);
+        return;
+    }
+    int mid = (nodeLo + nodeHi) / 2;
+    collectAtLeast(2 * node, nodeLo, mid, lo, hi, minValue, leaves);
+    collectAtLeast(2 * node + 1, mid + 1, nodeHi, lo, hi, minValue, leaves);
+}
+
+void CapacityTree::atLeast(int lo, int hi, int minValue, std::vector<int>& leaves) const {
+    leaves.clear();
+    if (lo < 0) lo = 0;
+    if (hi >= leafCount) hi = leafCount - 1;
+    if (lo > hi)
+        return;
+    collectAtLeast(1, 0, size - 1, lo, hi, minValue, leaves);
+}
+
+void CapacityTree::topK(int lo, int hi, int k, std::vector<int>& leaves) const {
+    leaves.clear();
+    if (lo < 0) lo = 0;
+    if (hi >= leafCount) hi = leafCount - 1;
+    if (lo > hi || k <= 0)
+        return;
+
+    // A node only partly inside [lo, hi] is queued with its subtree max,
+    // an upper bound; leaves carry exact values, so pops come out in order.
+    struct Candidate {
+        int value;
+        int node;
+        int nodeLo;
+        int nodeHi;
+
+        bool operator<(const Candidate& other) const {
+            if (value != other.value)
+                return value < other.value;
+            return nodeLo > other.nodeLo;
+        }
+    };
+
+    std::priority_queue<Candidate> frontier;
+    Candidate root = { maxes[1], 1, 0, size - 1 };
+    frontier.push(root);
+
+    while (!frontier.empty() && static_cast<int>(leaves.size()) < k) {
+        Candidate c = frontier.top();
+        frontier.pop();
+
+        if (c.nodeLo == c.nodeHi) {
+            leaves.push_back(c.nodeLo);
+            continue;
+        }
+
+        int mid = (c.nodeLo + c.nodeHi) / 2;
+        Candidate left = { maxes[2 * c.node], 2 * c.node, c.nodeLo, mid };
+        Candidate right = { maxes[2 * c.node + 1], 2 * c.node + 1, mid + 1, c.nodeHi };
+        if (left.nodeHi >= lo && left.nodeLo <= hi)
+            frontier.push(left);
+        if (right.nodeHi >= lo && right.nodeLo <= hi)
+            frontier.push(right);
+    }
+}
+
+// -------- FreeCapacityIndex --------
+FreeCapacityIndex::FreeCapacityIndex(int zones, int areas, int slotsPerArea)
+    : zoneCount(zones), areasPerZone(areas) {
+    zoneTree.assign(std::vector<int>(zoneCount, areasPerZone * slotsPerArea));
+    areaTree.assign(std::vector<int>(zoneCount * areasPerZone, slotsPerArea));
+}
+
+int FreeCapacityIndex::addZone(int slotsPerArea) {
+    zoneTree.append(areasPerZone * slotsPerArea);
+    for (int a = 0; a < areasPerZone; a++)
+        areaTree.append(slotsPerArea);
+    return ++zoneCount;
+}
+
+void FreeCapacityIndex::recordSlotChange(int zoneId, int areaId, bool nowAvailable) {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 1 || areaId > areasPerZone)
+        return;
+
+    int delta = nowAvailable ? 1 : -1;
+    zoneTree.add(zoneId - 1, delta);
+    areaTree.add((zoneId - 1) * areasPerZone + areaId - 1, delta);
+}
+
+void FreeCapacityIndex::correct(int zoneId, int areaId, int freeSlots) {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 0 || areaId > areasPerZone)
+        return;
+
+    if (areaId == 0) {
+        zoneTree.add(zoneId - 1, freeSlots - zoneTree.get(zoneId - 1));
+    } else {
+        int leaf = (zoneId - 1) * areasPerZone + areaId - 1;
+        areaTree.add(leaf, freeSlots - areaTree.get(leaf));
+    }
+}
+
+bool FreeCapacityIndex::clampZones(int& fromZone, int& toZone) const {
+    if (fromZone < 1) fromZone = 1;
+    if (toZone < 1 || toZone > zoneCount) toZone = zoneCount;
+    return fromZone <= toZone;
+}
+
+void FreeCapacityIndex::toEntries(const std::vector<int>& leaves, bool areas,
+                                  std::vector<CapacityEntry>& out) const {
+    out.clear();
+    out.reserve(leaves.size());
+    for (int leaf : leaves) {
+        CapacityEntry entry;
+        if (areas) {
+            entry.zoneId = leaf / areasPerZone + 1;
+            entry.areaId = leaf % areasPerZone + 1;
+            entry.freeSlots = areaTree.get(leaf);
+        } else {
+            entry.zoneId = leaf + 1;
+            entry.areaId = 0;
+            entry.freeSlots = zoneTree.get(leaf);
+        }
+        out.push_back(entry);
+    }
+}
+
+int FreeCapacityIndex::getZoneFree(int zoneId) const {
+    return zoneTree.get(zoneId - 1);
+}
+
+int FreeCapacityIndex::getAreaFree(int zoneId, int areaId) const {
+    if (areaId < 1 || areaId > areasPerZone)
+        return 0;
+    return areaTree.get((zoneId - 1) * areasPerZone + areaId - 1);
+}
+
+long long FreeCapacityIndex::sumFree(int fromZone, int toZone) const {
+    if (!clampZones(fromZone, toZone))
+        return 0;
+    return zoneTree.sum(fromZone - 1, toZone - 1);
+}
+
+void FreeCapacityIndex::zonesWithAtLeast(int minFree, int fromZone, int toZone,
+                                         std::vector<CapacityEntry>& out) const {
+    std::vector<int> leaves;
+    if (clampZones(fromZone, toZone))
+        zoneTree.atLeast(fromZone - 1, toZone - 1, minFree, leaves);
+    toEntries(leaves, false, out);
+}
+
+void FreeCapacityIndex::topZones(int k, int fromZone, int toZone,
+                                 std::vector<CapacityEntry>& out) const {
+    std::vector<int> leaves;
+    if (clampZones(fromZone, toZone))
+        zoneTree.topK(fromZone - 1, toZone - 1, k, leaves);
+    toEntries(leaves, false, out);
+}
+
+void FreeCapacityIndex::areasWithAtLeast(int zoneId, int minFree, std::vector<CapacityEntry>& out) const {
+    std::vector<int> leaves;
+    if (zoneId >= 1 && zoneId <= zoneCount) {
+        int first = (zoneId - 1) * areasPerZone;
+        areaTree.atLeast(first, first + areasPerZone - 1, minFree, leaves);
+    }
+    toEntries(leaves, true, out);
+}
+
+void FreeCapacityIndex::topAreas(int zoneId, int k, std::vector<CapacityEntry>& out) const {
+    std::vector<int> leaves;
+    if (zoneId >= 1 && zoneId <= zoneCount) {
+        int first = (zoneId - 1) * areasPerZone;
+        areaTree.topK(first, first + areasPerZone - 1, k, leaves);
+    }
+    toEntries(leaves, true, out);
+}
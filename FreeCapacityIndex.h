@@ -0,0 +1,89 @@
+#ifndef FREE_CAPACITY_INDEX_H
+#define FREE_CAPACITY_INDEX_H
+
+#include <vector>
+
+// Free-slot count for one zone or area, as returned by range queries
+struct CapacityEntry {
+    int zoneId;
+    int areaId;   // 0 for zone-level entries
+    int freeSlots;
+};
+
+// -------- Segment tree (sum + max) over non-negative counts --------
+// Leaves are indexed from 0; every range is inclusive.
+class CapacityTree {
+private:
+    int leafCount;
+    int size;                     // leaves rounded up to a power of two
+    std::vector<long long> sums;
+    std::vector<int> maxes;
+
+    void collectAtLeast(int node, int nodeLo, int nodeHi, int lo, int hi,
+                        int minValue, std::vector<int>& leaves) const;
+
+public:
+    explicit CapacityTree(int leafCount = 0);
+
+    void assign(const std::vector<int>& values);   // O(n)
+    void add(int leaf, int delta);                 // O(log n)
+    void append(int value);                        // amortised O(log n)
+
+    int getLeafCount() const;
+    int get(int leaf) const;
+    long long sum(int lo, int hi) const;           // O(log n)
+    int max(int lo, int hi) const;                 // O(log n)
+
+    // Leaves in [lo, hi] whose value is >= minValue, in index order.
+    // O((k + 1) log n) for k results: subtrees whose max is too small
+    // are never entered.
+    void atLeast(int lo, int hi, int minValue, std::vector<int>& leaves) const;
+
+    // Up to k leaves in [lo, hi] with the largest values, largest first
+    // (ties by lower index). Best-first walk: O((k + log n) log n).
+    void topK(int lo, int hi, int k, std::vector<int>& leaves) const;
+};
+
+// -------- Zone / area free-capacity index --------
+// Kept in step with every slot transition by ParkingSystem, so routing
+// queries never rescan slots.
+class FreeCapacityIndex {
+private:
+    int zoneCount;
+    int areasPerZone;
+    CapacityTree zoneTree;   // leaf = zoneId - 1
+    CapacityTree areaTree;   // leaf = (zoneId - 1) * areasPerZone + areaId - 1
+
+    bool clampZones(int& fromZone, int& toZone) const;
+    void toEntries(const std::vector<int>& leaves, bool areas, std::vector<CapacityEntry>& out) const;
+
+public:
+    FreeCapacityIndex(int zoneCount, int areasPerZone, int slotsPerArea);
+
+    // Every slot entering or leaving the free pool: allocation, release,
+    // and closing/reopening a free slot
+    void recordSlotChange(int zoneId, int areaId, bool nowAvailable);
+
+    // Overwrites one counter (areaId 0 = the zone total) and nothing
+    // else; CityAudit's repair for a count that drifted from the slots
+    void correct(int zoneId, int areaId, int freeSlots);
+
+    // Appends zone zoneCount + 1 with every slot free; returns its id
+    int addZone(int slotsPerArea);
+
+    // -------- Point queries, O(1) --------
+    int getZoneFree(int zoneId) const;
+    int getAreaFree(int zoneId, int areaId) const;
+
+    // -------- Zone range queries --------
+    // fromZone..toZone inclusive, clamped to the city; toZone <= 0 means the last zone
+    long long sumFree(int fromZone, int toZone) const;
+    void zonesWithAtLeast(int minFree, int fromZone, int toZone, std::vector<CapacityEntry>& out) const;
+    void topZones(int k, int fromZone, int toZone, std::vector<CapacityEntry>& out) const;
+
+    // -------- Area queries within one zone --------
+    void areasWithAtLeast(int zoneId, int minFree, std::vector<CapacityEntry>& out) const;
+    void topAreas(int zoneId, int k, std::vector<CapacityEntry>& out) const;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ParkingSystem.h"
+#include "IngestEngine.h"
+#include "ConsoleMute.h"
+
+// Gate-event ingestion: producers calling the system under a mutex vs
+// producers feeding one engine thread through IngestEngine.
+//
+//   IngestBenchmark [--producers N] [--ops N] [--batch N] [--capacity N] [--depth H]
+//
+// Every producer runs PARK/OCCUPY/RELEASE cycles on its own plates (--ops
+// commands in total per producer). Snapshots are enabled with history
+// depth H (default 100) in both runs, so the engine's once-per-batch
+// publishing shows up. A last run uses the REJECT policy with a tiny ring
+// to show how many submits are turned away.
+
+typedef std::chrono::steady_clock WallClock;
+
+static IngestCommand commandFor(int producer, int i, int zones) {
+    char plate[16];
+    std::snprintf(plate, sizeof(plate), "G%02d%06d", producer, (i / 3) % 100000);
+    switch (i % 3) {
+        case 0: return IngestCommand::park(plate, Vehicle::CAR, 1 + (i / 3 + producer) % zones);
+        case 1: return IngestCommand::occupy(plate, Vehicle::CAR);
+        default: return IngestCommand::release(plate, Vehicle::CAR);
+    }
+}
+
+static double runDirect(int producers, int ops, int depth, unsigned long long& succeeded) {
+    ConsoleMute mute;
+    ParkingSystem system;
+    system.enableSnapshots(depth);
+    int zones = system.getLayout().zoneCount;
+    std::mutex lock;
+    std::atomic<unsigned long long> ok(0);
+
+    auto start = WallClock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            unsigned long long mine = 0;
+            for (int i = 0; i < ops; i++) {
+                IngestCommand command = commandFor(p, i, zones);
+                int fee = 0;
+                bool crossZone = false;
+                bool done;
+                std::lock_guard<std::mutex> guard(lock);
+                if (command.type == IngestCommand::PARK)
+                    done = system.createParkingRequest(command.plate, command.vehicleType, command.zoneId, fee, crossZone);
+                else if (command.type == IngestCommand::OCCUPY)
+                    done = system.occupyParking(command.plate, command.vehicleType);
+                else
+                    done = system.releaseParking(command.plate, command.vehicleType);
+                if (done) mine++;
+            }
+            ok += mine;
+        });
+    }
+    for (auto& t : threads) t.join();
+    succeeded = ok;
+    return std::chrono::duration<double>(WallClock::now() - start).count();
+}
+
+static void countResult(const IngestResult& result, void* context) {
+    if (result.ok)
+        static_cast<std::atomic<unsigned long long>*>(context)->fetch_add(1, std::memory_order_relaxed);
+}
+
+static double runEngine(int producers, int ops, int depth, const IngestConfig& config,
+                        unsigned long long& succeeded, IngestStats& stats) {
+    ConsoleMute mute;
+    ParkingSystem system;
+    system.enableSnapshots(depth);
+    int zones = system.getLayout().zoneCount;
+    std::atomic<unsigned long long> ok(0);
+
+    IngestEngine engine(system, config);
+    engine.start();
+
+    auto start = WallClock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < ops; i++)
+                engine.submit(commandFor(p, i, zones), countResult, &ok);
+        });
+    }
+    for (auto& t : threads) t.join();
+    engine.stop();
+    double seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+
+    succeeded = ok;
+    stats = engine.getStats();
+    return seconds;
+}
+
+static void printEngine(const char* label, unsigned long long total, double seconds,
+                        unsigned long long succeeded, const IngestStats& stats) {
+    std::printf("%-18s %10.0f cmd/s   ok %llu/%llu\n", label, total / seconds, succeeded, total);
+    std::printf("%-18s submitted %llu  rejected %llu  batches %llu  avg batch %.1f  max depth %zu\n", "",
+                static_cast<unsigned long long>(stats.submitted), static_cast<unsigned long long>(stats.rejected),
+                static_cast<unsigned long long>(stats.batches), stats.getAverageBatch(), stats.maxDepth);
+    std::printf("%-18s queue latency p50 %.1f us  p99 %.1f us  max %.1f us\n", "",
+                stats.queueLatency.percentile(0.50) / 1000.0, stats.queueLatency.percentile(0.99) / 1000.0,
+                stats.queueLatency.getMax() / 1000.0);
+}
+
+int main(int argc, char* argv[]) {
+    int producers = 4;
+    int ops = 300000;
+    int depth = 100;
+    IngestConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) producers = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) ops = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) config.batchSize = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--capacity") == 0 && i + 1 < argc) config.capacity = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else {
+            std::cerr << "usage: IngestBenchmark [--producers N] [--ops N] [--batch N] [--capacity N] [--depth H]\n";
+            return 1;
+        }
+    }
+    if (producers < 1) producers = 1;
+    ops -= ops % 3;
+
+    unsigned long long total = static_cast<unsigned long long>(producers) * ops;
+    std::printf("%d producers x %d commands, ring %zu, batch %d, history depth %d\n\n",
+                producers, ops, config.capacity, config.batchSize, depth);
+
+    unsigned long long succeeded = 0;
+    double seconds = runDirect(producers, ops, depth, succeeded);
+    std::printf("%-18s %10.0f cmd/s   ok %llu/%llu\n", "direct (mutex)", total / seconds, succeeded, total);
+
+    IngestStats stats;
+    seconds = runEngine(producers, ops, depth, config, succeeded, stats);
+    printEngine("engine (block)", total, seconds, succeeded, stats);
+
+    IngestConfig reject = config;
+    reject.backpressure = IngestConfig::REJECT;
+    reject.capacity = 64;
+    seconds = runEngine(producers, ops, depth, reject, succeeded, stats);
+    printEngine("engine (reject/64)", total, seconds, succeeded, stats);
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include "IngestEngine.h"
+#include "ParkingSystem.h"
+#include <chrono>
+
+static int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------- Commands --------
+IngestCommand::IngestCommand()
+    : type(PARK), vehicleType(Vehicle::CAR), zoneId(0), areaId(0), count(0) {}
+
+IngestCommand IngestCommand::park(const VehiclePlate& plate, Vehicle::VehicleType type, int zoneId, int areaId) {
+    IngestCommand command;
+    command.type = PARK;
+    command.plate = plate;
+    command.vehicleType = type;
+    command.zoneId = zoneId;
+    command.areaId = areaId;
+    return command;
+}
+
+IngestCommand IngestCommand::occupy(const VehiclePlate& plate, Vehicle::VehicleType type) {
+    IngestCommand command;
+    command.type = OCCUPY;
+    command.plate = plate;
+    command.vehicleType = type;
+    return command;
+}
+
+IngestCommand IngestCommand::release(const VehiclePlate& plate, Vehicle::VehicleType type) {
+    IngestCommand command;
+    command.type = RELEASE;
+    command.plate = plate;
+    command.vehicleType = type;
+    return command;
+}
+
+IngestCommand IngestCommand::cancel(const VehiclePlate& plate, Vehicle::VehicleType type) {
+    IngestCommand command;
+    command.type = CANCEL;
+    command.plate = plate;
+    command.vehicleType = type;
+    return command;
+}
+
+IngestCommand IngestCommand::rollback(int count) {
+    IngestCommand command;
+    command.type = ROLLBACK;
+    command.count = count;
+    return command;
+}
+
+IngestResult::IngestResult()
+    : status(DONE), ok(false), fee(0), crossZone(false), slotId(-1), zoneId(-1), areaId(-1),
+      charge(0), queuedNanos(0) {}
+
+IngestStats::IngestStats()
+    : submitted(0), rejected(0), processed(0), batches(0), depth(0), maxDepth(0) {}
+
+double IngestStats::getAverageBatch() const {
+    return batches ? static_cast<double>(processed) / batches : 0.0;
+}
+
+// -------- Lifecycle --------
+static size_t roundUpPowerOfTwo(size_t value) {
+    size_t power = 2;
+    while (power < value)
+        power <<= 1;
+    return power;
+}
+
+IngestEngine::IngestEngine(ParkingSystem& s, const IngestConfig& c)
+    : system(s), config(c), ring(roundUpPowerOfTwo(c.capacity)),
+      tail(0), head(0), stopping(false), producers(0), sleeping(false), submitted(0), rejected(0) {
+    mask = ring.size() - 1;
+    for (size_t i = 0; i < ring.size(); i++)
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    if (config.batchSize <= 0)
+        config.batchSize = 1;
+}
+
+IngestEngine::~IngestEngine() {
+    stop();
+}
+
+void IngestEngine::start() {
+    if (engine.joinable())
+        return;
+    stopping.store(false);
+    engine = std::thread(&IngestEngine::run, this);
+}
+
+void IngestEngine::stop() {
+    if (!engine.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(sleepGuard);
+        stopping.store(true);
+    }
+    wake.notify_one();
+    engine.join();
+}
+
+// -------- Producers --------
+bool IngestEngine::tryEnqueue(const IngestCommand& command, IngestCallback callback, void* context) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &ring[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        } else if (difference < 0) {
+            return false;   // full
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->command = command;
+    cell->callback = callback;
+    cell->context = context;
+    cell->enqueuedNanos = steadyNanos();
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    // Pairs with the fence in run(): either the engine sees this command
+    // before sleeping, or we see it asleep and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(sleepGuard);
+        wake.notify_one();
+    }
+    return true;
+}
+
+bool IngestEngine::submit(const IngestCommand& command, IngestCallback callback, void* context) {
+    // Announce the submit before checking stopping: the engine exits only
+    // once no producer is in flight, so a command that passes the check
+    // is always drained
+    producers.fetch_add(1);
+    bool queued = submitCounted(command, callback, context);
+    producers.fetch_sub(1);
+    return queued;
+}
+
+bool IngestEngine::submitCounted(const IngestCommand& command, IngestCallback callback, void* context) {
+    if (stopping.load()) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!tryEnqueue(command, callback, context)) {
+        bool queued = false;
+        if (config.backpressure == IngestConfig::BLOCK) {
+            int64_t deadline = config.blockTimeoutMicros > 0 ? steadyNanos() + config.blockTimeoutMicros * 1000 : 0;
+            while (!stopping.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+                if (tryEnqueue(command, callback, context)) {
+                    queued = true;
+                    break;
+                }
+                if (deadline && steadyNanos() > deadline)
+                    break;
+            }
+        }
+        if (!queued) {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+static void resolvePromise(const IngestResult& result, void* context) {
+    std::promise<IngestResult>* promise = static_cast<std::promise<IngestResult>*>(context);
+    promise->set_value(result);
+    delete promise;
+}
+
+std::future<IngestResult> IngestEngine::submitAsync(const IngestCommand& command) {
+    std::promise<IngestResult>* promise = new std::promise<IngestResult>();
+    std::future<IngestResult> future = promise->get_future();
+    if (!submit(command, resolvePromise, promise)) {
+        IngestResult result;
+        result.status = IngestResult::REJECTED;
+        resolvePromise(result, promise);
+    }
+    return future;
+}
+
+// -------- Engine Thread --------
+void IngestEngine::apply(Cell& cell, IngestResult& result) {
+    const IngestCommand& command = cell.command;
+    const ParkingRequest* req;
+
+    switch (command.type) {
+        case IngestCommand::PARK:
+            if (command.areaId == 0)
+                result.ok = system.createParkingRequest(command.plate, command.vehicleType, command.zoneId,
+                                                        result.fee, result.crossZone);
+            else
+                result.ok = system.createParkingRequestWithArea(command.plate, command.vehicleType, command.zoneId,
+                                                                command.areaId, result.fee, result.crossZone);
+            if (result.ok && (req = system.lookupRequest(command.plate, command.vehicleType))) {
+                result.slotId = req->getAllocatedSlotId();
+                result.zoneId = req->getAllocatedZoneId();
+                result.areaId = req->getAllocatedAreaId();
+            }
+            break;
+        case IngestCommand::OCCUPY:
+            result.ok = system.occupyParking(command.plate, command.vehicleType);
+            break;
+        case IngestCommand::RELEASE:
+            result.ok = system.releaseParking(command.plate, command.vehicleType);
+            if (result.ok && (req = system.lookupRequest(command.plate, command.vehicleType)))
+                result.charge = req->getCharge();
+            break;
+        case IngestCommand::CANCEL:
+            result.ok = system.cancelRequest(command.plate, command.vehicleType);
+            break;
+        case IngestCommand::ROLLBACK:
+            result.ok = system.rollbackLast(command.count);
+            break;
+    }
+}
+
+// A finished command whose callback waits for the batch to be published
+struct IngestCompletion {
+    IngestCallback callback;
+    void* context;
+    IngestResult result;
+};
+
+void IngestEngine::run() {
+    std::vector<int64_t> waits;
+    std::vector<IngestCompletion> completions;
+    waits.reserve(config.batchSize);
+    completions.reserve(config.batchSize);
+
+    for (;;) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Cell* first = &ring[position & mask];
+        if (first->sequence.load(std::memory_order_acquire) != position + 1) {
+            // Empty: sleep until a producer signals (bounded, as a safety net)
+            std::unique_lock<std::mutex> lock(sleepGuard);
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (first->sequence.load(std::memory_order_acquire) != position + 1) {
+                // Exit only when no submit is in flight and every claimed
+                // cell has been applied; a claimed but unpublished cell
+                // shows as tail ahead of head
+                if (stopping.load() && producers.load() == 0 && tail.load() == position)
+                    break;
+                wake.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        size_t depth = tail.load(std::memory_order_relaxed) - position;
+        waits.clear();
+        completions.clear();
+
+        system.beginBatch();
+        int taken = 0;
+        while (taken < config.batchSize) {
+            Cell& cell = ring[position & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+                break;
+
+            IngestResult result;
+            result.queuedNanos = steadyNanos() - cell.enqueuedNanos;
+            waits.push_back(result.queuedNanos);
+            apply(cell, result);
+            if (cell.callback) {
+                IngestCompletion completion = { cell.callback, cell.context, result };
+                completions.push_back(completion);
+            }
+
+            cell.sequence.store(position + ring.size(), std::memory_order_release);
+            position++;
+            taken++;
+        }
+        head.store(position, std::memory_order_relaxed);
+        system.endBatch();
+
+        // Only now are the status region and the snapshot current, so a
+        // caller reacting to its result reads a city that includes it
+        for (const IngestCompletion& completion : completions)
+            completion.callback(completion.result, completion.context);
+
+        std::lock_guard<std::mutex> lock(statsGuard);
+        stats.processed += taken;
+        stats.batches++;
+        if (depth > stats.maxDepth)
+            stats.maxDepth = depth;
+        for (int64_t wait : waits)
+            stats.queueLatency.record(wait > 0 ? static_cast<uint64_t>(wait) : 0);
+    }
+}
+
+// -------- Metrics --------
+IngestStats IngestEngine::getStats() const {
+    IngestStats result;
+    {
+        std::lock_guard<std::mutex> lock(statsGuard);
+        result = stats;
+    }
+    result.submitted = submitted.load(std::memory_order_relaxed);
+    result.rejected = rejected.load(std::memory_order_relaxed);
+    result.depth = tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+    return result;
+}
@@ -0,0 +1,160 @@
+#ifndef INGEST_ENGINE_H
+#define INGEST_ENGINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Metrics.h"
+#include "Vehicle.h"
+#include "VehiclePlate.h"
+
+class ParkingSystem;
+
+// One gate/sensor event for the engine thread
+struct IngestCommand {
+    enum Type { PARK, OCCUPY, RELEASE, CANCEL, ROLLBACK };
+
+    Type type;
+    VehiclePlate plate;
+    Vehicle::VehicleType vehicleType;
+    int zoneId;
+    int areaId;              // PARK: 0 = any area
+    int count;               // ROLLBACK
+
+    IngestCommand();
+    static IngestCommand park(const VehiclePlate& plate, Vehicle::VehicleType type, int zoneId, int areaId = 0);
+    static IngestCommand occupy(const VehiclePlate& plate, Vehicle::VehicleType type);
+    static IngestCommand release(const VehiclePlate& plate, Vehicle::VehicleType type);
+    static IngestCommand cancel(const VehiclePlate& plate, Vehicle::VehicleType type);
+    static IngestCommand rollback(int count);
+};
+
+struct IngestResult {
+    enum Status { DONE, REJECTED };    // REJECTED: queue full or engine stopped
+
+    Status status;
+    bool ok;                 // operation outcome when DONE
+    int fee;                 // PARK
+    bool crossZone;          // PARK
+    int slotId;              // PARK
+    int zoneId;
+    int areaId;
+    int64_t charge;          // RELEASE, paisa
+    int64_t queuedNanos;     // time spent waiting in the queue
+
+    IngestResult();
+};
+
+// Runs on the engine thread once the command's batch is published; keep it short
+typedef void (*IngestCallback)(const IngestResult& result, void* context);
+
+struct IngestConfig {
+    enum Backpressure {
+        BLOCK,               // wait for space (up to blockTimeoutMicros, 0 = forever);
+                             // never from AsyncExecutor workers, which must not stall
+        REJECT               // fail the submit immediately
+    };
+
+    size_t capacity;         // rounded up to a power of two
+    int batchSize;           // most commands applied per batch
+    Backpressure backpressure;
+    int64_t blockTimeoutMicros;
+
+    IngestConfig() : capacity(4096), batchSize(256), backpressure(BLOCK), blockTimeoutMicros(0) {}
+};
+
+// Queue and engine counters; latency is enqueue -> start of processing
+struct IngestStats {
+    uint64_t submitted;
+    uint64_t rejected;
+    uint64_t processed;
+    uint64_t batches;
+    size_t depth;            // commands waiting right now
+    size_t maxDepth;         // highest depth seen by the engine
+    LatencyHistogram queueLatency;   // nanoseconds
+
+    IngestStats();
+    double getAverageBatch() const;
+};
+
+// Bounded multi-producer / single-consumer ring in front of ParkingSystem.
+//
+// Producers on any thread submit() typed commands with a callback or get a
+// future; they never touch the system. A dedicated engine thread drains up
+// to batchSize commands at a time and applies them inside one
+// ParkingSystem batch, so the shared status region and the RCU snapshot
+// are published once per batch instead of once per operation.
+//
+// The ring is the classic per-cell-sequence design: producers claim a
+// cell with one CAS on the tail, the consumer needs no atomics beyond
+// the cell sequence. The engine sleeps on a condition variable only when
+// the ring is empty, and producers signal it only then.
+//
+// stop() lets every submit() already past the stopping check finish and
+// drains the ring until head meets tail, so an accepted command always
+// gets its callback.
+//
+// While the engine runs, every mutation of the system must go through
+// it; readers use CitySnapshotView or the shared status region.
+class IngestEngine {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        IngestCommand command;
+        IngestCallback callback;
+        void* context;
+        int64_t enqueuedNanos;
+    };
+
+    ParkingSystem& system;
+    IngestConfig config;
+    std::vector<Cell> ring;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> tail;        // next cell producers claim
+    alignas(64) std::atomic<size_t> head;        // next cell the engine reads (written by the engine only)
+
+    std::atomic<bool> stopping;
+    std::atomic<int> producers;                  // submit() calls in flight
+    std::atomic<bool> sleeping;
+    std::mutex sleepGuard;
+    std::condition_variable wake;
+    std::thread engine;
+
+    std::atomic<uint64_t> submitted;
+    std::atomic<uint64_t> rejected;
+
+    mutable std::mutex statsGuard;
+    IngestStats stats;                           // engine-side counters, under statsGuard
+
+    bool tryEnqueue(const IngestCommand& command, IngestCallback callback, void* context);
+    bool submitCounted(const IngestCommand& command, IngestCallback callback, void* context);
+    void run();
+    void apply(Cell& cell, IngestResult& result);
+
+    IngestEngine(const IngestEngine&);
+    IngestEngine& operator=(const IngestEngine&);
+
+public:
+    IngestEngine(ParkingSystem& system, const IngestConfig& config = IngestConfig());
+    ~IngestEngine();   // stops after draining what is queued
+
+    void start();
+    void stop();
+
+    // False when rejected (queue full under REJECT or timeout, or stopped);
+    // the callback is then not called
+    bool submit(const IngestCommand& command, IngestCallback callback = nullptr, void* context = nullptr);
+
+    // Future flavour; a rejection resolves it immediately with status REJECTED
+    std::future<IngestResult> submitAsync(const IngestCommand& command);
+
+    IngestStats getStats() const;
+};
+
+#endif
@@ -0,0 +1,231 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include "ParkingSystem.h"
+#include "JsonWriter.h"
+#include "ResponseJson.h"
+#include "ConsoleMute.h"
+
+// Serialisation benchmark for the STATUS and HISTORY responses.
+//
+//   JsonBenchmark [--rounds N]
+//
+// Builds each document repeatedly with the previous std::string +
+// to_string code and with JsonWriter, and reports time and heap
+// allocations per document. STATUS must come out byte-identical.
+
+static unsigned long long g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+typedef std::chrono::steady_clock WallClock;
+
+// -------- Previous serialisers (string concatenation) --------
+static void appendJsonString(std::string& out, const char* text, size_t length) {
+    out += '"';
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+static void legacyStatus(std::string& json, const ParkingSystem& system) {
+    json += "{\"zones\":[";
+    bool firstZone = true;
+    for (auto zone : system.getZones()) {
+        if (!firstZone) json += ',';
+        firstZone = false;
+
+        json += "{\"id\":" + std::to_string(zone->getZoneId()) + ",\"name\":";
+        std::string zoneName = zone->getZoneName();
+        appendJsonString(json, zoneName.c_str(), zoneName.size());
+        json += ",\"areas\":[";
+
+        bool firstArea = true;
+        for (const auto& area : zone->getParkingAreas()) {
+            if (!firstArea) json += ',';
+            firstArea = false;
+
+            json += "{\"id\":" + std::to_string(area.getAreaId()) + ",\"name\":";
+            std::string areaName = area.getAreaName();
+            appendJsonString(json, areaName.c_str(), areaName.size());
+            json += ",\"slots\":[";
+
+            bool firstSlot = true;
+            for (const auto& slot : area.getSlots()) {
+                if (!firstSlot) json += ',';
+                firstSlot = false;
+                json += "{\"id\":" + std::to_string(slot.getSlotId()) + ",\"isAvailable\":";
+                json += slot.isAvailable() ? "true" : "false";
+                json += "}";
+            }
+            json += "]}";
+        }
+        json += "]}";
+    }
+    json += "]}";
+}
+
+static void legacyHistory(std::string& json, const ParkingSystem& system, int count) {
+    const std::deque<ParkingRequest>& requests = system.getRequests();
+    json = "{\"history\":[";
+
+    int shown = 0;
+    for (int i = static_cast<int>(requests.size()) - 1; i >= 0 && shown < count; i--, shown++) {
+        const ParkingRequest* req = &requests[i];
+        if (shown > 0) json += ',';
+
+        json += "{\"id\":" + std::to_string(req->getRequestId()) + ",\"vehicle\":";
+        appendJsonString(json, req->getVehicleNumber().c_str(), req->getVehicleNumber().size());
+        json += ",\"type\":\"" + Vehicle::vehicleTypeToString(req->getVehicleType()) + "\"";
+        json += ",\"status\":\"" + req->getStateAsString() + "\"";
+        json += ",\"zone\":" + std::to_string(req->getAllocatedZoneId());
+        json += ",\"area\":" + std::to_string(req->getAllocatedAreaId());
+        json += ",\"slot\":" + std::to_string(req->getAllocatedSlotId());
+        json += ",\"requestTime\":" + std::to_string(static_cast<long long>(req->getRequestTime()));
+        json += ",\"occupyTime\":" + std::to_string(static_cast<long long>(req->getOccupyTime()));
+        json += ",\"releaseTime\":" + std::to_string(static_cast<long long>(req->getReleaseTime()));
+        json += ",\"durationHours\":" + std::to_string(req->getParkingDurationHours());
+        json += ",\"waitSeconds\":" + std::to_string(req->getWaitSeconds());
+        json += ",\"dwellSeconds\":" + std::to_string(req->getDwellSeconds());
+        json += ",\"charge\":" + std::to_string(req->getCharge() / 100.0);
+        json += "}";
+    }
+    json += "]}";
+}
+
+// -------- Harness --------
+struct Measurement {
+    double microsPerDoc;
+    double allocsPerDoc;
+    size_t bytes;
+};
+
+template <typename Build>
+static Measurement measure(int rounds, Build build) {
+    build();   // warm-up sizes any reusable buffers
+    unsigned long long before = g_allocations;
+    auto start = WallClock::now();
+    size_t bytes = 0;
+    for (int r = 0; r < rounds; r++)
+        bytes = build();
+    double seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+
+    Measurement m;
+    m.microsPerDoc = seconds * 1e6 / rounds;
+    m.allocsPerDoc = static_cast<double>(g_allocations - before) / rounds;
+    m.bytes = bytes;
+    return m;
+}
+
+static void report(const char* name, const Measurement& m) {
+    std::printf("  %-26s %10.1f us/doc %10.1f allocs/doc %9zu bytes\n",
+                name, m.microsPerDoc, m.allocsPerDoc, m.bytes);
+}
+
+// Parks, occupies and releases `vehicles` cars, leaving every other one
+// parked, so history has a mix of RELEASED and OCCUPIED requests
+static void populate(ParkingSystem& system, VirtualClock& clock, int vehicles) {
+    ConsoleMute mute;
+    int zones = system.getLayout().zoneCount;
+    char plate[16];
+    for (int i = 0; i < vehicles; i++) {
+        std::snprintf(plate, sizeof(plate), "JSN-%05d", i);
+        int fee = 0;
+        bool crossZone = false;
+        if (!system.createParkingRequest(plate, Vehicle::CAR, 1 + i % zones, fee, crossZone))
+            continue;
+        clock.advanceSeconds(30);
+        system.occupyParking(plate, Vehicle::CAR);
+        clock.advanceSeconds(600);
+        if (i % 2 == 0)
+            system.releaseParking(plate, Vehicle::CAR);
+    }
+}
+
+static bool runCity(const CityLayout& layout, int historyEntries, int rounds) {
+    VirtualClock clock;
+    ParkingSystem system(layout, &clock);
+    populate(system, clock, historyEntries);
+
+    std::printf("City %dx%dx%d (%d slots), %zu requests\n", layout.zoneCount, layout.areasPerZone,
+                layout.slotsPerArea, layout.getTotalSlots(), system.getRequests().size());
+
+    std::string legacy;
+    JsonWriter writer;
+
+    std::printf(" STATUS\n");
+    report("string + to_string", measure(rounds, [&]() {
+        legacy.clear();
+        legacyStatus(legacy, system);
+        return legacy.size();
+    }));
+    report("JsonWriter", measure(rounds, [&]() {
+        writer.clear();
+        ResponseJson::writeStatus(writer, system);
+        return writer.size();
+    }));
+
+    legacy.clear();
+    legacyStatus(legacy, system);
+    if (legacy.size() != writer.size() || std::memcmp(legacy.data(), writer.data(), legacy.size()) != 0) {
+        std::printf("❌ STATUS output differs\n");
+        return false;
+    }
+
+    std::printf(" HISTORY %d\n", historyEntries);
+    report("string + to_string", measure(rounds, [&]() {
+        legacyHistory(legacy, system, historyEntries);
+        return legacy.size();
+    }));
+    report("JsonWriter (+ISO times)", measure(rounds, [&]() {
+        writer.clear();
+        ResponseJson::writeHistory(writer, system, historyEntries);
+        return writer.size();
+    }));
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int rounds = 200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--rounds") == 0) rounds = atoi(argv[i + 1]);
+        else {
+            std::printf("Usage: JsonBenchmark [--rounds N]\n");
+            return 1;
+        }
+    }
+    if (rounds <= 0) {
+        std::printf("❌ --rounds must be positive\n");
+        return 1;
+    }
+
+    bool ok = runCity(CityLayout(), 800, rounds) &&
+              runCity(CityLayout(100, 5, 40), 1000, rounds);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+#include "JsonWriter.h"
+#include <cstring>
+#include <ostream>
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// -------- Buffer --------
+JsonWriter::JsonWriter(size_t initialCapacity)
+    : buffer(nullptr), length(0), capacity(0), depth(0) {
+    grow(initialCapacity > 0 ? initialCapacity : 1);
+    needComma[0] = false;
+}
+
+JsonWriter::~JsonWriter() {
+    delete[] buffer;
+}
+
+void JsonWriter::grow(size_t required) {
+    size_t newCapacity = capacity ? capacity : 1;
+    while (newCapacity < required)
+        newCapacity *= 2;
+
+    char* larger = new char[newCapacity];
+    if (length)
+        std::memcpy(larger, buffer, length);
+    delete[] buffer;
+    buffer = larger;
+    capacity = newCapacity;
+}
+
+void JsonWriter::put(const char* text, size_t count) {
+    reserve(count);
+    std::memcpy(buffer + length, text, count);
+    length += count;
+}
+
+void JsonWriter::clear() {
+    length = 0;
+    depth = 0;
+    needComma[0] = false;
+}
+
+const char* JsonWriter::data() const {
+    return buffer;
+}
+
+size_t JsonWriter::size() const {
+    return length;
+}
+
+void JsonWriter::writeTo(std::ostream& out) const {
+    out.write(buffer, static_cast<std::streamsize>(length));
+}
+
+// A value needs a comma if it is not the first in its container; a value
+// written right after key() never does (key() already placed it).
+void JsonWriter::separator() {
+    if (needComma[depth])
+        put(',');
+    needComma[depth] = true;
+}
+
+// -------- Structure --------
+JsonWriter& JsonWriter::beginObject() {
+    separator();
+    put('{');
+    if (depth + 1 < MAX_DEPTH)
+        depth++;
+    needComma[depth] = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    put('}');
+    if (depth > 0)
+        depth--;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separator();
+    put('[');
+    if (depth + 1 < MAX_DEPTH)
+        depth++;
+    needComma[depth] = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    put(']');
+    if (depth > 0)
+        depth--;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const char* name) {
+    separator();
+    size_t count = std::strlen(name);
+    reserve(count + 3);
+    buffer[length++] = '"';
+    std::memcpy(buffer + length, name, count);
+    length += count;
+    buffer[length++] = '"';
+    buffer[length++] = ':';
+    needComma[depth] = false;   // the value that follows
+    return *this;
+}
+
+// -------- Values --------
+JsonWriter& JsonWriter::value(const char* text) {
+    return value(text, std::strlen(text));
+}
+
+JsonWriter& JsonWriter::value(const char* text, size_t count) {
+    separator();
+    reserve(count + 2);
+    buffer[length++] = '"';
+    for (size_t i = 0; i < count; i++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            put('\\');
+            put(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            put(' ');
+        } else {
+            put(c);
+        }
+    }
+    put('"');
+    needComma[depth] = true;
+    return *this;
+}
+
+void JsonWriter::writeUnsigned(uint64_t number) {
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* cursor = end;
+
+    while (number >= 100) {
+        unsigned pair = static_cast<unsigned>(number % 100) * 2;
+        number /= 100;
+        *--cursor = DIGIT_PAIRS[pair + 1];
+        *--cursor = DIGIT_PAIRS[pair];
+    }
+    if (number >= 10) {
+        unsigned pair = static_cast<unsigned>(number) * 2;
+        *--cursor = DIGIT_PAIRS[pair + 1];
+        *--cursor = DIGIT_PAIRS[pair];
+    } else {
+        *--cursor = static_cast<char>('0' + number);
+    }
+    put(cursor, static_cast<size_t>(end - cursor));
+}
+
+JsonWriter& JsonWriter::value(int32_t number) {
+    return value(static_cast<int64_t>(number));
+}
+
+JsonWriter& JsonWriter::value(int64_t number) {
+    separator();
+    if (number < 0) {
+        put('-');
+        writeUnsigned(0 - static_cast<uint64_t>(number));
+    } else {
+        writeUnsigned(static_cast<uint64_t>(number));
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(uint64_t number) {
+    separator();
+    writeUnsigned(number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separator();
+    if (flag)
+        put("true", 4);
+    else
+        put("false", 5);
+    return *this;
+}
+
+// Fixed-point with `decimals` digits (0-9), rounded half away from zero.
+// Values outside +-9.2e18 / 10^decimals, and NaN/inf, are written as null.
+JsonWriter& JsonWriter::value(double number, int decimals) {
+    static const double POWERS[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    if (decimals < 0) decimals = 0;
+    if (decimals > 9) decimals = 9;
+
+    double scaled = number * POWERS[decimals];
+    if (!(scaled > -9.2e18 && scaled < 9.2e18))
+        return null();
+
+    separator();
+    bool negative = scaled < 0;
+    uint64_t fixed = static_cast<uint64_t>((negative ? -scaled : scaled) + 0.5);
+    uint64_t scale = static_cast<uint64_t>(POWERS[decimals]);
+
+    if (negative && fixed != 0)
+        put('-');
+    writeUnsigned(fixed / scale);
+    if (decimals > 0) {
+        char fraction[9];
+        uint64_t rest = fixed % scale;
+        for (int i = decimals - 1; i >= 0; i--) {
+            fraction[i] = static_cast<char>('0' + rest % 10);
+            rest /= 10;
+        }
+        put('.');
+        put(fraction, static_cast<size_t>(decimals));
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separator();
+    put("null", 4);
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(const char* json, size_t count) {
+    separator();
+    put(json, count);
+    return *this;
+}
+
+// -------- Timestamps --------
+// Civil date from days since 1970-01-01 (proleptic Gregorian), so no
+// gmtime/ctime and no shared static buffer.
+size_t JsonWriter::formatTimestamp(int64_t unixSeconds, char* out) {
+    int64_t days = unixSeconds / 86400;
+    int64_t secondOfDay = unixSeconds % 86400;
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days--;
+    }
+
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    int day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    int month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    int year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+
+    int hour = static_cast<int>(secondOfDay / 3600);
+    int minute = static_cast<int>(secondOfDay / 60 % 60);
+    int second = static_cast<int>(secondOfDay % 60);
+
+    out[0] = static_cast<char>('0' + year / 1000 % 10);
+    out[1] = static_cast<char>('0' + year / 100 % 10);
+    std::memcpy(out + 2, DIGIT_PAIRS + (year % 100) * 2, 2);
+    out[4] = '-';
+    std::memcpy(out + 5, DIGIT_PAIRS + month * 2, 2);
+    out[7] = '-';
+    std::memcpy(out + 8, DIGIT_PAIRS + day * 2, 2);
+    out[10] = 'T';
+    std::memcpy(out + 11, DIGIT_PAIRS + hour * 2, 2);
+    out[13] = ':';
+    std::memcpy(out + 14, DIGIT_PAIRS + minute * 2, 2);
+    out[16] = ':';
+    std::memcpy(out + 17, DIGIT_PAIRS + second * 2, 2);
+    out[19] = 'Z';
+    out[20] = '\0';
+    return 20;
+}
+
+JsonWriter& JsonWriter::timestamp(int64_t unixSeconds) {
+    if (unixSeconds == 0)
+        return null();
+
+    char text[24];
+    size_t count = formatTimestamp(unixSeconds, text);
+    separator();
+    put('"');
+    put(text, count);
+    put('"');
+    return *this;
+}
@@ -0,0 +1,84 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Streaming JSON writer for protocol responses.
+//
+// Formats straight into one growable buffer that is reused between
+// documents: after the first few responses have sized it, writing a
+// document performs no heap allocation. Numbers and timestamps are
+// formatted by hand, so nothing goes through iostreams, the C locale
+// or ctime's static buffer. Commas are inserted automatically.
+//
+//   out.clear();
+//   out.beginObject().key("zone").value(3).key("free").value(17).endObject();
+class JsonWriter {
+public:
+    static const int MAX_DEPTH = 32;
+
+private:
+    char* buffer;
+    size_t length;
+    size_t capacity;
+
+    int depth;
+    bool needComma[MAX_DEPTH];
+
+    void reserve(size_t extra) {
+        if (length + extra > capacity)
+            grow(length + extra);
+    }
+    void grow(size_t required);
+    void put(char c) {
+        reserve(1);
+        buffer[length++] = c;
+    }
+    void put(const char* text, size_t count);
+    void separator();
+    void writeUnsigned(uint64_t value);
+
+    JsonWriter(const JsonWriter&);
+    JsonWriter& operator=(const JsonWriter&);
+
+public:
+    explicit JsonWriter(size_t initialCapacity = 64 * 1024);
+    ~JsonWriter();
+
+    void clear();
+    const char* data() const;
+    size_t size() const;
+    void writeTo(std::ostream& out) const;
+
+    // -------- Structure --------
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(const char* name);   // name is written verbatim (no escaping)
+
+    // -------- Values --------
+    JsonWriter& value(const char* text);
+    JsonWriter& value(const char* text, size_t count);
+    JsonWriter& value(int32_t number);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(uint64_t number);
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number, int decimals = 6);
+    JsonWriter& null();
+
+    // Unix seconds as an ISO-8601 UTC string ("2025-01-01T08:30:00Z"),
+    // or null when seconds is 0 (time not set)
+    JsonWriter& timestamp(int64_t unixSeconds);
+
+    // Pre-serialised JSON value, copied as-is
+    JsonWriter& raw(const char* json, size_t count);
+
+    // Writes the ISO-8601 form of unixSeconds into out (at least 21 bytes)
+    // and returns its length (20)
+    static size_t formatTimestamp(int64_t unixSeconds, char* out);
+};
+
+#endif
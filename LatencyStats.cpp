@@ -0,0 +1,63 @@
+#include "LatencyStats.h"
+#include <algorithm>
+
+// -------- Constructor --------
+LatencyStats::LatencyStats() : failures(0) {}
+
+// -------- Recording --------
+void LatencyStats::record(int64_t nanos, bool succeeded) {
+    samples.push_back(nanos);
+    if (!succeeded)
+        failures++;
+}
+
+void LatencyStats::clear() {
+    samples.clear();
+    failures = 0;
+}
+
+// -------- Summary --------
+long long LatencyStats::getCount() const {
+    return static_cast<long long>(samples.size());
+}
+
+long long LatencyStats::getFailures() const {
+    return failures;
+}
+
+double LatencyStats::getMeanNanos() const {
+    if (samples.empty())
+        return 0.0;
+
+    double total = 0.0;
+    for (auto s : samples)
+        total += static_cast<double>(s);
+    return total / samples.size();
+}
+
+double LatencyStats::getTotalSeconds() const {
+    return getMeanNanos() * samples.size() / 1e9;
+}
+
+int64_t LatencyStats::percentile(double p) const {
+    int64_t out = 0;
+    percentiles(&p, 1, &out);
+    return out;
+}
+
+void LatencyStats::percentiles(const double* ps, int n, int64_t* out) const {
+    if (samples.empty()) {
+        for (int i = 0; i < n; i++) out[i] = 0;
+        return;
+    }
+
+    std::vector<int64_t> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int i = 0; i < n; i++) {
+        double rank = ps[i] / 100.0 * (sorted.size() - 1);
+        size_t index = static_cast<size_t>(rank + 0.5);
+        if (index >= sorted.size()) index = sorted.size() - 1;
+        out[i] = sorted[index];
+    }
+}
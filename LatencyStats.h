@@ -0,0 +1,30 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <cstdint>
+#include <vector>
+
+// Raw latency samples (nanoseconds) for one operation type.
+// Percentiles are computed on demand by sorting a copy.
+class LatencyStats {
+private:
+    std::vector<int64_t> samples;
+    long long failures;
+
+public:
+    LatencyStats();
+
+    void record(int64_t nanos, bool succeeded = true);
+    void clear();
+
+    long long getCount() const;
+    long long getFailures() const;
+    double getMeanNanos() const;
+    double getTotalSeconds() const;
+
+    // p in [0, 100]; returns 0 when empty
+    int64_t percentile(double p) const;
+    void percentiles(const double* ps, int n, int64_t* out) const;
+};
+
+#endif
@@ -1,5 +1,17 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include "ParkingSystem.h"
+#include "BatchIngest.h"
+
+// Interactive menu by default.
+//
+//   Main --batch FILE [--zones N] [--areas N] [--slots N] [--status]
+//
+// runs a command file ("-" for stdin) of PARK/OCCUPY/RELEASE/CANCEL/ROLLBACK
+// lines without prompts and prints a summary; --status also prints the
+// zone status afterwards.
 
 using namespace std;
 
@@ -13,6 +25,7 @@ void showMenu() {
     cout << "6. View Zone Status\n";
     cout << "7. View Last 5 Operations\n";  
     cout << "8. Rollback Last Operation(s)\n";  
+    cout << "9. Search Vehicle (partial / misread plate)\n";
     cout << "0. Exit\n";
     cout << "=========================================\n";
     cout << "Enter choice: ";
@@ -50,7 +63,74 @@ int inputParkingArea() {
     return area;
 }
 
-int main() {
+static void usage() {
+    cout << "Usage: Main [--batch FILE|-] [--zones N] [--areas N] [--slots N] [--status]\n";
+}
+
+static int runBatch(const char* path, const CityLayout& layout, bool showStatus) {
+    FILE* input = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!input) {
+        cout << "❌ Cannot open command file " << path << "\n";
+        return 1;
+    }
+
+    ParkingSystem system(layout);
+    BatchSummary summary;
+    bool ok = BatchIngest::run(system, input, summary);
+    if (input != stdin)
+        fclose(input);
+
+    summary.print(cout);
+    if (showStatus)
+        system.displayZoneStatus();
+    if (!ok) {
+        cout << "❌ Read error in " << path << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        const char* batchPath = nullptr;
+        CityLayout layout;
+        bool showStatus = false;
+
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+            if (strcmp(arg, "--status") == 0) {
+                showStatus = true;
+                continue;
+            }
+            if (value == nullptr) {
+                usage();
+                return strcmp(arg, "--help") == 0 ? 0 : 1;
+            }
+
+            if (strcmp(arg, "--batch") == 0)       batchPath = value;
+            else if (strcmp(arg, "--zones") == 0)  layout.zoneCount = atoi(value);
+            else if (strcmp(arg, "--areas") == 0)  layout.areasPerZone = atoi(value);
+            else if (strcmp(arg, "--slots") == 0)  layout.slotsPerArea = atoi(value);
+            else {
+                usage();
+                return 1;
+            }
+            i++;
+        }
+
+        if (batchPath == nullptr) {
+            usage();
+            return 1;
+        }
+        if (layout.zoneCount <= 0 || layout.areasPerZone <= 0 || layout.slotsPerArea <= 0) {
+            cout << "❌ City dimensions must be positive\n";
+            return 1;
+        }
+        return runBatch(batchPath, layout, showStatus);
+    }
+
     ParkingSystem system;
     int choice;
 
@@ -184,6 +264,31 @@ int main() {
                 break;
             }
                 
+            case 9: {  // Search by partial plate
+                string text;
+                cout << "Enter plate or its first characters: ";
+                cin >> text;
+
+                vector<PlateMatch> matches;
+                system.searchPlates(text, true, 1, 10, matches);
+                if (matches.empty()) {
+                    cout << "❌ No vehicle matches " << text << "\n";
+                    break;
+                }
+                for (const PlateMatch& match : matches) {
+                    const ParkingRequest& req = system.getRequests()[match.handle];
+                    cout << (match.edits == 0 ? "  " : "~ ") << req.getVehicleNumber()
+                         << " (" << Vehicle::vehicleTypeName(req.getVehicleType()) << ") "
+                         << req.getStateName();
+                    if (req.hasAllocatedSlot())
+                        cout << " | slot " << req.getAllocatedSlotId()
+                             << " zone " << req.getAllocatedZoneId()
+                             << " area " << req.getAllocatedAreaId();
+                    cout << "\n";
+                }
+                break;
+            }
+
             case 0:
                 cout << "Exiting system. Goodbye!\n";
                 break;
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <malloc.h>
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+
+// Heap footprint of the core structures.
+//
+//   MemoryBenchmark [--zones N] [--areas N] [--slots N] [--sessions N]
+//
+// Reports live heap bytes (glibc mallinfo2, so allocator overhead is
+// included) per slot after building the city, and per session after
+// parking, occupying and releasing --sessions fresh vehicles (every
+// tenth one is cancelled instead of occupied). The city is sized so no
+// request is refused.
+
+static long long heapInUse() {
+    return static_cast<long long>(mallinfo2().uordblks);
+}
+
+int main(int argc, char** argv) {
+    CityLayout layout(100, 10, 200);
+    int sessions = 100000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--zones") == 0)         layout.zoneCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--areas") == 0)    layout.areasPerZone = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--slots") == 0)    layout.slotsPerArea = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--sessions") == 0) sessions = atoi(argv[i + 1]);
+        else {
+            std::printf("Usage: MemoryBenchmark [--zones N] [--areas N] [--slots N] [--sessions N]\n");
+            return 1;
+        }
+    }
+    if (layout.zoneCount <= 0 || layout.areasPerZone <= 0 || layout.slotsPerArea <= 0 || sessions <= 0 ||
+        sessions > layout.getTotalSlots()) {
+        std::printf("❌ Need a non-empty city with at least as many slots as sessions\n");
+        return 1;
+    }
+
+    long long start = heapInUse();
+    ParkingSystem* system = new ParkingSystem(layout);
+    long long built = heapInUse();
+
+    int parked = 0;
+    {
+        ConsoleMute mute;
+        for (int i = 0; i < sessions; i++) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "M%08d", i);
+            VehiclePlate plate(text);
+            int fee = 0;
+            bool crossZone = false;
+            if (!system->createParkingRequest(plate, Vehicle::CAR, 1 + i % layout.zoneCount, fee, crossZone))
+                continue;
+            parked++;
+            if (i % 10 == 9) {
+                system->cancelRequest(plate, Vehicle::CAR);
+            } else {
+                system->occupyParking(plate, Vehicle::CAR);
+                if (i % 2 == 0)
+                    system->releaseParking(plate, Vehicle::CAR);
+            }
+        }
+    }
+    long long used = heapInUse();
+
+    int slots = layout.getTotalSlots();
+    std::printf("🧮 %dx%dx%d city (%d slots), %d sessions\n",
+                layout.zoneCount, layout.areasPerZone, layout.slotsPerArea, slots, parked);
+    std::printf("   sizeof(ParkingSlot)     %4zu bytes\n", sizeof(ParkingSlot));
+    std::printf("   sizeof(ParkingRequest)  %4zu bytes\n", sizeof(ParkingRequest));
+    std::printf("   per slot     %8.1f bytes  (%lld total)\n",
+                static_cast<double>(built - start) / slots, built - start);
+    std::printf("   per session  %8.1f bytes  (%lld total)\n",
+                parked > 0 ? static_cast<double>(used - built) / parked : 0.0, used - built);
+
+    delete system;
+    return parked == sessions ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+#include "Metrics.h"
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+// -------- LatencyHistogram --------
+LatencyHistogram::LatencyHistogram() : total(0), sum(0), maxValue(0) {
+    for (int i = 0; i < BUCKETS; i++)
+        counts[i] = 0;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return static_cast<uint64_t>(bucket);
+
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lower + ((1ULL << shift) - 1);
+}
+
+void LatencyHistogram::add(int bucket, uint64_t count) {
+    counts[bucket] += count;
+    total += count;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    add(bucketFor(value), 1);
+    sum += value;
+    if (value > maxValue)
+        maxValue = value;
+}
+
+void LatencyHistogram::setTotals(uint64_t s, uint64_t m) {
+    sum = s;
+    maxValue = m;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKETS; i++)
+        counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    if (other.maxValue > maxValue)
+        maxValue = other.maxValue;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return total;
+}
+
+double LatencyHistogram::getMean() const {
+    return total ? static_cast<double>(sum) / total : 0.0;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return maxValue;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0)
+        return 0;
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t upper = bucketUpperBound(i);
+            return upper < maxValue ? upper : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+// -------- MetricsSnapshot / MetricsShard --------
+MetricsSnapshot::MetricsSnapshot() : enabled(PARKING_METRICS != 0), threads(0) {
+    for (int op = 0; op < METRIC_OP_COUNT; op++) {
+        successes[op] = 0;
+        failures[op] = 0;
+    }
+}
+
+MetricsShard::MetricsShard() {
+    for (int op = 0; op < METRIC_OP_COUNT; op++) {
+        successes[op].store(0, std::memory_order_relaxed);
+        failures[op].store(0, std::memory_order_relaxed);
+        sum[op].store(0, std::memory_order_relaxed);
+        maxTicks[op].store(0, std::memory_order_relaxed);
+        for (int b = 0; b < LatencyHistogram::BUCKETS; b++)
+            buckets[op][b].store(0, std::memory_order_relaxed);
+    }
+}
+
+// -------- Shard Registry --------
+// Shards outlive their threads so counts from finished threads are kept.
+static std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<MetricsShard*>& registry() {
+    static std::vector<MetricsShard*> shards;
+    return shards;
+}
+
+MetricsShard* Metrics::registerShard() {
+    MetricsShard* shard = new MetricsShard();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(shard);
+    return shard;
+}
+
+// -------- Tick Calibration --------
+struct TickReference {
+    uint64_t ticks;
+    std::chrono::steady_clock::time_point time;
+
+    TickReference() : ticks(Metrics::readTicks()), time(std::chrono::steady_clock::now()) {}
+};
+
+static TickReference g_tickReference;
+static std::once_flag g_calibrated;
+static double g_nanosPerTick = 1.0;
+
+// Measure against the reference taken at startup; spin briefly if too
+// little time has passed for a stable ratio.
+static void measureTickRate() {
+#if defined(__x86_64__) || defined(__i386__)
+    auto now = std::chrono::steady_clock::now();
+    while (now - g_tickReference.time < std::chrono::milliseconds(10))
+        now = std::chrono::steady_clock::now();
+    uint64_t ticks = Metrics::readTicks();
+
+    double nanos = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - g_tickReference.time).count());
+    double elapsedTicks = static_cast<double>(ticks - g_tickReference.ticks);
+    if (elapsedTicks > 0)
+        g_nanosPerTick = nanos / elapsedTicks;
+#endif
+}
+
+void Metrics::calibrate() {
+    std::call_once(g_calibrated, measureTickRate);
+}
+
+double Metrics::nanosPerTick() {
+    calibrate();
+    return g_nanosPerTick;
+}
+
+// -------- Public API --------
+bool Metrics::isEnabled() {
+    return PARKING_METRICS != 0;
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    MetricsSnapshot result;
+    double scale = nanosPerTick();
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    result.threads = static_cast<int>(registry().size());
+
+    for (auto shard : registry()) {
+        for (int op = 0; op < METRIC_OP_COUNT; op++) {
+            result.successes[op] += shard->successes[op].load(std::memory_order_relaxed);
+            result.failures[op] += shard->failures[op].load(std::memory_order_relaxed);
+
+            LatencyHistogram nanos;
+            for (int b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                uint64_t count = shard->buckets[op][b].load(std::memory_order_relaxed);
+                if (count) {
+                    uint64_t value = static_cast<uint64_t>(LatencyHistogram::bucketUpperBound(b) * scale);
+                    nanos.add(LatencyHistogram::bucketFor(value), count);
+                }
+            }
+            nanos.setTotals(static_cast<uint64_t>(shard->sum[op].load(std::memory_order_relaxed) * scale),
+                            static_cast<uint64_t>(shard->maxTicks[op].load(std::memory_order_relaxed) * scale));
+            result.latency[op].merge(nanos);
+        }
+    }
+    return result;
+}
+
+const char* Metrics::opName(MetricOp op) {
+    switch (op) {
+        case METRIC_ALLOCATE: return "allocate";
+        case METRIC_OCCUPY:   return "occupy";
+        case METRIC_RELEASE:  return "release";
+        case METRIC_CANCEL:   return "cancel";
+        case METRIC_ROLLBACK: return "rollback";
+        case METRIC_LOOKUP:   return "lookup";
+        default:              return "unknown";
+    }
+}
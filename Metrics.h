@@ -0,0 +1,165 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+
+// Hot-path instrumentation for ParkingSystem.
+//
+// Build with -DPARKING_METRICS=1 to enable. When disabled (the default)
+// METRICS_SCOPE / METRICS_SUCCESS expand to nothing and no timer code is
+// compiled into the operations. When enabled each operation costs two
+// cycle-counter reads plus a few uncontended relaxed stores into a
+// per-thread shard; shards are merged only when a snapshot is taken.
+
+#ifndef PARKING_METRICS
+#define PARKING_METRICS 0
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+enum MetricOp {
+    METRIC_ALLOCATE,
+    METRIC_OCCUPY,
+    METRIC_RELEASE,
+    METRIC_CANCEL,
+    METRIC_ROLLBACK,
+    METRIC_LOOKUP,
+    METRIC_OP_COUNT
+};
+
+// -------- Log-linear (HDR-style) histogram --------
+// 16 linear sub-buckets per power of two: ~6% worst-case relative error,
+// fixed 976 buckets covering the full 64-bit range.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t maxValue;
+
+public:
+    LatencyHistogram();
+
+    static int bucketFor(uint64_t value) {
+        if (value < static_cast<uint64_t>(SUB_BUCKETS))
+            return static_cast<int>(value);
+        int exponent = 63 - __builtin_clzll(value);
+        int shift = exponent - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<int>((value >> shift) - SUB_BUCKETS);
+    }
+    static uint64_t bucketUpperBound(int bucket);
+
+    void add(int bucket, uint64_t count);
+    void record(uint64_t value);
+    void setTotals(uint64_t sum, uint64_t maxValue);
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const;
+    double getMean() const;
+    uint64_t getMax() const;
+    uint64_t percentile(double p) const;
+};
+
+// -------- Snapshot (merged across threads) --------
+struct MetricsSnapshot {
+    bool enabled;
+    int threads;
+    uint64_t successes[METRIC_OP_COUNT];
+    uint64_t failures[METRIC_OP_COUNT];
+    LatencyHistogram latency[METRIC_OP_COUNT];   // nanoseconds
+
+    MetricsSnapshot();
+};
+
+// -------- Per-thread shard --------
+// Written only by its owning thread (relaxed load + store, no RMW);
+// readers load the same atomics while merging.
+struct MetricsShard {
+    std::atomic<uint64_t> successes[METRIC_OP_COUNT];
+    std::atomic<uint64_t> failures[METRIC_OP_COUNT];
+    std::atomic<uint64_t> sum[METRIC_OP_COUNT];
+    std::atomic<uint64_t> maxTicks[METRIC_OP_COUNT];
+    std::atomic<uint64_t> buckets[METRIC_OP_COUNT][LatencyHistogram::BUCKETS];
+
+    MetricsShard();
+};
+
+class Metrics {
+private:
+    static MetricsShard* registerShard();
+
+    static inline void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+public:
+    static inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static inline void record(MetricOp op, uint64_t ticks, bool ok) {
+        static thread_local MetricsShard* shard = nullptr;
+        if (shard == nullptr)
+            shard = registerShard();
+
+        bump(ok ? shard->successes[op] : shard->failures[op], 1);
+        bump(shard->sum[op], ticks);
+        bump(shard->buckets[op][LatencyHistogram::bucketFor(ticks)], 1);
+        if (ticks > shard->maxTicks[op].load(std::memory_order_relaxed))
+            shard->maxTicks[op].store(ticks, std::memory_order_relaxed);
+    }
+
+    static bool isEnabled();
+    static MetricsSnapshot snapshot();
+    static const char* opName(MetricOp op);
+
+    // Tick length, measured once: by calibrate() if a program calls it at
+    // startup, else on first use. Measuring spins until 10 ms have passed
+    // since static initialization, so servers calibrate before taking
+    // requests rather than stalling the first STATS.
+    static void calibrate();
+    static double nanosPerTick();
+};
+
+// -------- Scope timer --------
+// Records on destruction; the operation counts as failed unless
+// succeed() was called first.
+class MetricScope {
+private:
+    MetricOp op;
+    uint64_t start;
+    bool ok;
+
+public:
+    explicit MetricScope(MetricOp o) : op(o), start(Metrics::readTicks()), ok(false) {}
+    ~MetricScope() { Metrics::record(op, Metrics::readTicks() - start, ok); }
+    void succeed() { ok = true; }
+    void result(bool value) { ok = value; }
+};
+
+#if PARKING_METRICS
+#define METRICS_SCOPE(op)      MetricScope metricScope(op)
+#define METRICS_SUCCESS()      metricScope.succeed()
+#define METRICS_RESULT(value)  metricScope.result(value)
+#else
+#define METRICS_SCOPE(op)      ((void)0)
+#define METRICS_SUCCESS()      ((void)0)
+#define METRICS_RESULT(value)  ((void)0)
+#endif
+
+#endif
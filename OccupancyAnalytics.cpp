@@ -0,0 +1,270 @@
+#include "OccupancyAnalytics.h"
+
+const int64_t OccupancyAnalytics::NANOS_PER_MINUTE;
+const int64_t OccupancyAnalytics::NANOS_PER_HOUR;
+
+static int ringPosition(int64_t bucket, int size) {
+    return static_cast<int>(((bucket % size) + size) % size);
+}
+
+// -------- OccupancyPoint --------
+OccupancyPoint::OccupancyPoint()
+    : startNanos(0), averageOccupied(0.0), peakOccupied(0), transitions(0), capacity(0) {}
+
+double OccupancyPoint::getAverageUtilization() const {
+    return capacity > 0 ? averageOccupied / capacity : 0.0;
+}
+
+// -------- Constructor --------
+OccupancyAnalytics::OccupancyAnalytics(int zones, int areas, int slotsPerArea)
+    : zoneCount(0), areasPerZone(areas) {
+    Series city;
+    city.occupied = 0;
+    city.capacity = 0;
+    city.lastChangeNanos = 0;
+    city.started = false;
+    series.push_back(city);
+    appendBuckets(1);
+
+    for (int z = 0; z < zones; z++)
+        addZone(slotsPerArea);
+}
+
+void OccupancyAnalytics::appendBuckets(int seriesCount) {
+    Bucket unused;
+    unused.index = -1;
+    unused.slotSeconds = 0.0;
+    unused.peak = 0;
+    unused.transitions = 0;
+    minuteBuckets.insert(minuteBuckets.end(), static_cast<size_t>(seriesCount) * MINUTE_BUCKETS, unused);
+    hourBuckets.insert(hourBuckets.end(), static_cast<size_t>(seriesCount) * HOUR_BUCKETS, unused);
+}
+
+// -------- Topology --------
+// A zone's series (zone, then its areas) are contiguous, so adding one
+// only appends.
+int OccupancyAnalytics::addZone(int slotsPerArea) {
+    Series empty;
+    empty.occupied = 0;
+    empty.capacity = slotsPerArea;
+    empty.lastChangeNanos = 0;
+    empty.started = false;
+    series.insert(series.end(), 1 + areasPerZone, empty);
+    series[series.size() - 1 - areasPerZone].capacity = areasPerZone * slotsPerArea;
+    series[0].capacity += areasPerZone * slotsPerArea;
+    appendBuckets(1 + areasPerZone);
+
+    dwellNanos.emplace_back();
+    waitNanos.emplace_back();
+    return ++zoneCount;
+}
+
+void OccupancyAnalytics::adjustCapacity(int zoneId, int areaId, int delta) {
+    int zone = seriesIndex(zoneId, 0);
+    int area = seriesIndex(zoneId, areaId);
+    if (zone < 0 || area < 0)
+        return;
+
+    series[0].capacity += delta;
+    series[zone].capacity += delta;
+    series[area].capacity += delta;
+}
+
+void OccupancyAnalytics::correct(int zoneId, int areaId, int occupied, int capacity, int64_t nowNanos) {
+    int index = seriesIndex(zoneId, areaId);
+    if (index < 0)
+        return;
+
+    if (occupied != series[index].occupied)
+        update(index, occupied - series[index].occupied, nowNanos);
+    series[index].capacity = capacity;
+}
+
+// -------- Helpers --------
+int OccupancyAnalytics::seriesIndex(int zoneId, int areaId) const {
+    if (zoneId == 0)
+        return areaId == 0 ? 0 : -1;
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 0 || areaId > areasPerZone)
+        return -1;
+    return 1 + (zoneId - 1) * (1 + areasPerZone) + areaId;
+}
+
+// Adds `occupied` slots held over [from, to) to every bucket the interval
+// covers. Buckets older than the ring are skipped, so a long idle gap
+// costs at most one pass over the ring.
+void OccupancyAnalytics::accumulate(Bucket* ring, int size, int64_t width,
+                                    int64_t from, int64_t to, int occupied) {
+    int64_t first = from / width;
+    int64_t last = to / width;
+    if (last - first >= size) {
+        first = last - size + 1;
+        from = first * width;
+    }
+
+    for (int64_t b = first; b <= last; b++) {
+        Bucket& bucket = ring[ringPosition(b, size)];
+        if (bucket.index != b) {
+            bucket.index = b;
+            bucket.slotSeconds = 0.0;
+            bucket.peak = 0;
+            bucket.transitions = 0;
+        }
+
+        int64_t lo = from > b * width ? from : b * width;
+        int64_t hi = to < (b + 1) * width ? to : (b + 1) * width;
+        bucket.slotSeconds += static_cast<double>(occupied) * (hi - lo) / 1e9;
+        if (occupied > bucket.peak)
+            bucket.peak = occupied;
+    }
+}
+
+void OccupancyAnalytics::update(int index, int delta, int64_t nowNanos) {
+    Series& s = series[index];
+    if (!s.started) {
+        s.started = true;
+        s.lastChangeNanos = nowNanos;
+    }
+    if (nowNanos < s.lastChangeNanos)
+        nowNanos = s.lastChangeNanos;
+
+    Bucket* minutes = &minuteBuckets[static_cast<size_t>(index) * MINUTE_BUCKETS];
+    Bucket* hours = &hourBuckets[static_cast<size_t>(index) * HOUR_BUCKETS];
+    accumulate(minutes, MINUTE_BUCKETS, NANOS_PER_MINUTE, s.lastChangeNanos, nowNanos, s.occupied);
+    accumulate(hours, HOUR_BUCKETS, NANOS_PER_HOUR, s.lastChangeNanos, nowNanos, s.occupied);
+
+    s.occupied += delta;
+    s.lastChangeNanos = nowNanos;
+
+    // accumulate() left the buckets containing nowNanos current
+    Bucket& minute = minutes[ringPosition(nowNanos / NANOS_PER_MINUTE, MINUTE_BUCKETS)];
+    Bucket& hour = hours[ringPosition(nowNanos / NANOS_PER_HOUR, HOUR_BUCKETS)];
+    if (s.occupied > minute.peak) minute.peak = s.occupied;
+    if (s.occupied > hour.peak) hour.peak = s.occupied;
+    minute.transitions++;
+    hour.transitions++;
+}
+
+// -------- Updates --------
+void OccupancyAnalytics::recordSlotChange(int zoneId, int areaId, bool nowAvailable, int64_t nowNanos) {
+    int zone = seriesIndex(zoneId, 0);
+    int area = seriesIndex(zoneId, areaId);
+    if (zone < 0 || area < 0)
+        return;
+
+    int delta = nowAvailable ? -1 : 1;
+    update(0, delta, nowNanos);
+    update(zone, delta, nowNanos);
+    update(area, delta, nowNanos);
+}
+
+void OccupancyAnalytics::recordWait(int zoneId, int64_t waitNanosValue) {
+    if (zoneId < 1 || zoneId > zoneCount)
+        return;
+    waitNanos[zoneId - 1].record(waitNanosValue > 0 ? static_cast<uint64_t>(waitNanosValue) : 0);
+}
+
+void OccupancyAnalytics::recordDwell(int zoneId, int64_t dwellNanosValue) {
+    if (zoneId < 1 || zoneId > zoneCount)
+        return;
+    dwellNanos[zoneId - 1].record(dwellNanosValue > 0 ? static_cast<uint64_t>(dwellNanosValue) : 0);
+}
+
+// -------- Queries --------
+int OccupancyAnalytics::getOccupied(int zoneId, int areaId) const {
+    int index = seriesIndex(zoneId, areaId);
+    return index < 0 ? 0 : series[index].occupied;
+}
+
+int OccupancyAnalytics::getCapacity(int zoneId, int areaId) const {
+    int index = seriesIndex(zoneId, areaId);
+    return index < 0 ? 0 : series[index].capacity;
+}
+
+// Stored buckets are complete up to lastChangeNanos; the stretch from
+// there to nowNanos is held at the current count and added on the fly.
+void OccupancyAnalytics::readSeries(int index, OccupancyResolution resolution, int64_t nowNanos,
+                                    std::vector<OccupancyPoint>& out) const {
+    const Series& s = series[index];
+    int size = resolution == RESOLUTION_MINUTE ? MINUTE_BUCKETS : HOUR_BUCKETS;
+    int64_t width = resolution == RESOLUTION_MINUTE ? NANOS_PER_MINUTE : NANOS_PER_HOUR;
+    const Bucket* ring = resolution == RESOLUTION_MINUTE
+        ? &minuteBuckets[static_cast<size_t>(index) * MINUTE_BUCKETS]
+        : &hourBuckets[static_cast<size_t>(index) * HOUR_BUCKETS];
+
+    int64_t current = nowNanos / width;
+    out.clear();
+    out.reserve(size);
+
+    for (int64_t b = current - size + 1; b <= current; b++) {
+        OccupancyPoint point;
+        point.startNanos = b * width;
+        point.capacity = s.capacity;
+
+        double slotSeconds = 0.0;
+        const Bucket& bucket = ring[ringPosition(b, size)];
+        if (bucket.index == b) {
+            slotSeconds = bucket.slotSeconds;
+            point.peakOccupied = bucket.peak;
+            point.transitions = bucket.transitions;
+        }
+
+        if (s.started) {
+            int64_t lo = s.lastChangeNanos > b * width ? s.lastChangeNanos : b * width;
+            int64_t hi = nowNanos < (b + 1) * width ? nowNanos : (b + 1) * width;
+            if (hi >= lo) {
+                slotSeconds += static_cast<double>(s.occupied) * (hi - lo) / 1e9;
+                if (s.occupied > point.peakOccupied)
+                    point.peakOccupied = s.occupied;
+            }
+        }
+
+        int64_t end = nowNanos < (b + 1) * width ? nowNanos : (b + 1) * width;
+        double coveredSeconds = static_cast<double>(end - b * width) / 1e9;
+        point.averageOccupied = coveredSeconds > 0 ? slotSeconds / coveredSeconds : 0.0;
+        out.push_back(point);
+    }
+}
+
+bool OccupancyAnalytics::getSeries(int zoneId, int areaId, OccupancyResolution resolution,
+                                   int64_t nowNanos, std::vector<OccupancyPoint>& out) const {
+    int index = seriesIndex(zoneId, areaId);
+    if (index < 0)
+        return false;
+    readSeries(index, resolution, nowNanos, out);
+    return true;
+}
+
+bool OccupancyAnalytics::getPeak(int zoneId, int areaId, OccupancyResolution resolution,
+                                 int64_t nowNanos, OccupancyPoint& peak) const {
+    std::vector<OccupancyPoint> points;
+    if (!getSeries(zoneId, areaId, resolution, nowNanos, points) || points.empty())
+        return false;
+
+    peak = points[0];
+    for (const auto& point : points)
+        if (point.averageOccupied > peak.averageOccupied)
+            peak = point;
+    return true;
+}
+
+LatencyHistogram OccupancyAnalytics::getDwellHistogram(int zoneId) const {
+    if (zoneId >= 1 && zoneId <= zoneCount)
+        return dwellNanos[zoneId - 1];
+
+    LatencyHistogram merged;
+    if (zoneId == 0)
+        for (const auto& h : dwellNanos)
+            merged.merge(h);
+    return merged;
+}
+
+LatencyHistogram OccupancyAnalytics::getWaitHistogram(int zoneId) const {
+    if (zoneId >= 1 && zoneId <= zoneCount)
+        return waitNanos[zoneId - 1];
+
+    LatencyHistogram merged;
+    if (zoneId == 0)
+        for (const auto& h : waitNanos)
+            merged.merge(h);
+    return merged;
+}
@@ -0,0 +1,112 @@
+#ifndef OCCUPANCY_ANALYTICS_H
+#define OCCUPANCY_ANALYTICS_H
+
+#include <cstdint>
+#include <vector>
+#include "Metrics.h"   // LatencyHistogram
+
+// Streaming occupancy and duration analytics for one city.
+//
+// Occupancy is kept per series (city, each zone, each area) as a
+// time-weighted integral in two rings of buckets: the last 60 minutes
+// and the last 48 hours. A slot transition touches one city, one zone
+// and one area series; each series only walks bucket boundaries it has
+// not crossed yet, so updates are amortised O(1). Dwell and wait times
+// go into per-zone log-linear histograms, merged on demand for the city.
+//
+// Series are addressed by (zoneId, areaId); zoneId 0 means the whole
+// city and areaId 0 means the whole zone. Capacity follows topology
+// changes (slots closed or reopened, zones added).
+
+enum OccupancyResolution {
+    RESOLUTION_MINUTE,
+    RESOLUTION_HOUR
+};
+
+struct OccupancyPoint {
+    int64_t startNanos;      // bucket start, same epoch as the Clock
+    double averageOccupied;  // time-weighted mean over the covered part of the bucket
+    int peakOccupied;
+    int transitions;         // slots taken + slots freed inside the bucket
+    int capacity;
+
+    OccupancyPoint();
+    double getAverageUtilization() const;
+};
+
+class OccupancyAnalytics {
+public:
+    static const int MINUTE_BUCKETS = 60;
+    static const int HOUR_BUCKETS = 48;
+    static const int64_t NANOS_PER_MINUTE = 60LL * 1000000000LL;
+    static const int64_t NANOS_PER_HOUR = 60 * NANOS_PER_MINUTE;
+
+private:
+    struct Bucket {
+        int64_t index;        // absolute bucket number (time / width); -1 = empty
+        double slotSeconds;   // integral of occupied slots over time
+        int peak;
+        int transitions;
+    };
+
+    struct Series {
+        int occupied;
+        int capacity;
+        int64_t lastChangeNanos;   // integrals are complete up to here
+        bool started;
+    };
+
+    int zoneCount;
+    int areasPerZone;
+
+    std::vector<Series> series;
+    std::vector<Bucket> minuteBuckets;   // MINUTE_BUCKETS per series
+    std::vector<Bucket> hourBuckets;     // HOUR_BUCKETS per series
+
+    std::vector<LatencyHistogram> dwellNanos;   // per zone
+    std::vector<LatencyHistogram> waitNanos;    // per zone
+
+    int seriesIndex(int zoneId, int areaId) const;
+    void appendBuckets(int seriesCount);
+    void update(int index, int delta, int64_t nowNanos);
+    static void accumulate(Bucket* ring, int size, int64_t width,
+                           int64_t from, int64_t to, int occupied);
+    void readSeries(int index, OccupancyResolution resolution, int64_t nowNanos,
+                    std::vector<OccupancyPoint>& out) const;
+
+public:
+    OccupancyAnalytics(int zoneCount, int areasPerZone, int slotsPerArea);
+
+    // -------- Updates (called on every transition) --------
+    void recordSlotChange(int zoneId, int areaId, bool nowAvailable, int64_t nowNanos);
+    void recordWait(int zoneId, int64_t waitNanos);
+    void recordDwell(int zoneId, int64_t dwellNanos);
+
+    // -------- Topology --------
+    int addZone(int slotsPerArea);                           // returns the new zone id
+    void adjustCapacity(int zoneId, int areaId, int delta);  // slots entering/leaving service
+
+    // -------- Repair (CityAudit) --------
+    // Overwrites one series' counts (areaId 0 = zone, zoneId 0 = city)
+    // and nothing else; the occupancy integral stays continuous
+    void correct(int zoneId, int areaId, int occupied, int capacity, int64_t nowNanos);
+
+    // -------- Queries --------
+    int getOccupied(int zoneId, int areaId) const;
+    int getCapacity(int zoneId, int areaId) const;
+
+    // Oldest bucket first, ending with the bucket containing nowNanos.
+    // Returns false for an unknown zone/area.
+    bool getSeries(int zoneId, int areaId, OccupancyResolution resolution,
+                   int64_t nowNanos, std::vector<OccupancyPoint>& out) const;
+
+    // Bucket with the highest average occupancy in the retained window
+    bool getPeak(int zoneId, int areaId, OccupancyResolution resolution,
+                 int64_t nowNanos, OccupancyPoint& peak) const;
+
+    // zoneId 0 merges every zone
+    LatencyHistogram getDwellHistogram(int zoneId) const;
+    LatencyHistogram getWaitHistogram(int zoneId) const;
+};
+
+#endif
@@ -2,8 +2,10 @@
 #include "ParkingSlot.h"
 
 // -------- Constructor --------
-ParkingArea::ParkingArea(int id, const std::string& name, int zone)
-    : areaId(id), areaName(name), zoneId(zone) {}
+ParkingArea::ParkingArea(int id, const std::string& name, int zone, int slotCapacity)
+    : areaId(id), areaName(name), zoneId(zone), removed(false) {
+    slots.reserve(slotCapacity);
+}
 
     
 // -------- Identity --------
@@ -12,7 +14,7 @@ int ParkingArea::getAreaId() const {
 }
 
 
-std::string ParkingArea::getAreaName() const {
+const std::string& ParkingArea::getAreaName() const {
     return areaName;
 }
 
@@ -23,22 +25,28 @@ int ParkingArea::getZoneId() const {
 
 
 // -------- Slot Management --------
-void ParkingArea::addSlot(ParkingSlot* slot) {
-    if (slot != nullptr) {
-        slots.push_back(slot);
-    }
+ParkingSlot& ParkingArea::addSlot(int slotId) {
+    slots.push_back(ParkingSlot(slotId, zoneId, areaId));
+    return slots.back();
 }
 
 
+// Slots in service plus closed ones still draining a vehicle
 int ParkingArea::getTotalSlots() const {
-    return slots.size();
+    int count = 0;
+    for (const auto& slot : slots) {
+        if (slot.isInService() || slot.isOccupied()) {
+            count++;
+        }
+    }
+    return count;
 }
 
 
 int ParkingArea::getOccupiedSlots() const {
     int count = 0;
-    for (auto slot : slots) {
-        if (!slot->isAvailable()) {
+    for (const auto& slot : slots) {
+        if (slot.isOccupied()) {
             count++;
         }
     }
@@ -56,7 +64,33 @@ bool ParkingArea::isFull() const {
 }
 
 
+int ParkingArea::getDrainingSlots() const {
+    int count = 0;
+    for (const auto& slot : slots) {
+        if (!slot.isInService() && slot.isOccupied()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+
+// -------- Topology --------
+bool ParkingArea::isRemoved() const {
+    return removed;
+}
+
+
+void ParkingArea::markRemoved() {
+    removed = true;
+}
+
+
 // -------- Slot Access --------
-const std::vector<ParkingSlot*>& ParkingArea::getSlots() const {
+std::vector<ParkingSlot>& ParkingArea::getSlots() {
+    return slots;
+}
+
+const std::vector<ParkingSlot>& ParkingArea::getSlots() const {
     return slots;
 }
@@ -1,51 +1,48 @@
-#ifndef ZONE_H
-#define ZONE_H
+#ifndef PARKING_AREA_H
+#define PARKING_AREA_H
 
 #include <string>
 #include <vector>
 
-// Forward declaration (definition comes in ParkingArea.h)
-class ParkingArea;
+#include "ParkingSlot.h"
 
-class Zone {
+class ParkingArea {
 private:
+    int areaId;
+    std::string areaName;
     int zoneId;
-    std::string zoneName;
 
-    // Parking areas inside this zone
-    std::vector<ParkingArea*> parkingAreas;
+    // Slots inside this area, stored inline. The capacity is reserved up
+    // front, so a slot never moves once added.
+    std::vector<ParkingSlot> slots;
 
-    // Logical neighboring zones (custom adjacency, not graph)
-    std::vector<Zone*> neighborZones;
+    // Removed from the city: never reopened, kept so ids stay stable
+    bool removed;
 
 public:
     // Constructor
-    Zone(int id, const std::string& name);
+    ParkingArea(int id, const std::string& name, int zone, int slotCapacity = 0);
 
-    // -------- Zone Identity --------
+    // -------- Area Identity --------
+    int getAreaId() const;
+    const std::string& getAreaName() const;
     int getZoneId() const;
-    std::string getZoneName() const;
 
-    // -------- Parking Area Management --------
-    void addParkingArea(ParkingArea* area);
-    int getTotalParkingAreas() const;
-
-    // -------- Slot Statistics (Zone Level) --------
+    // -------- Slot Management --------
+    ParkingSlot& addSlot(int slotId);   // at most slotCapacity of them
     int getTotalSlots() const;
     int getOccupiedSlots() const;
     int getFreeSlots() const;
-    bool isZoneFull() const;
-
-    // -------- Zone Preference / Cross-Zone Rules --------
-    void addNeighborZone(Zone* zone);
-    bool isNeighborZone(int zoneId) const;
-    bool isCrossZoneAllowed() const;
+    bool isFull() const;
+    int getDrainingSlots() const;   // closed but still holding a vehicle
 
-    // -------- Utilization & Analytics --------
-    double getUtilizationRate() const;
+    // -------- Topology --------
+    bool isRemoved() const;
+    void markRemoved();
 
     // -------- Accessors --------
-    const std::vector<ParkingArea*>& getParkingAreas() const;
+    std::vector<ParkingSlot>& getSlots();
+    const std::vector<ParkingSlot>& getSlots() const;
 };
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef PARKING_OPERATIONS_H
+#define PARKING_OPERATIONS_H
+
+#include "Vehicle.h"
+#include "VehiclePlate.h"
+
+class ParkingRequest;
+
+// The request lifecycle every city implementation offers: park (allocate),
+// occupy, release, cancel, plus the lookups a gate needs to answer.
+// ParkingSystem implements it for the dynamic, server-side city and
+// StaticCity for fixed lots on embedded gate controllers, so gate logic
+// written against this interface runs on either.
+class ParkingOperations {
+public:
+    virtual ~ParkingOperations() {}
+
+    virtual bool createParkingRequest(const VehiclePlate& vehicleNumber,
+                                      Vehicle::VehicleType type,
+                                      int preferredZone,
+                                      int& fee,
+                                      bool& crossZoneUsed) = 0;
+
+    virtual bool createParkingRequestWithArea(const VehiclePlate& vehicleNumber,
+                                              Vehicle::VehicleType type,
+                                              int preferredZone,
+                                              int preferredArea,
+                                              int& fee,
+                                              bool& crossZoneUsed) = 0;
+
+    virtual bool occupyParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) = 0;
+    virtual bool releaseParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) = 0;
+    virtual bool cancelRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) = 0;
+
+    // Latest request of the vehicle, or null
+    virtual const ParkingRequest* lookupRequest(const VehiclePlate& vehicleNumber,
+                                                Vehicle::VehicleType type) const = 0;
+
+    // Free slots in service, city-wide
+    virtual int getFreeSlots() const = 0;
+};
+
+#endif
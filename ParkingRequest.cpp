@@ -1,37 +1,51 @@
 #include "ParkingRequest.h"
+#include "Clock.h"
 
 // -------- Constructor --------
-ParkingRequest::ParkingRequest(int id, const Vehicle& v, int zoneId)
-    : requestId(id),
-      vehicle(v),
+ParkingRequest::ParkingRequest(int id, const Vehicle& v, int zoneId, int64_t requestTimeNanos,
+                               uint8_t required, uint8_t preferred)
+    : requestTime(requestTimeNanos),
+      occupyTime(0),
+      releaseTime(0),
+      charge(0),
+      vehicleNumber(v.getVehicleNumber()),
+      requestId(id),
       requestedZoneId(zoneId),
-      allocatedSlot(nullptr),
-      state(REQUESTED) {
-
-    requestTime = time(nullptr);
-    occupyTime = 0;
-    releaseTime = 0;
-}
+      allocatedSlotId(0),
+      allocatedZoneId(0),
+      allocatedAreaId(0),
+      vehicleType(static_cast<uint8_t>(v.getVehicleType())),
+      state(REQUESTED),
+      requiredAttributes(required),
+      preferredAttributes(preferred) {}
 
 // -------- Identity --------
 int ParkingRequest::getRequestId() const {
     return requestId;
 }
 
-std::string ParkingRequest::getVehicleNumber() const {
-    return vehicle.getVehicleNumber();
+const VehiclePlate& ParkingRequest::getVehicleNumber() const {
+    return vehicleNumber;
 }
 
 Vehicle::VehicleType ParkingRequest::getVehicleType() const {
-    return vehicle.getVehicleType();
+    return static_cast<Vehicle::VehicleType>(vehicleType);
 }
 
 // -------- State --------
 ParkingRequest::RequestState ParkingRequest::getState() const {
-    return state;
+    return static_cast<RequestState>(state);
 }
 
 std::string ParkingRequest::getStateAsString() const {
+    return getStateName();
+}
+
+const char* ParkingRequest::getStateName() const {
+    return stateName(getState());
+}
+
+const char* ParkingRequest::stateName(RequestState state) {
     switch (state) {
         case REQUESTED: return "REQUESTED";
         case ALLOCATED: return "ALLOCATED";
@@ -44,49 +58,81 @@ std::string ParkingRequest::getStateAsString() const {
 
 // -------- Lifecycle --------
 bool ParkingRequest::allocateSlot(ParkingSlot* slot) {
-    if (state != REQUESTED || slot == nullptr || !slot->isAvailable())
+    if (state != REQUESTED || slot == nullptr || !slot->isAvailable() ||
+        !slot->hasAttributes(requiredAttributes))
         return false;
 
-    allocatedSlot = slot;
-    allocatedSlot->markOccupied();
+    allocatedSlotId = slot->getSlotId();
+    allocatedZoneId = slot->getZoneId();
+    allocatedAreaId = static_cast<uint16_t>(slot->getAreaId());
+    slot->markOccupied();
     state = ALLOCATED;
     return true;
 }
 
-bool ParkingRequest::occupy() {
+bool ParkingRequest::occupy(int64_t nowNanos) {
     if (state != ALLOCATED)
         return false;
 
-    occupyTime = time(nullptr);
+    occupyTime = nowNanos;
     state = OCCUPIED;
     return true;
 }
 
-bool ParkingRequest::release() {
-    if (state != OCCUPIED || allocatedSlot == nullptr)
+bool ParkingRequest::release(ParkingSlot* slot, int64_t nowNanos) {
+    if (state != OCCUPIED || slot == nullptr || slot->getSlotId() != allocatedSlotId)
         return false;
 
-    allocatedSlot->markFree();
-    releaseTime = time(nullptr);
+    slot->markFree();
+    releaseTime = nowNanos;
     state = RELEASED;
     return true;
 }
 
-bool ParkingRequest::cancel() {
+bool ParkingRequest::cancel(ParkingSlot* slot) {
     if (state == CANCELLED || state == RELEASED)
         return false;
+    if (allocatedSlotId != 0 && (slot == nullptr || slot->getSlotId() != allocatedSlotId))
+        return false;
 
-    if (allocatedSlot != nullptr && state == ALLOCATED) {
-        allocatedSlot->markFree();
+    if (state == ALLOCATED) {
+        slot->markFree();
     }
 
     state = CANCELLED;
     return true;
 }
 
+// -------- Rollback --------
+bool ParkingRequest::restoreRequested(ParkingSlot* slot) {
+    if (state == CANCELLED && allocatedSlotId == 0) {
+        state = REQUESTED;
+        return true;
+    }
+    if (state != ALLOCATED || slot == nullptr || slot->getSlotId() != allocatedSlotId)
+        return false;
+
+    slot->markFree();
+    allocatedSlotId = 0;
+    allocatedZoneId = 0;
+    allocatedAreaId = 0;
+    state = REQUESTED;
+    return true;
+}
+
+bool ParkingRequest::restoreAllocated(ParkingSlot* slot) {
+    if (state != CANCELLED || allocatedSlotId == 0 || slot == nullptr ||
+        slot->getSlotId() != allocatedSlotId || !slot->isAvailable())
+        return false;
+
+    slot->markOccupied();
+    state = ALLOCATED;
+    return true;
+}
+
 // -------- Slot & Zone --------
-ParkingSlot* ParkingRequest::getAllocatedSlot() const {
-    return allocatedSlot;
+bool ParkingRequest::hasAllocatedSlot() const {
+    return allocatedSlotId != 0;
 }
 
 int ParkingRequest::getRequestedZoneId() const {
@@ -95,33 +141,78 @@ int ParkingRequest::getRequestedZoneId() const {
 
 // NEW: Helper methods for detailed messages
 int ParkingRequest::getAllocatedSlotId() const {
-    return (allocatedSlot != nullptr) ? allocatedSlot->getSlotId() : -1;
+    return allocatedSlotId != 0 ? allocatedSlotId : -1;
 }
 
 int ParkingRequest::getAllocatedZoneId() const {
-    return (allocatedSlot != nullptr) ? allocatedSlot->getZoneId() : -1;
+    return allocatedSlotId != 0 ? allocatedZoneId : -1;
 }
 
 int ParkingRequest::getAllocatedAreaId() const {
-    return (allocatedSlot != nullptr) ? allocatedSlot->getAreaId() : -1;
+    return allocatedSlotId != 0 ? allocatedAreaId : -1;
 }
 
 // -------- Analytics --------
 time_t ParkingRequest::getRequestTime() const {
-    return requestTime;
+    return static_cast<time_t>(requestTime / Clock::NANOS_PER_SECOND);
 }
 
 time_t ParkingRequest::getOccupyTime() const {
-    return occupyTime;
+    return static_cast<time_t>(occupyTime / Clock::NANOS_PER_SECOND);
 }
 
 time_t ParkingRequest::getReleaseTime() const {
+    return static_cast<time_t>(releaseTime / Clock::NANOS_PER_SECOND);
+}
+
+int64_t ParkingRequest::getRequestTimeNanos() const {
+    return requestTime;
+}
+
+int64_t ParkingRequest::getOccupyTimeNanos() const {
+    return occupyTime;
+}
+
+int64_t ParkingRequest::getReleaseTimeNanos() const {
     return releaseTime;
 }
 
 double ParkingRequest::getParkingDurationHours() const {
+    return getDwellSeconds() / 3600.0;
+}
+
+double ParkingRequest::getWaitSeconds() const {
+    if (occupyTime == 0)
+        return 0.0;
+
+    return static_cast<double>(occupyTime - requestTime) / Clock::NANOS_PER_SECOND;
+}
+
+double ParkingRequest::getDwellSeconds() const {
     if (state != RELEASED || occupyTime == 0 || releaseTime == 0)
         return 0.0;
 
-    return difftime(releaseTime, occupyTime) / 3600.0;
+    return static_cast<double>(releaseTime - occupyTime) / Clock::NANOS_PER_SECOND;
+}
+
+// -------- Billing --------
+bool ParkingRequest::isCrossZone() const {
+    return allocatedSlotId != 0 && allocatedZoneId != requestedZoneId;
+}
+
+int64_t ParkingRequest::getCharge() const {
+    return charge;
+}
+
+void ParkingRequest::setCharge(int64_t paisa) {
+    charge = paisa;
+}
+
+// -------- Slot Attributes --------
+uint8_t ParkingRequest::getRequiredAttributes() const {
+    return requiredAttributes;
+}
+
+uint8_t ParkingRequest::getPreferredAttributes() const {
+    return preferredAttributes;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <ctime>
+#include <cstdint>
 #include "Vehicle.h"
 #include "ParkingSlot.h"
 
@@ -17,42 +18,65 @@ public:
     };
 
 private:
-    int requestId;
-    Vehicle vehicle;
-    int requestedZoneId;
+    // Nanoseconds since epoch (from the injected Clock), 0 = not yet
+    int64_t requestTime;
+    int64_t occupyTime;
+    int64_t releaseTime;
 
-    ParkingSlot* allocatedSlot;
-    RequestState state;
+    int64_t charge;   // paisa, priced by the tariff at release
 
-    time_t requestTime;
-    time_t occupyTime;
-    time_t releaseTime;
+    VehiclePlate vehicleNumber;
+    int32_t requestId;
+    int32_t requestedZoneId;   // also the vehicle's preferred zone
+
+    // The slot is referenced by its id, a 32-bit handle into the owner's
+    // slot table; its zone and area are kept for the replies. 0 = none.
+    int32_t allocatedSlotId;
+    int32_t allocatedZoneId;
+    uint16_t allocatedAreaId;
+    uint8_t vehicleType;
+    uint8_t state;
+    uint8_t requiredAttributes;    // ParkingSlot::Attribute flags the slot must have
+    uint8_t preferredAttributes;   // flags wanted if a slot has them free
 
 public:
     // Constructor
-    ParkingRequest(int id, const Vehicle& vehicle, int zoneId);
+    ParkingRequest(int id, const Vehicle& vehicle, int zoneId, int64_t requestTimeNanos,
+                   uint8_t requiredAttributes = 0, uint8_t preferredAttributes = 0);
 
     // -------- Identity --------
     int getRequestId() const;
-    std::string getVehicleNumber() const;
+    const VehiclePlate& getVehicleNumber() const;
     Vehicle::VehicleType getVehicleType() const;
 
     // -------- State --------
     RequestState getState() const;
     std::string getStateAsString() const;
+    const char* getStateName() const;      // same text, no allocation
+    static const char* stateName(RequestState state);
 
     // -------- Lifecycle Actions --------
-    bool allocateSlot(ParkingSlot* slot);
-    bool occupy();
-    bool release();
-    bool cancel();
+    // The owner passes in the slot named by getAllocatedSlotId(); a
+    // different slot is refused
+    bool allocateSlot(ParkingSlot* slot);     // refuses a slot without the required attributes
+    bool occupy(int64_t nowNanos);
+    bool release(ParkingSlot* slot, int64_t nowNanos);
+    bool cancel(ParkingSlot* slot);
+
+    // -------- Rollback --------
+    // Undo an allocation (ALLOCATED -> REQUESTED, frees the slot) or the
+    // cancellation of a request that had no slot (CANCELLED -> REQUESTED)
+    bool restoreRequested(ParkingSlot* slot);
+    // Undo the cancellation of an allocated request (CANCELLED ->
+    // ALLOCATED); refused if its slot has been taken since
+    bool restoreAllocated(ParkingSlot* slot);
 
     // -------- Slot & Zone --------
-    ParkingSlot* getAllocatedSlot() const;
+    bool hasAllocatedSlot() const;
     int getRequestedZoneId() const;
     
     // NEW: Helper methods for detailed messages
-    int getAllocatedSlotId() const;
+    int getAllocatedSlotId() const;        // -1 when none
     int getAllocatedZoneId() const;
     int getAllocatedAreaId() const;
 
@@ -60,7 +84,21 @@ public:
     time_t getRequestTime() const;
     time_t getOccupyTime() const;
     time_t getReleaseTime() const;
+    int64_t getRequestTimeNanos() const;
+    int64_t getOccupyTimeNanos() const;
+    int64_t getReleaseTimeNanos() const;
     double getParkingDurationHours() const;
+    double getWaitSeconds() const;     // request -> occupy (queue time)
+    double getDwellSeconds() const;    // occupy -> release
+
+    // -------- Billing --------
+    bool isCrossZone() const;          // allocated outside the requested zone
+    int64_t getCharge() const;
+    void setCharge(int64_t paisa);
+
+    // -------- Slot Attributes --------
+    uint8_t getRequiredAttributes() const;
+    uint8_t getPreferredAttributes() const;
 };
 
 #endif
\ No newline at end of file
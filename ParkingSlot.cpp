@@ -1,7 +1,69 @@
 #include "ParkingSlot.h"
+#include <cstdio>
+#include <cstring>
+
+static const char* const ATTRIBUTE_NAMES[ParkingSlot::ATTRIBUTE_COUNT] = { "EV", "ACCESSIBLE", "RESERVED" };
 
 ParkingSlot::ParkingSlot(int id, int zId, int aId)
-    : slotId(id), zoneId(zId), areaId(aId), available(true) {}
+    : slotId(id), zoneId(zId), areaId(aId), available(true), inService(true), attributes(0), listener(nullptr) {}
+
+// -------- Attribute names --------
+// Case-insensitive, as protocol keywords are
+static bool nameEquals(const char* text, size_t length, const char* name) {
+    if (std::strlen(name) != length)
+        return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != name[i])
+            return false;
+    }
+    return true;
+}
+
+const char* ParkingSlot::attributeName(Attribute attribute) {
+    for (int bit = 0; bit < ATTRIBUTE_COUNT; bit++)
+        if (attribute == (1 << bit))
+            return ATTRIBUTE_NAMES[bit];
+    return "UNKNOWN";
+}
+
+bool ParkingSlot::parseAttributes(const char* text, size_t length, uint8_t& out) {
+    uint8_t flags = 0;
+    if (nameEquals(text, length, "NONE")) {
+        out = 0;
+        return true;
+    }
+    const char* end = text + length;
+    while (text < end) {
+        const char* comma = static_cast<const char*>(std::memchr(text, ',', end - text));
+        size_t nameLength = (comma ? comma : end) - text;
+        int bit = 0;
+        while (bit < ATTRIBUTE_COUNT && !nameEquals(text, nameLength, ATTRIBUTE_NAMES[bit]))
+            bit++;
+        if (bit == ATTRIBUTE_COUNT)
+            return false;
+        flags |= static_cast<uint8_t>(1 << bit);
+        text += nameLength + (comma ? 1 : 0);
+    }
+    out = flags;
+    return true;
+}
+
+void ParkingSlot::formatAttributes(uint8_t flags, char* out, size_t size) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (int bit = 0; bit < ATTRIBUTE_COUNT; bit++) {
+        if (!(flags & (1 << bit)))
+            continue;
+        int written = std::snprintf(out + used, size - used, "%s%s", used ? "," : "", ATTRIBUTE_NAMES[bit]);
+        if (written < 0 || used + written >= size)
+            return;
+        used += written;
+    }
+    if (used == 0)
+        std::snprintf(out, size, "NONE");
+}
 
 int ParkingSlot::getSlotId() const {
     return slotId;
@@ -16,13 +78,53 @@ int ParkingSlot::getAreaId() const {
 }
 
 bool ParkingSlot::isAvailable() const {
-    return available;
+    return available && inService;
+}
+
+bool ParkingSlot::isOccupied() const {
+    return !available;
+}
+
+bool ParkingSlot::isInService() const {
+    return inService;
 }
 
 void ParkingSlot::markOccupied() {
+    bool changed = available;
     available = false;
+    if (changed && listener)
+        listener->onSlotChanged(*this, false);
 }
 
 void ParkingSlot::markFree() {
+    bool changed = !available;
     available = true;
+    if (changed && listener)
+        listener->onSlotChanged(*this, true);
+}
+
+void ParkingSlot::setInService(bool value) {
+    bool changed = inService != value;
+    inService = value;
+    if (changed && listener)
+        listener->onSlotServiceChanged(*this, value);
+}
+
+uint8_t ParkingSlot::getAttributes() const {
+    return attributes;
+}
+
+bool ParkingSlot::hasAttributes(uint8_t mask) const {
+    return (attributes & mask) == mask;
+}
+
+void ParkingSlot::setAttributes(uint8_t value) {
+    uint8_t before = attributes;
+    attributes = value & ALL_ATTRIBUTES;
+    if (before != attributes && listener)
+        listener->onSlotAttributesChanged(*this, before);
+}
+
+void ParkingSlot::setListener(SlotListener* l) {
+    listener = l;
 }
\ No newline at end of file
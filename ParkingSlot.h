@@ -1,12 +1,50 @@
 #ifndef PARKING_SLOT_H
 #define PARKING_SLOT_H
 
+#include <cstddef>
+#include <cstdint>
+
+class ParkingSlot;
+
+// Notified whenever a slot actually changes between free and taken,
+// whichever path caused it (allocation, release, cancel, rollback).
+class SlotListener {
+public:
+    virtual ~SlotListener() {}
+    virtual void onSlotChanged(const ParkingSlot& slot, bool available) = 0;
+
+    // The slot was taken out of service or put back (topology changes)
+    virtual void onSlotServiceChanged(const ParkingSlot& /*slot*/, bool /*inService*/) {}
+
+    // The slot's attribute flags changed from `before`
+    virtual void onSlotAttributesChanged(const ParkingSlot& /*slot*/, uint8_t /*before*/) {}
+};
+
 class ParkingSlot {
+public:
+    // Attribute flags; a slot has any combination of them
+    enum Attribute : uint8_t {
+        EV_CHARGER = 1,
+        ACCESSIBLE = 2,
+        RESERVED   = 4        // permit holders only: never given to a request that does not need it
+    };
+    static const int ATTRIBUTE_COUNT = 3;
+    static const uint8_t ALL_ATTRIBUTES = (1 << ATTRIBUTE_COUNT) - 1;
+
+    static const char* attributeName(Attribute attribute);   // "EV", "ACCESSIBLE", "RESERVED"
+
+    // "EV,ACCESSIBLE" style list (or "NONE") <-> flags; parse fails on an unknown name
+    static bool parseAttributes(const char* text, size_t length, uint8_t& attributes);
+    static void formatAttributes(uint8_t attributes, char* out, size_t size);
+
 private:
     int slotId;
     int zoneId;
     int areaId;
-    bool available;
+    bool available;           // holds no vehicle
+    bool inService;           // may be allocated; false = closed (or draining while occupied)
+    uint8_t attributes;       // Attribute flags
+    SlotListener* listener;   // not owned, may be null
 
 public:
     ParkingSlot(int slotId, int zoneId, int areaId);
@@ -15,9 +53,22 @@ public:
     int getZoneId() const;
     int getAreaId() const;
     
-    bool isAvailable() const;
+    bool isAvailable() const;     // free and in service
+    bool isOccupied() const;      // holds a vehicle, in service or not
+    bool isInService() const;
     void markOccupied();
     void markFree();
+
+    // A closed slot is never allocated; an occupied one keeps its
+    // vehicle until released (draining) and then stays closed
+    void setInService(bool inService);
+
+    // -------- Attributes --------
+    uint8_t getAttributes() const;
+    bool hasAttributes(uint8_t mask) const;   // every flag of mask is set
+    void setAttributes(uint8_t attributes);
+
+    void setListener(SlotListener* l);
 };
 
 #endif
\ No newline at end of file
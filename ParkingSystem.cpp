@@ -1,18 +1,28 @@
 #include "ParkingSystem.h"
+#include "Metrics.h"
+#include "SpanTracer.h"
 #include <iostream>
 #include <algorithm>  // For std::max
+#include <chrono>
 
 // -------- Constructor --------
-ParkingSystem::ParkingSystem() : nextRequestId(1) {
+ParkingSystem::ParkingSystem() : ParkingSystem(CityLayout(), nullptr) {}
+
+ParkingSystem::ParkingSystem(Clock* c) : ParkingSystem(CityLayout(), c) {}
+
+ParkingSystem::ParkingSystem(const CityLayout& l, Clock* c)
+    : layout(l), searchHistoryDepth(1000), rollbackManager(this), clock(c ? c : &defaultClock), nextRequestId(1),
+      analytics(l.zoneCount, l.areasPerZone, l.slotsPerArea),
+      freeIndex(l.zoneCount, l.areasPerZone, l.slotsPerArea),
+      attributeIndex(l.zoneCount, l.areasPerZone, l.slotsPerArea),
+      batchDepth(0), snapshotPending(false), regionUpdating(false) {
     initializeCity();
-    allocationEngine = new AllocationEngine(zones, &rollbackManager);
+    allocationEngine = new AllocationEngine(zones, attributeIndex);
 }
 
 // -------- Destructor --------
 ParkingSystem::~ParkingSystem() {
     for (auto z : zones) delete z;
-    for (auto v : vehicles) delete v;
-    for (auto r : requests) delete r;
     delete allocationEngine;
 }
 
@@ -20,17 +30,16 @@ ParkingSystem::~ParkingSystem() {
 void ParkingSystem::initializeCity() {
     int slotIdCounter = 1;
 
-    for (int z = 1; z <= 15; z++) {
-        Zone* zone = new Zone(z, "Zone-" + std::to_string(z));
+    for (int z = 1; z <= layout.zoneCount; z++) {
+        Zone* zone = new Zone(z, "Zone-" + std::to_string(z), layout.areasPerZone);
 
-        for (int a = 1; a <= 3; a++) {
-            ParkingArea* area = new ParkingArea(a, "Area-" + std::to_string(a), z);
+        for (int a = 1; a <= layout.areasPerZone; a++) {
+            ParkingArea& area = zone->addParkingArea(a, "Area-" + std::to_string(a), layout.slotsPerArea);
 
-            for (int s = 1; s <= 20; s++) {
-                ParkingSlot* slot = new ParkingSlot(slotIdCounter++, z, a);
-                area->addSlot(slot);
+            for (int s = 1; s <= layout.slotsPerArea; s++) {
+                ParkingSlot& slot = area.addSlot(slotIdCounter++);
+                slot.setListener(this);
             }
-            zone->addParkingArea(area);
         }
         zones.push_back(zone);
     }
@@ -44,45 +53,97 @@ Zone* ParkingSystem::findZoneById(int zoneId) {
     return nullptr;
 }
 
-bool ParkingSystem::vehicleExists(const std::string& number, Vehicle::VehicleType type) {
-    for (auto v : vehicles)
-        if (v->getVehicleNumber() == number && v->getVehicleType() == type)
-            return true;
-    return false;
+uint32_t ParkingSystem::findHandle(const VehiclePlate& number, Vehicle::VehicleType type) const {
+    return plateIndex.find(PlateIndex::keyHash(number, type), [&](uint32_t handle) {
+        if (handle & REFUSED) {
+            const Vehicle& vehicle = refusedVehicles[handle & ~REFUSED];
+            return vehicle.getVehicleType() == type && vehicle.getVehicleNumber() == number;
+        }
+        const ParkingRequest& request = requests[handle];
+        return request.getVehicleType() == type && request.getVehicleNumber() == number;
+    });
 }
 
-ParkingRequest* ParkingSystem::findRequestByVehicle(const std::string& number, Vehicle::VehicleType type) {
-    for (auto r : requests)
-        if (r->getVehicleNumber() == number && r->getVehicleType() == type)
-            return r;
-    return nullptr;
+bool ParkingSystem::vehicleExists(const VehiclePlate& number, Vehicle::VehicleType type) const {
+    return findHandle(number, type) != PlateIndex::NONE;
 }
 
-// -------- Create Request (Auto Allocation) --------
-bool ParkingSystem::createParkingRequest(const std::string& vehicleNumber,
-                                         Vehicle::VehicleType type,
-                                         int preferredZone,
-                                         int& fee,
-                                         bool& crossZoneUsed) {
+ParkingRequest* ParkingSystem::findRequestByVehicle(const VehiclePlate& number, Vehicle::VehicleType type,
+                                                    uint32_t* handleOut) {
+    METRICS_SCOPE(METRIC_LOOKUP);
+    TRACE_SPAN(lookupSpan, "lookup");
+    uint32_t handle = findHandle(number, type);
+    if (handle == PlateIndex::NONE || (handle & REFUSED))
+        return nullptr;
+
+    METRICS_SUCCESS();
+    if (handleOut)
+        *handleOut = handle;
+    return &requests[handle];
+}
+
+// -------- Create Request (shared by every PARK variant) --------
+bool ParkingSystem::createRequest(const VehiclePlate& vehicleNumber,
+                                  Vehicle::VehicleType type,
+                                  int preferredZone,
+                                  int preferredArea,
+                                  uint8_t requiredAttributes,
+                                  uint8_t preferredAttributes,
+                                  int& fee,
+                                  bool& crossZoneUsed) {
+    METRICS_SCOPE(METRIC_ALLOCATE);
+    TRACE_REQUEST(requestSpan, "PARK");
 
-    if (vehicleExists(vehicleNumber, type)) {
+    if (!vehicleNumber.isValid()) {
+        std::cout << "❌ Invalid vehicle number (1-" << VehiclePlate::CAPACITY << " characters)\n";
+        return false;
+    }
+
+    TRACE_SPAN(duplicateSpan, "duplicateCheck");
+    bool duplicate = vehicleExists(vehicleNumber, type);
+    TRACE_END(duplicateSpan);
+    if (duplicate) {
         std::cout << "❌ Vehicle already exists in system\n";
         return false;
     }
 
-    Vehicle* vehicle = new Vehicle(vehicleNumber, type, preferredZone);
-    vehicles.push_back(vehicle);
+    // Validate area
+    if (preferredArea != ANY_AREA && (preferredArea < 1 || preferredArea > layout.areasPerZone)) {
+        std::cout << "❌ Invalid parking area. Must be between 1-" << layout.areasPerZone << "\n";
+        return false;
+    }
 
-    ParkingRequest* request = new ParkingRequest(nextRequestId++, *vehicle, preferredZone);
+    Vehicle vehicle(vehicleNumber, type, preferredZone);
+    uint32_t handle = static_cast<uint32_t>(requests.size());
+    requests.emplace_back(nextRequestId++, vehicle, preferredZone, clock->nowNanos(),
+                          requiredAttributes, preferredAttributes);
+    ParkingRequest* request = &requests.back();
 
-    if (!allocationEngine->allocateSlot(*request, fee, crossZoneUsed)) {
-        std::cout << "❌ No slots available in any zone\n";
+    TRACE_SPAN(allocateSpan, "allocate");
+    bool allocated = preferredArea == ANY_AREA
+                   ? allocationEngine->allocateSlot(*request, fee, crossZoneUsed)
+                   : allocationEngine->allocateSlotWithArea(*request, preferredArea, fee, crossZoneUsed);
+    TRACE_END(allocateSpan);
+    if (!allocated) {
+        if (requiredAttributes != 0)
+            std::cout << "❌ No slot with the required attributes available\n";
+        else if (preferredArea == ANY_AREA)
+            std::cout << "❌ No slots available in any zone\n";
+        else
+            std::cout << "❌ No slots available in the selected area/zone\n";
+        requests.pop_back();
+        refusedVehicles.push_back(vehicle);
+        plateIndex.insert(PlateIndex::keyHash(vehicleNumber, type),
+                          REFUSED | static_cast<uint32_t>(refusedVehicles.size() - 1));
         return false;
     }
 
-    requests.push_back(request);
+    plateIndex.insert(PlateIndex::keyHash(vehicleNumber, type), handle);
+    plateSearch.insert(vehicleNumber, handle, true);
+    rollbackManager.recordAllocation(handle, *request);
 
     // Detailed success message
+    TRACE_SPAN(outputSpan, "output");
     std::cout << "✅ Vehicle " << vehicleNumber 
               << " successfully allocated slot " << request->getAllocatedSlotId()
               << " in zone " << request->getAllocatedZoneId()
@@ -92,62 +153,59 @@ bool ParkingSystem::createParkingRequest(const std::string& vehicleNumber,
     if (crossZoneUsed) {
         std::cout << "⚠ Cross-zone allocation penalty applied\n";
     }
+    if (!findSlot(request->getAllocatedSlotId())->hasAttributes(preferredAttributes & ~ParkingSlot::RESERVED)) {
+        std::cout << "⚠ Preferred slot attributes unavailable\n";
+    }
     
+    publishSnapshot(request);
+    METRICS_SUCCESS();
     return true;
 }
 
+// -------- Create Request (Auto Allocation) --------
+bool ParkingSystem::createParkingRequest(const VehiclePlate& vehicleNumber,
+                                         Vehicle::VehicleType type,
+                                         int preferredZone,
+                                         int& fee,
+                                         bool& crossZoneUsed) {
+    return createRequest(vehicleNumber, type, preferredZone, ANY_AREA, 0, 0, fee, crossZoneUsed);
+}
+
 // -------- Create Request With Specific Area --------
-bool ParkingSystem::createParkingRequestWithArea(const std::string& vehicleNumber,
+bool ParkingSystem::createParkingRequestWithArea(const VehiclePlate& vehicleNumber,
                                                  Vehicle::VehicleType type,
                                                  int preferredZone,
                                                  int preferredArea,
                                                  int& fee,
                                                  bool& crossZoneUsed) {
+    return createRequest(vehicleNumber, type, preferredZone, preferredArea, 0, 0, fee, crossZoneUsed);
+}
 
-    if (vehicleExists(vehicleNumber, type)) {
-        std::cout << "❌ Vehicle already exists in system\n";
-        return false;
-    }
-
-    // Validate area
-    if (preferredArea < 1 || preferredArea > 3) {
-        std::cout << "❌ Invalid parking area. Must be between 1-3\n";
-        return false;
-    }
-
-    Vehicle* vehicle = new Vehicle(vehicleNumber, type, preferredZone);
-    vehicles.push_back(vehicle);
-
-    ParkingRequest* request = new ParkingRequest(nextRequestId++, *vehicle, preferredZone);
-
-    if (!allocationEngine->allocateSlotWithArea(*request, preferredArea, fee, crossZoneUsed)) {
-        std::cout << "❌ No slots available in the selected area/zone\n";
-        return false;
-    }
-
-    requests.push_back(request);
-
-    // Detailed success message
-    std::cout << "✅ Vehicle " << vehicleNumber 
-              << " successfully allocated slot " << request->getAllocatedSlotId()
-              << " in zone " << request->getAllocatedZoneId()
-              << " and area " << request->getAllocatedAreaId()
-              << " | Fee: Rs " << fee << "\n";
-    
-    if (crossZoneUsed) {
-        std::cout << "⚠ Cross-zone allocation penalty applied\n";
-    }
-    
-    return true;
+// -------- Create Request With Slot Attributes --------
+bool ParkingSystem::createParkingRequestWithAttributes(const VehiclePlate& vehicleNumber,
+                                                       Vehicle::VehicleType type,
+                                                       int preferredZone,
+                                                       int preferredArea,
+                                                       uint8_t requiredAttributes,
+                                                       uint8_t preferredAttributes,
+                                                       int& fee,
+                                                       bool& crossZoneUsed) {
+    return createRequest(vehicleNumber, type, preferredZone, preferredArea == 0 ? ANY_AREA : preferredArea,
+                         requiredAttributes & ParkingSlot::ALL_ATTRIBUTES,
+                         preferredAttributes & ParkingSlot::ALL_ATTRIBUTES, fee, crossZoneUsed);
 }
 
 // -------- Occupy --------
-bool ParkingSystem::occupyParking(const std::string& vehicleNumber, Vehicle::VehicleType type) {
+bool ParkingSystem::occupyParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) {
+    METRICS_SCOPE(METRIC_OCCUPY);
+    TRACE_REQUEST(requestSpan, "OCCUPY");
     ParkingRequest* req = findRequestByVehicle(vehicleNumber, type);
-    if (!req || !req->occupy()) {
+    if (!req || !req->occupy(clock->nowNanos())) {
         std::cout << "❌ Vehicle " << vehicleNumber << " not allocated or cannot occupy\n";
         return false;
     }
+    analytics.recordWait(req->getAllocatedZoneId(),
+                         req->getOccupyTimeNanos() - req->getRequestTimeNanos());
     
     // Detailed success message
     std::cout << "✅ Vehicle " << vehicleNumber 
@@ -155,57 +213,165 @@ bool ParkingSystem::occupyParking(const std::string& vehicleNumber, Vehicle::Veh
               << " in zone " << req->getAllocatedZoneId()
               << " and area " << req->getAllocatedAreaId() << "\n";
     
+    publishSnapshot(req);
+    METRICS_SUCCESS();
     return true;
 }
 
 // -------- Release --------
-bool ParkingSystem::releaseParking(const std::string& vehicleNumber, Vehicle::VehicleType type) {
-    ParkingRequest* req = findRequestByVehicle(vehicleNumber, type);
-    if (!req || !req->release()) {
+bool ParkingSystem::releaseParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) {
+    METRICS_SCOPE(METRIC_RELEASE);
+    TRACE_REQUEST(requestSpan, "RELEASE");
+    uint32_t handle = 0;
+    ParkingRequest* req = findRequestByVehicle(vehicleNumber, type, &handle);
+    if (!req || !req->release(findSlot(req->getAllocatedSlotId()), clock->nowNanos())) {
         std::cout << "❌ Release failed for vehicle " << vehicleNumber 
                   << " - not in system or not occupied\n";
         return false;
     }
+    analytics.recordDwell(req->getAllocatedZoneId(),
+                          req->getReleaseTimeNanos() - req->getOccupyTimeNanos());
+    req->setCharge(tariff.price(req->getAllocatedZoneId(), req->getVehicleType(), req->isCrossZone(),
+                                req->getOccupyTimeNanos(), req->getReleaseTimeNanos()));
+    retireFromSearch(handle);
     
     // Detailed success message
     std::cout << "✅ Vehicle " << vehicleNumber 
               << " successfully released slot " << req->getAllocatedSlotId()
               << " from zone " << req->getAllocatedZoneId()
-              << " and area " << req->getAllocatedAreaId() << "\n";
+              << " and area " << req->getAllocatedAreaId()
+              << " | Charge: Rs " << req->getCharge() / 100.0 << "\n";
     
+    publishSnapshot(req);
+    METRICS_SUCCESS();
     return true;
 }
 
 // -------- Cancel --------
-bool ParkingSystem::cancelRequest(const std::string& vehicleNumber, Vehicle::VehicleType type) {
-    ParkingRequest* req = findRequestByVehicle(vehicleNumber, type);
-    if (!req || !req->cancel()) {
+bool ParkingSystem::cancelRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) {
+    METRICS_SCOPE(METRIC_CANCEL);
+    TRACE_REQUEST(requestSpan, "CANCEL");
+    uint32_t handle = 0;
+    ParkingRequest* req = findRequestByVehicle(vehicleNumber, type, &handle);
+    if (!req || !req->cancel(findSlot(req->getAllocatedSlotId()))) {
         std::cout << "❌ Cancellation failed for vehicle " << vehicleNumber 
                   << " - not in system or cannot be cancelled\n";
         return false;
     }
 
-    rollbackManager.recordCancellation(req);
+    rollbackManager.recordCancellation(handle, *req);
+    retireFromSearch(handle);
     
     // Detailed success message
     std::cout << "✅ Vehicle " << vehicleNumber 
               << " successfully cancelled request for slot " << req->getAllocatedSlotId()
               << " in zone " << req->getAllocatedZoneId() << "\n";
     
+    publishSnapshot(req);
+    METRICS_SUCCESS();
     return true;
 }
 
 // -------- Rollback --------
 bool ParkingSystem::rollbackLast(int k) {
-    if (rollbackManager.rollbackK(k)) {
+    METRICS_SCOPE(METRIC_ROLLBACK);
+    TRACE_REQUEST(requestSpan, "ROLLBACK");
+    int undone = rollbackManager.rollbackK(k);
+    if (undone > 0)
+        publishSnapshot(nullptr);
+    if (undone == k) {
+        METRICS_SUCCESS();
         std::cout << "✅ Successfully rolled back " << k << " operation(s)\n";
         return true;
+    } else if (undone > 0) {
+        std::cout << "❌ Rollback stopped after " << undone << " of " << k
+                  << " operation(s) - the next request has moved on\n";
+        return false;
     } else {
-        std::cout << "❌ Rollback failed - not enough operations to rollback\n";
+        std::cout << "❌ Rollback failed - not enough operations to rollback, or the request has moved on\n";
         return false;
     }
 }
 
+// -------- Plate Search --------
+void ParkingSystem::searchPlates(const VehiclePlate& query, bool prefix, int maxEdits, size_t limit,
+                                 std::vector<PlateMatch>& out) const {
+    plateSearch.search(query, prefix, maxEdits, limit, out);
+}
+
+void ParkingSystem::setSearchHistoryDepth(int depth) {
+    searchHistoryDepth = static_cast<size_t>(std::max(depth, 0));
+    trimSearchHistory();
+}
+
+void ParkingSystem::trimSearchHistory() {
+    while (searchHistory.size() > searchHistoryDepth) {
+        uint32_t oldest = searchHistory.front();
+        searchHistory.pop_front();
+        plateSearch.remove(requests[oldest].getVehicleNumber(), oldest);
+    }
+}
+
+// A finished request stays searchable until searchHistoryDepth newer
+// ones have finished
+void ParkingSystem::retireFromSearch(uint32_t handle) {
+    if (!plateSearch.setActive(requests[handle].getVehicleNumber(), handle, false))
+        return;
+    searchHistory.push_back(handle);
+    trimSearchHistory();
+}
+
+// -------- Audit --------
+AuditReport ParkingSystem::audit(bool repair, int threads, int fromZone, int toZone) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    AuditReport report;
+    CityAudit auditor(*this, threads);
+    auditor.claimSlots(report);
+
+    // Slots first: repairing them goes through onSlotChanged like any
+    // transition, and the counters are recounted afterwards
+    auditor.checkSlots(report, fromZone, toZone);
+    if (repair)
+        repairAudit(report, 0);
+    size_t counters = report.issues.size();
+    auditor.checkCounters(report, fromZone, toZone);
+    if (repair)
+        repairAudit(report, counters);
+
+    report.millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+int ParkingSystem::repairAudit(AuditReport& report, size_t firstIssue) {
+    int repaired = 0;
+    int64_t now = clock->nowNanos();
+    beginBatch();
+    for (size_t i = firstIssue; i < report.issues.size(); i++) {
+        AuditIssue& issue = report.issues[i];
+        int z = issue.zoneId, a = issue.areaId;
+        switch (issue.kind) {
+            case AuditIssue::ORPHANED_SLOT:    findSlot(issue.slotId)->markFree(); break;
+            case AuditIssue::FREE_SLOT_IN_USE: findSlot(issue.slotId)->markOccupied(); break;
+            case AuditIssue::FREE_COUNT:       freeIndex.correct(z, a, issue.expected); break;
+            case AuditIssue::OCCUPIED_COUNT:
+                analytics.correct(z, a, issue.expected, analytics.getCapacity(z, a), now);
+                break;
+            case AuditIssue::CAPACITY_COUNT:
+                analytics.correct(z, a, analytics.getOccupied(z, a), issue.expected, now);
+                break;
+            default:
+                continue;
+        }
+        issue.repaired = true;
+        repaired++;
+    }
+    report.repaired += repaired;
+    if (repaired > 0)
+        publishSnapshot(nullptr);
+    endBatch();
+    return repaired;
+}
+
 // -------- Display Zone Status --------
 void ParkingSystem::displayZoneStatus() const {
     std::cout << "\n========== ZONE STATUS ==========\n";
@@ -232,7 +398,7 @@ void ParkingSystem::displayLastOperations(int count) const {
     int shown = 0;
     
     for (int i = requests.size() - 1; i >= start && shown < count; i--, shown++) {
-        ParkingRequest* req = requests[i];
+        const ParkingRequest* req = &requests[i];
         
         std::cout << "Operation #" << (shown + 1) << ":\n";
         std::cout << "  Vehicle: " << req->getVehicleNumber() << "\n";
@@ -263,6 +429,7 @@ void ParkingSystem::displayLastOperations(int count) const {
                 if (hours > 0) std::cout << hours << "h ";
                 if (minutes > 0) std::cout << minutes << "m ";
                 std::cout << seconds << "s)\n";
+                std::cout << "  Charge: Rs " << req->getCharge() / 100.0 << "\n";
             }
         }
         
@@ -270,6 +437,7 @@ void ParkingSystem::displayLastOperations(int count) const {
         if (req->getOccupyTime() > 0) {
             time_t occTime = req->getOccupyTime();
             std::cout << "  Occupied: " << ctime(&occTime);
+            std::cout << "  Waited: " << req->getWaitSeconds() << " s\n";
         }
         
         // Show release time if released
@@ -280,4 +448,399 @@ void ParkingSystem::displayLastOperations(int count) const {
         
         std::cout << "-----------------------------------\n";
     }
-}
\ No newline at end of file
+}
+
+// -------- Read Access --------
+const std::vector<Zone*>& ParkingSystem::getZones() const {
+    return zones;
+}
+
+const std::deque<ParkingRequest>& ParkingSystem::getRequests() const {
+    return requests;
+}
+
+const Clock& ParkingSystem::getClock() const {
+    return *clock;
+}
+
+const CityLayout& ParkingSystem::getLayout() const {
+    return layout;
+}
+
+const ParkingRequest* ParkingSystem::lookupRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) const {
+    uint32_t handle = findHandle(vehicleNumber, type);
+    if (handle == PlateIndex::NONE || (handle & REFUSED))
+        return nullptr;
+    return &requests[handle];
+}
+
+ParkingSlot* ParkingSystem::findSlot(int slotId) const {
+    int index = slotId - 1;
+    if (index < 0 || index >= layout.getTotalSlots())
+        return nullptr;
+
+    int area = index / layout.slotsPerArea;
+    Zone* zone = zones[area / layout.areasPerZone];
+    return &zone->getParkingAreas()[area % layout.areasPerZone].getSlots()[index % layout.slotsPerArea];
+}
+
+int ParkingSystem::getFreeSlots() const {
+    return static_cast<int>(freeIndex.sumFree(1, 0));
+}
+
+// -------- Billing --------
+TariffEngine& ParkingSystem::getTariff() {
+    return tariff;
+}
+
+const TariffEngine& ParkingSystem::getTariff() const {
+    return tariff;
+}
+
+void ParkingSystem::collectSessions(int64_t fromNanos, int64_t toNanos, SessionColumns& out) const {
+    for (const auto& req : requests) {
+        if (req.getState() != ParkingRequest::RELEASED)
+            continue;
+        int64_t released = req.getReleaseTimeNanos();
+        if (released < fromNanos || released >= toNanos)
+            continue;
+        out.add(req.getAllocatedZoneId(), req.getVehicleType(), req.isCrossZone(),
+                req.getOccupyTimeNanos() / Clock::NANOS_PER_SECOND, released / Clock::NANOS_PER_SECOND);
+    }
+}
+
+const OccupancyAnalytics& ParkingSystem::getAnalytics() const {
+    return analytics;
+}
+
+const FreeCapacityIndex& ParkingSystem::getFreeIndex() const {
+    return freeIndex;
+}
+
+const SlotAttributeIndex& ParkingSystem::getAttributeIndex() const {
+    return attributeIndex;
+}
+
+const StatusChangeLog& ParkingSystem::getChangeLog() const {
+    return changeLog;
+}
+
+// -------- Slot Transitions --------
+void ParkingSystem::onSlotChanged(const ParkingSlot& slot, bool available) {
+    int64_t now = clock->nowNanos();
+    analytics.recordSlotChange(slot.getZoneId(), slot.getAreaId(), available, now);
+    if (slot.isInService()) {
+        freeIndex.recordSlotChange(slot.getZoneId(), slot.getAreaId(), available);
+        attributeIndex.recordSlotChange(slot, available);
+    } else {
+        // A closed slot counts towards capacity only while it drains a vehicle
+        analytics.adjustCapacity(slot.getZoneId(), slot.getAreaId(), available ? -1 : 1);
+    }
+    changeLog.record(&slot);
+    publishSlot(slot, now);
+}
+
+void ParkingSystem::onSlotServiceChanged(const ParkingSlot& slot, bool inService) {
+    if (!slot.isOccupied()) {
+        freeIndex.recordSlotChange(slot.getZoneId(), slot.getAreaId(), inService);
+        attributeIndex.recordSlotChange(slot, inService);
+        analytics.adjustCapacity(slot.getZoneId(), slot.getAreaId(), inService ? 1 : -1);
+    }
+    changeLog.record(&slot);
+    publishSlot(slot, clock->nowNanos());
+}
+
+// Attributes are not part of the published status, only of allocation
+void ParkingSystem::onSlotAttributesChanged(const ParkingSlot& slot, uint8_t before) {
+    attributeIndex.recordAttributeChange(slot, before);
+}
+
+void ParkingSystem::publishSlot(const ParkingSlot& slot, int64_t nowNanos) {
+    if (!statusRegion.isOpen())
+        return;
+
+    if (!regionUpdating)
+        statusRegion.beginUpdate();
+    statusRegion.setSlot(slot.getSlotId(), slot.getZoneId(), slot.getAreaId(), slot.isAvailable());
+    if (batchDepth > 0)
+        regionUpdating = true;    // closed by endBatch
+    else
+        statusRegion.endUpdate(changeLog.getVersion(), nowNanos);
+}
+
+// -------- Snapshots --------
+// Runs on the writer after every successful operation. `changed` is the
+// one request the operation touched; nullptr (rollback, first publish)
+// rebuilds the history window. Counters come from the free-capacity
+// index, so a publish is O(zones x areas) plus one copy of the window.
+// Inside a batch only the window is updated; endBatch publishes.
+void ParkingSystem::publishSnapshot(const ParkingRequest* changed) {
+    if (!snapshots.isEnabled())
+        return;
+
+    if (changed) {
+        snapshots.recordHistory(HistoryEntry::capture(*changed));
+    } else {
+        snapshots.clearHistory();
+        int depth = snapshots.getHistoryDepth();
+        for (int i = static_cast<int>(requests.size()) - 1, n = 0; i >= 0 && n < depth; i--, n++)
+            snapshots.appendHistory(HistoryEntry::capture(requests[i]));
+    }
+
+    if (batchDepth > 0)
+        snapshotPending = true;
+    else
+        buildSnapshot();
+}
+
+void ParkingSystem::buildSnapshot() {
+    CitySnapshot* next = snapshots.prepare();
+    next->changeVersion = changeLog.getVersion();
+    next->publishedNanos = clock->nowNanos();
+    next->totalSlots = analytics.getCapacity(0, 0);
+    next->freeSlots = 0;
+
+    for (int z = 1; z <= layout.zoneCount; z++) {
+        ZoneCounters zone = { z, analytics.getCapacity(z, 0), freeIndex.getZoneFree(z) };
+        next->zones.push_back(zone);
+        next->freeSlots += zone.freeSlots;
+        for (int a = 1; a <= layout.areasPerZone; a++) {
+            AreaCounters area = { z, a, analytics.getCapacity(z, a), freeIndex.getAreaFree(z, a) };
+            next->areas.push_back(area);
+        }
+    }
+
+    snapshots.publish(next);
+}
+
+void ParkingSystem::enableSnapshots(int historyDepth) {
+    snapshots.enable(historyDepth);
+    publishSnapshot(nullptr);
+}
+
+const CitySnapshots& ParkingSystem::getSnapshots() const {
+    return snapshots;
+}
+
+// -------- Topology --------
+ParkingArea* ParkingSystem::findArea(int zoneId, int areaId) const {
+    if (zoneId < 1 || zoneId > static_cast<int>(zones.size()))
+        return nullptr;
+    std::vector<ParkingArea>& areas = zones[zoneId - 1]->getParkingAreas();
+    if (areaId < 1 || areaId > static_cast<int>(areas.size()) || areas[areaId - 1].isRemoved())
+        return nullptr;
+    return &areas[areaId - 1];
+}
+
+// The listener callbacks do the index, analytics, change-log and status
+// region work per slot; the batch publishes the region and snapshot once.
+int ParkingSystem::setSlotsInService(ParkingArea* area, int fromSlot, int toSlot, bool inService) {
+    std::vector<ParkingSlot>& slots = area->getSlots();
+    int count = static_cast<int>(slots.size());
+    if (fromSlot < 1) fromSlot = 1;
+    if (toSlot <= 0 || toSlot > count) toSlot = count;
+
+    int changed = 0;
+    beginBatch();
+    for (int s = fromSlot; s <= toSlot; s++) {
+        if (slots[s - 1].isInService() != inService) {
+            slots[s - 1].setInService(inService);
+            changed++;
+        }
+    }
+    if (changed > 0 && snapshots.isEnabled())
+        snapshotPending = true;
+    endBatch();
+    return changed;
+}
+
+int ParkingSystem::closeSlots(int zoneId, int areaId, int fromSlot, int toSlot) {
+    ParkingArea* area = findArea(zoneId, areaId);
+    return area ? setSlotsInService(area, fromSlot, toSlot, false) : -1;
+}
+
+int ParkingSystem::openSlots(int zoneId, int areaId, int fromSlot, int toSlot) {
+    ParkingArea* area = findArea(zoneId, areaId);
+    return area ? setSlotsInService(area, fromSlot, toSlot, true) : -1;
+}
+
+int ParkingSystem::setSlotAttributes(int zoneId, int areaId, int fromSlot, int toSlot, uint8_t attributes) {
+    ParkingArea* area = findArea(zoneId, areaId);
+    if (!area)
+        return -1;
+
+    std::vector<ParkingSlot>& slots = area->getSlots();
+    int count = static_cast<int>(slots.size());
+    if (fromSlot < 1) fromSlot = 1;
+    if (toSlot <= 0 || toSlot > count) toSlot = count;
+
+    attributes &= ParkingSlot::ALL_ATTRIBUTES;
+    int changed = 0;
+    for (int s = fromSlot; s <= toSlot; s++) {
+        if (slots[s - 1].getAttributes() != attributes) {
+            slots[s - 1].setAttributes(attributes);
+            changed++;
+        }
+    }
+    return changed;
+}
+
+int ParkingSystem::closeArea(int zoneId, int areaId) {
+    return closeSlots(zoneId, areaId);
+}
+
+int ParkingSystem::openArea(int zoneId, int areaId) {
+    return openSlots(zoneId, areaId);
+}
+
+int ParkingSystem::closeZone(int zoneId) {
+    if (zoneId < 1 || zoneId > static_cast<int>(zones.size()) || zones[zoneId - 1]->isRemoved())
+        return -1;
+
+    int changed = 0;
+    beginBatch();
+    for (auto& area : zones[zoneId - 1]->getParkingAreas())
+        if (!area.isRemoved())
+            changed += setSlotsInService(&area, 1, 0, false);
+    endBatch();
+    return changed;
+}
+
+int ParkingSystem::openZone(int zoneId) {
+    if (zoneId < 1 || zoneId > static_cast<int>(zones.size()) || zones[zoneId - 1]->isRemoved())
+        return -1;
+
+    int changed = 0;
+    beginBatch();
+    for (auto& area : zones[zoneId - 1]->getParkingAreas())
+        if (!area.isRemoved())
+            changed += setSlotsInService(&area, 1, 0, true);
+    endBatch();
+    return changed;
+}
+
+int ParkingSystem::removeArea(int zoneId, int areaId) {
+    ParkingArea* area = findArea(zoneId, areaId);
+    if (!area)
+        return -1;
+
+    int changed = setSlotsInService(area, 1, 0, false);
+    area->markRemoved();
+    return changed;
+}
+
+int ParkingSystem::removeZone(int zoneId) {
+    int changed = closeZone(zoneId);
+    if (changed < 0)
+        return -1;
+
+    Zone* zone = zones[zoneId - 1];
+    for (auto& area : zone->getParkingAreas())
+        area.markRemoved();
+    std::vector<int> neighbors = zone->getNeighborZones();
+    for (int neighborId : neighbors) {
+        if (neighborId >= 1 && neighborId <= static_cast<int>(zones.size()))
+            zones[neighborId - 1]->removeNeighborZone(zoneId);
+        zone->removeNeighborZone(neighborId);
+    }
+    zone->markRemoved();
+    return changed;
+}
+
+int ParkingSystem::addZone() {
+    int z = layout.zoneCount + 1;
+    int slotId = layout.getTotalSlots() + 1;
+
+    beginBatch();
+    Zone* zone = new Zone(z, "Zone-" + std::to_string(z), layout.areasPerZone);
+    for (int a = 1; a <= layout.areasPerZone; a++) {
+        ParkingArea& area = zone->addParkingArea(a, "Area-" + std::to_string(a), layout.slotsPerArea);
+        for (int s = 1; s <= layout.slotsPerArea; s++) {
+            ParkingSlot& slot = area.addSlot(slotId++);
+            slot.setListener(this);
+            changeLog.record(&slot);
+        }
+    }
+    // The versions above tell subscribers something changed; dropping the
+    // entries makes them resync, since their snapshot has no such slots
+    changeLog.reset();
+    zones.push_back(zone);
+    allocationEngine->addZone(zone);
+    freeIndex.addZone(layout.slotsPerArea);
+    attributeIndex.addZone();
+    analytics.addZone(layout.slotsPerArea);
+    layout.zoneCount = z;
+
+    // The segment has a fixed size; recreate it (O(city), once per zone)
+    if (statusRegion.isOpen()) {
+        std::string name = statusRegion.getName();
+        if (regionUpdating) {
+            statusRegion.endUpdate(changeLog.getVersion(), clock->nowNanos());
+            regionUpdating = false;
+        }
+        publishStatus(name.c_str());
+    }
+    if (snapshots.isEnabled())
+        snapshotPending = true;
+    endBatch();
+    return z;
+}
+
+// -------- Batching --------
+void ParkingSystem::beginBatch() {
+    batchDepth++;
+}
+
+void ParkingSystem::endBatch() {
+    if (batchDepth == 0 || --batchDepth > 0)
+        return;
+
+    if (regionUpdating) {
+        statusRegion.endUpdate(changeLog.getVersion(), clock->nowNanos());
+        regionUpdating = false;
+    }
+    if (snapshotPending) {
+        buildSnapshot();
+        snapshotPending = false;
+    }
+}
+
+// -------- Shared-Memory Status --------
+bool ParkingSystem::publishStatus(const char* segmentName) {
+    if (!statusRegion.open(segmentName, layout.zoneCount, layout.areasPerZone, layout.slotsPerArea))
+        return false;
+
+    statusRegion.beginUpdate();
+    for (auto zone : zones)
+        for (const auto& area : zone->getParkingAreas())
+            for (const auto& slot : area.getSlots())
+                statusRegion.setSlot(slot.getSlotId(), slot.getZoneId(), slot.getAreaId(), slot.isAvailable());
+    statusRegion.endUpdate(changeLog.getVersion(), clock->nowNanos());
+    return true;
+}
+
+// -------- RollbackTarget --------
+ParkingRequest* ParkingSystem::requestAt(uint32_t requestIndex) {
+    return requestIndex < requests.size() ? &requests[requestIndex] : nullptr;
+}
+
+ParkingSlot* ParkingSystem::slotAt(int slotId) {
+    return findSlot(slotId);
+}
+
+void ParkingSystem::requestRolledBack(uint32_t requestIndex) {
+    ParkingRequest::RequestState state = requests[requestIndex].getState();
+    if (state == ParkingRequest::RELEASED || state == ParkingRequest::CANCELLED) {
+        retireFromSearch(requestIndex);
+        return;
+    }
+
+    // Live again (an undone cancellation): out of the finished history and
+    // back in the index as active, whether or not the history dropped it
+    const VehiclePlate& plate = requests[requestIndex].getVehicleNumber();
+    std::deque<uint32_t>::iterator finished = std::find(searchHistory.begin(), searchHistory.end(), requestIndex);
+    if (finished != searchHistory.end())
+        searchHistory.erase(finished);
+    plateSearch.remove(plate, requestIndex);
+    plateSearch.insert(plate, requestIndex, true);
+}
@@ -1,66 +1,286 @@
 #ifndef PARKING_SYSTEM_H
 #define PARKING_SYSTEM_H
 
+#include <deque>
 #include <vector>
 #include <string>
 #include "Zone.h"
 #include "ParkingArea.h"
 #include "ParkingSlot.h"
 #include "Vehicle.h"
+#include "VehiclePlate.h"
 #include "ParkingRequest.h"
+#include "ParkingOperations.h"
 #include "AllocationEngine.h"
 #include "RollbackManager.h"
+#include "PlateIndex.h"
+#include "PlateSearchIndex.h"
+#include "Clock.h"
+#include "OccupancyAnalytics.h"
+#include "FreeCapacityIndex.h"
+#include "SlotAttributeIndex.h"
+#include "TariffEngine.h"
+#include "StatusChangeLog.h"
+#include "StatusRegion.h"
+#include "CitySnapshot.h"
+#include "CityAudit.h"
 
-class ParkingSystem {
+// City dimensions used by initializeCity (default: 15 zones x 3 areas x 20 slots)
+struct CityLayout {
+    int zoneCount;
+    int areasPerZone;
+    int slotsPerArea;
+
+    CityLayout(int zones = 15, int areas = 3, int slots = 20)
+        : zoneCount(zones), areasPerZone(areas), slotsPerArea(slots) {}
+
+    int getTotalSlots() const { return zoneCount * areasPerZone * slotsPerArea; }
+};
+
+class ParkingSystem : public SlotListener, public ParkingOperations, private RollbackTarget {
 private:
+    CityLayout layout;
+
     std::vector<Zone*> zones;
-    std::vector<Vehicle*> vehicles;
-    std::vector<ParkingRequest*> requests;
+
+    // Request table; a request's index in it is its 32-bit handle. A deque
+    // never moves its elements, so lookupRequest pointers stay valid.
+    std::deque<ParkingRequest> requests;
+
+    // Vehicles registered by a PARK that found no slot (they never get
+    // a request, but stay known like every other vehicle)
+    std::vector<Vehicle> refusedVehicles;
+
+    // Vehicle -> request handle, or REFUSED | refusedVehicles index
+    static const uint32_t REFUSED = 0x80000000u;
+    PlateIndex plateIndex;
+
+    // Partial / misread plate lookups over live requests and the newest
+    // searchHistoryDepth finished ones (handles, oldest first)
+    PlateSearchIndex plateSearch;
+    std::deque<uint32_t> searchHistory;
+    size_t searchHistoryDepth;
 
     AllocationEngine* allocationEngine;
     RollbackManager rollbackManager;
 
+    // Time source; defaults to the built-in monotonic real clock
+    RealClock defaultClock;
+    Clock* clock;
+
     int nextRequestId;
 
+    // Streaming occupancy / dwell analytics, fed by slot transitions
+    OccupancyAnalytics analytics;
+
+    // Zone / area free counts for routing queries, fed the same way
+    FreeCapacityIndex freeIndex;
+
+    // Free slots by attribute flags, for allocation
+    SlotAttributeIndex attributeIndex;
+
+    // Prices each session at release
+    TariffEngine tariff;
+
+    // Versioned slot transitions for STATUS subscribers
+    StatusChangeLog changeLog;
+
+    // Shared-memory counters for dashboard processes (closed unless published)
+    StatusPublisher statusRegion;
+
+    // RCU snapshots for reader threads (off unless enabled)
+    CitySnapshots snapshots;
+
+    // Open batch (see beginBatch); publishing is deferred while > 0
+    int batchDepth;
+    bool snapshotPending;
+    bool regionUpdating;
+
+    // createRequest's preferredArea for "any area"
+    static const int ANY_AREA = -1;
+
     // Internal helpers
     Zone* findZoneById(int zoneId);
-    bool vehicleExists(const std::string& number, Vehicle::VehicleType type);
-    ParkingRequest* findRequestByVehicle(const std::string& number, Vehicle::VehicleType type);
+    bool createRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type, int preferredZone,
+                       int preferredArea, uint8_t requiredAttributes, uint8_t preferredAttributes,
+                       int& fee, bool& crossZoneUsed);
+    bool vehicleExists(const VehiclePlate& number, Vehicle::VehicleType type) const;
+    uint32_t findHandle(const VehiclePlate& number, Vehicle::VehicleType type) const;
+    ParkingRequest* findRequestByVehicle(const VehiclePlate& number, Vehicle::VehicleType type,
+                                         uint32_t* handle = nullptr);
+    void retireFromSearch(uint32_t handle);
+    void trimSearchHistory();
+    void publishSnapshot(const ParkingRequest* changed);
+    void buildSnapshot();
+    void publishSlot(const ParkingSlot& slot, int64_t nowNanos);
+    ParkingArea* findArea(int zoneId, int areaId) const;
+    int setSlotsInService(ParkingArea* area, int fromSlot, int toSlot, bool inService);
 
 public:
     ParkingSystem();
+    explicit ParkingSystem(Clock* clock);   // not owned, must outlive the system
+    explicit ParkingSystem(const CityLayout& layout, Clock* clock = nullptr);
     ~ParkingSystem();
 
     // -------- Initialization --------
     void initializeCity();
 
     // -------- Core Operations --------
-    bool createParkingRequest(const std::string& vehicleNumber,
+    bool createParkingRequest(const VehiclePlate& vehicleNumber,
                               Vehicle::VehicleType type,
                               int preferredZone,
                               int& fee,
-                              bool& crossZoneUsed);
+                              bool& crossZoneUsed) override;
 
     // NEW METHOD: For selecting specific zone and area                      
-    bool createParkingRequestWithArea(const std::string& vehicleNumber,
+    bool createParkingRequestWithArea(const VehiclePlate& vehicleNumber,
                                       Vehicle::VehicleType type,
                                       int preferredZone,
                                       int preferredArea,
                                       int& fee,
-                                      bool& crossZoneUsed);
+                                      bool& crossZoneUsed) override;
 
-    bool occupyParking(const std::string& vehicleNumber, Vehicle::VehicleType type);
-    bool releaseParking(const std::string& vehicleNumber, Vehicle::VehicleType type);
-    bool cancelRequest(const std::string& vehicleNumber, Vehicle::VehicleType type);
+    // For a slot with every requiredAttributes flag (ParkingSlot::Attribute),
+    // preferring one that also has preferredAttributes; preferredArea 0 =
+    // any area. Within each zone / area step the request takes a slot with
+    // every wanted flag, then one with the required flags only; in each
+    // case an exact fit before a slot with extra flags. RESERVED slots go
+    // only to requests that require them.
+    bool createParkingRequestWithAttributes(const VehiclePlate& vehicleNumber,
+                                            Vehicle::VehicleType type,
+                                            int preferredZone,
+                                            int preferredArea,
+                                            uint8_t requiredAttributes,
+                                            uint8_t preferredAttributes,
+                                            int& fee,
+                                            bool& crossZoneUsed);
+
+    bool occupyParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override;
+    bool releaseParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override;
+    bool cancelRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override;
 
     // -------- Rollback --------
     bool rollbackLast(int k);
 
+    // -------- Plate Search --------
+    // Requests whose plate equals the query (or, with prefix, starts with
+    // it) within maxEdits misread, missing, extra or swapped characters.
+    // Searches live requests and the newest finished ones; matches come
+    // exact first, then live first. handle indexes getRequests().
+    void searchPlates(const VehiclePlate& query, bool prefix, int maxEdits, size_t limit,
+                      std::vector<PlateMatch>& out) const;
+
+    // Finished requests kept searchable (default 1000); older ones are
+    // dropped from the search index as new ones finish
+    void setSearchHistoryDepth(int depth);
+
+    // -------- Billing --------
+    TariffEngine& getTariff();
+    const TariffEngine& getTariff() const;
+
+    // Appends every session released in [fromNanos, toNanos) as a row,
+    // ready for TariffEngine::priceBatch
+    void collectSessions(int64_t fromNanos, int64_t toNanos, SessionColumns& out) const;
+
     // -------- Analytics / Display --------
     void displayZoneStatus() const;
     
     // NEW: Display last operations history
     void displayLastOperations(int count = 5) const;
+
+    // -------- Read Access (protocol / tools) --------
+    const std::vector<Zone*>& getZones() const;
+    const std::deque<ParkingRequest>& getRequests() const;
+    const Clock& getClock() const;
+    const CityLayout& getLayout() const;
+    const ParkingRequest* lookupRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) const override;
+    int getFreeSlots() const override;
+    const OccupancyAnalytics& getAnalytics() const;
+    const FreeCapacityIndex& getFreeIndex() const;
+    const SlotAttributeIndex& getAttributeIndex() const;
+    const StatusChangeLog& getChangeLog() const;
+
+    // Slot ids are dense (zone, area, slot order), so this is arithmetic,
+    // not a search; null for an unknown id
+    ParkingSlot* findSlot(int slotId) const;
+
+    // -------- Snapshots --------
+    // After this, every successful operation publishes an immutable
+    // CitySnapshot (zone/area counters + the newest historyDepth requests).
+    // Other threads read it through CitySnapshotView without locking and
+    // without ever delaying the writer.
+    void enableSnapshots(int historyDepth = 100);
+    const CitySnapshots& getSnapshots() const;
+
+    // -------- Topology --------
+    // Online changes; each costs time proportional to the slots it
+    // touches, not to the city. Closing takes slots out of service: free
+    // ones leave the indexes at once, occupied ones keep their vehicle and
+    // leave when it is released (draining). Slot numbers are 1-based
+    // within the area; toSlot <= 0 means the last slot. Each call returns
+    // the number of slots whose service state changed, or -1 if the
+    // target does not exist or was removed.
+    int closeSlots(int zoneId, int areaId, int fromSlot = 1, int toSlot = 0);
+    int openSlots(int zoneId, int areaId, int fromSlot = 1, int toSlot = 0);
+    int closeArea(int zoneId, int areaId);
+    int openArea(int zoneId, int areaId);
+    int closeZone(int zoneId);
+    int openZone(int zoneId);
+
+    // Sets the ParkingSlot::Attribute flags of a slot range (same
+    // numbering and result as closeSlots). Takes effect for the next
+    // allocation; a parked vehicle keeps its slot.
+    int setSlotAttributes(int zoneId, int areaId, int fromSlot, int toSlot, uint8_t attributes);
+
+    // Closes for good and unlinks neighbours. Ids are never reused, so
+    // live requests and history keep pointing at valid objects.
+    int removeArea(int zoneId, int areaId);
+    int removeZone(int zoneId);
+
+    // Appends zone zoneCount + 1 shaped like the others (areasPerZone x
+    // slotsPerArea, slot ids continuing the city's) and returns its id.
+    // An open shared status region is recreated at the new size, so
+    // dashboards must re-attach.
+    int addZone();
+
+    // -------- Audit --------
+    // Cross-checks every slot, live request and free / occupancy counter
+    // of zones fromZone..toZone (toZone <= 0 = last) on `threads` workers
+    // (0 = every core), zone by zone. With repair, fixes what needs no
+    // operator: a taken slot no live request holds is freed, a free slot
+    // a live request holds is taken back, and drifted counters are reset
+    // to the recount. Double bookings and bad allocations are reported
+    // only. Runs on the caller's thread like any other operation; callers
+    // that share the system drive a CityAudit themselves, a step at a time.
+    AuditReport audit(bool repair, int threads = 0, int fromZone = 1, int toZone = 0);
+
+    // Repairs report.issues from firstIssue on, as audit does; returns
+    // how many were repaired
+    int repairAudit(AuditReport& report, size_t firstIssue);
+
+    // -------- Batching --------
+    // Operations between beginBatch and endBatch still update the indexes
+    // and analytics one by one, but the shared status region is updated in
+    // one seqlock window and the snapshot is published once, at endBatch.
+    // Batches nest; only the outermost endBatch publishes.
+    void beginBatch();
+    void endBatch();
+
+    // -------- Shared-Memory Status --------
+    // Creates the segment, copies the current slot states into it and keeps
+    // it updated on every transition. Returns false if it cannot be created.
+    bool publishStatus(const char* segmentName = StatusPublisher::DEFAULT_NAME);
+
+    // -------- SlotListener --------
+    void onSlotChanged(const ParkingSlot& slot, bool available) override;
+    void onSlotServiceChanged(const ParkingSlot& slot, bool inService) override;
+    void onSlotAttributesChanged(const ParkingSlot& slot, uint8_t before) override;
+
+private:
+    // -------- RollbackTarget --------
+    ParkingRequest* requestAt(uint32_t requestIndex) override;
+    ParkingSlot* slotAt(int slotId) override;
+    void requestRolledBack(uint32_t requestIndex) override;
 };
 
 #endif
\ No newline at end of file
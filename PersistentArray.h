@@ -0,0 +1,110 @@
+#ifndef PERSISTENT_ARRAY_H
+#define PERSISTENT_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Fixed-size persistent array: a 32-way trie of immutable nodes.
+//
+// Copying a PersistentArray copies one pointer, so a copy is O(1) and
+// shares every node with the original. set() copies only the shared nodes
+// on the path from the root to the changed leaf (at most O(log32 n)) and leaves every other
+// copy untouched, so copies can be modified independently and read or
+// modified concurrently on different threads (nodes are never mutated
+// once shared; shared_ptr reference counts are atomic).
+template<typename T>
+class PersistentArray {
+private:
+    static const int BITS = 5;
+    static const size_t WIDTH = 1 << BITS;
+    static const size_t MASK = WIDTH - 1;
+
+    struct Node {
+        virtual ~Node() {}
+    };
+    struct Inner : Node {
+        std::shared_ptr<const Node> children[WIDTH];
+    };
+    struct Leaf : Node {
+        T values[WIDTH];
+    };
+
+    std::shared_ptr<const Node> root;
+    size_t count;
+    int shift;                       // BITS * (levels above the leaves)
+
+    static std::shared_ptr<const Node> build(const std::vector<T>& values, size_t first, int level) {
+        if (level == 0) {
+            std::shared_ptr<Leaf> leaf = std::make_shared<Leaf>();
+            for (size_t i = 0; i < WIDTH && first + i < values.size(); i++)
+                leaf->values[i] = values[first + i];
+            return leaf;
+        }
+        std::shared_ptr<Inner> inner = std::make_shared<Inner>();
+        size_t span = static_cast<size_t>(1) << level;
+        for (size_t i = 0; i < WIDTH && first + i * span < values.size(); i++)
+            inner->children[i] = build(values, first + i * span, level - BITS);
+        return inner;
+    }
+
+    // A node reachable only through this array (use_count 1 all the way
+    // down) cannot be seen by any other copy, so it is updated in place
+    // instead of copied; after the first write to a fork, later writes
+    // along the same path allocate nothing.
+    static bool assocInPlace(std::shared_ptr<const Node>& node, int level, size_t index, const T& value) {
+        if (node.use_count() != 1)
+            return false;
+        if (level == 0) {
+            const_cast<Leaf*>(static_cast<const Leaf*>(node.get()))->values[index & MASK] = value;
+            return true;
+        }
+        Inner* inner = const_cast<Inner*>(static_cast<const Inner*>(node.get()));
+        std::shared_ptr<const Node>& child = inner->children[(index >> level) & MASK];
+        if (!assocInPlace(child, level - BITS, index, value))
+            child = assoc(child.get(), level - BITS, index, value);
+        return true;
+    }
+
+    static std::shared_ptr<const Node> assoc(const Node* node, int level, size_t index, const T& value) {
+        if (level == 0) {
+            std::shared_ptr<Leaf> leaf = std::make_shared<Leaf>(*static_cast<const Leaf*>(node));
+            leaf->values[index & MASK] = value;
+            return leaf;
+        }
+        std::shared_ptr<Inner> inner = std::make_shared<Inner>(*static_cast<const Inner*>(node));
+        size_t slot = (index >> level) & MASK;
+        inner->children[slot] = assoc(inner->children[slot].get(), level - BITS, index, value);
+        return inner;
+    }
+
+public:
+    PersistentArray() : count(0), shift(0) {}
+
+    explicit PersistentArray(const std::vector<T>& values) : count(values.size()), shift(0) {
+        while ((static_cast<size_t>(WIDTH) << shift) < count)
+            shift += BITS;
+        if (count > 0)
+            root = build(values, 0, shift);
+    }
+
+    size_t size() const { return count; }
+
+    // No reference-count traffic on reads
+    const T& get(size_t index) const {
+        const Node* node = root.get();
+        for (int level = shift; level > 0; level -= BITS)
+            node = static_cast<const Inner*>(node)->children[(index >> level) & MASK].get();
+        return static_cast<const Leaf*>(node)->values[index & MASK];
+    }
+
+    void set(size_t index, const T& value) {
+        if (index < count && !assocInPlace(root, shift, index, value))
+            root = assoc(root.get(), shift, index, value);
+    }
+
+    // True when both arrays still share their whole tree
+    bool sharesWith(const PersistentArray& other) const { return root == other.root; }
+};
+
+#endif
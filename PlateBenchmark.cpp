@@ -0,0 +1,169 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "ConsoleMute.h"
+#include "ParkingSystem.h"
+#include "CommandParser.h"
+#include "VehiclePlate.h"
+
+// Microbenchmark for the inline plate type.
+// Counts global heap allocations per operation and compares against
+// the old by-value std::string lookup (linear scan, copy per compare).
+
+static unsigned long long g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+typedef std::chrono::steady_clock BenchClock;
+
+static double nanosSince(BenchClock::time_point start, int ops) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start);
+    return static_cast<double>(elapsed.count()) / ops;
+}
+
+static void report(const char* name, double nsPerOp, unsigned long long allocs, int ops) {
+    std::printf("%-36s %10.1f ns/op %8.3f allocs/op\n",
+                name, nsPerOp, static_cast<double>(allocs) / ops);
+}
+
+static std::string plateFor(int i) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "lea-%05d", i);
+    return buf;
+}
+
+int main() {
+    const int VEHICLES = 800;      // fits the 900-slot city
+    const int ROUNDS = 200;
+    // Parked and released before timing: the plate index doubles to 4096
+    // entries on the 1025th vehicle, so the timed ones add no rehash, and
+    // the request deque's block map is already grown
+    const int WARM_UP = 1100;
+
+    std::vector<std::string> names;
+    std::vector<VehiclePlate> plates;
+    for (int i = 0; i < VEHICLES; i++) {
+        names.push_back(plateFor(i));
+        plates.push_back(VehiclePlate(names.back()));
+    }
+
+    // -------- Baseline: by-value string linear scan --------
+    {
+        std::vector<std::string> stored(names);
+        unsigned long long hits = 0;
+        unsigned long long before = g_allocations;
+        auto start = BenchClock::now();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < VEHICLES; i += 7) {
+                for (size_t j = 0; j < stored.size(); j++) {
+                    std::string copy = stored[j];   // old getVehicleNumber() returned by value
+                    if (copy == names[i]) { hits++; break; }
+                }
+            }
+        }
+        int ops = ROUNDS * ((VEHICLES + 6) / 7);
+        report("string linear lookup (old)", nanosSince(start, ops), g_allocations - before, ops);
+        if (hits == 0) std::printf("unexpected\n");
+    }
+
+    // -------- Plate construction from a parsed token --------
+    {
+        const char* token = "lea-01234";
+        uint32_t sink = 0;
+        unsigned long long before = g_allocations;
+        auto start = BenchClock::now();
+        const int ops = 1000000;
+        for (int i = 0; i < ops; i++) {
+            VehiclePlate p(token, 9);
+            sink ^= p.getHash();
+        }
+        report("VehiclePlate construct", nanosSince(start, ops), g_allocations - before, ops);
+        if (sink == 1) std::printf(" ");
+    }
+
+    // -------- Protocol parse --------
+    {
+        std::string line = "OCCUPY LEA-01234 1";
+        Command cmd;
+        unsigned long long before = g_allocations;
+        auto start = BenchClock::now();
+        const int ops = 1000000;
+        for (int i = 0; i < ops; i++) {
+            CommandParser::parse(line.data(), line.size(), cmd);
+        }
+        report("CommandParser::parse", nanosSince(start, ops), g_allocations - before, ops);
+    }
+
+    // -------- ParkingSystem steady state --------
+    ParkingSystem system;
+    ConsoleMute mute;   // per-operation messages; the reports use printf
+
+    int fee;
+    bool crossZone;
+    for (int i = 0; i < WARM_UP; i++) {
+        VehiclePlate warm("warm-" + std::to_string(i));
+        system.createParkingRequest(warm, Vehicle::CAR, 1 + i % 15, fee, crossZone);
+        system.occupyParking(warm, Vehicle::CAR);
+        system.releaseParking(warm, Vehicle::CAR);
+    }
+
+    unsigned long long before = g_allocations;
+    auto start = BenchClock::now();
+    for (int i = 0; i < VEHICLES; i++) {
+        system.createParkingRequest(plates[i], Vehicle::CAR, 1 + i % 15, fee, crossZone);
+    }
+    double parkNs = nanosSince(start, VEHICLES);
+    unsigned long long parkAllocs = g_allocations - before;
+
+    before = g_allocations;
+    start = BenchClock::now();
+    for (int i = 0; i < VEHICLES; i++) {
+        system.occupyParking(plates[i], Vehicle::CAR);
+    }
+    double occupyNs = nanosSince(start, VEHICLES);
+    unsigned long long occupyAllocs = g_allocations - before;
+
+    before = g_allocations;
+    start = BenchClock::now();
+    const int lookups = VEHICLES * ROUNDS;
+    const ParkingRequest* found = nullptr;
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < VEHICLES; i++) {
+            found = system.lookupRequest(plates[i], Vehicle::CAR);
+        }
+    }
+    double lookupNs = nanosSince(start, lookups);
+    unsigned long long lookupAllocs = g_allocations - before;
+
+    before = g_allocations;
+    start = BenchClock::now();
+    for (int i = 0; i < VEHICLES; i++) {
+        system.releaseParking(plates[i], Vehicle::CAR);
+    }
+    double releaseNs = nanosSince(start, VEHICLES);
+    unsigned long long releaseAllocs = g_allocations - before;
+
+    report("ParkingSystem PARK (records)", parkNs, parkAllocs, VEHICLES);
+    report("ParkingSystem OCCUPY", occupyNs, occupyAllocs, VEHICLES);
+    report("ParkingSystem lookup", lookupNs, lookupAllocs, lookups);
+    report("ParkingSystem RELEASE", releaseNs, releaseAllocs, VEHICLES);
+    if (!found) std::printf("lookup failed\n");
+
+    return 0;
+}
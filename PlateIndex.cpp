@@ -0,0 +1,40 @@
+#include "PlateIndex.h"
+
+PlateIndex::PlateIndex() : count(0) {
+    Entry empty = { 0, NONE };
+    table.assign(16, empty);
+}
+
+void PlateIndex::grow() {
+    std::vector<Entry> old;
+    old.swap(table);
+    Entry empty = { 0, NONE };
+    table.assign(old.size() * 2, empty);
+
+    size_t mask = table.size() - 1;
+    for (const Entry& entry : old) {
+        if (entry.handle == NONE)
+            continue;
+        size_t at = entry.hash & mask;
+        while (table[at].handle != NONE)
+            at = (at + 1) & mask;
+        table[at] = entry;
+    }
+}
+
+void PlateIndex::insert(uint32_t hash, uint32_t handle) {
+    if (2 * (count + 1) > table.size())
+        grow();
+
+    size_t mask = table.size() - 1;
+    size_t at = hash & mask;
+    while (table[at].handle != NONE)
+        at = (at + 1) & mask;
+    table[at].hash = hash;
+    table[at].handle = handle;
+    count++;
+}
+
+size_t PlateIndex::size() const {
+    return count;
+}
@@ -0,0 +1,57 @@
+#ifndef PLATE_INDEX_H
+#define PLATE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vehicle.h"
+#include "VehiclePlate.h"
+
+// Open-addressed map from a vehicle (plate + type) to a 32-bit handle
+// into a table its owner keeps.
+//
+// Each entry is 8 bytes, the key's hash and the handle; the plate
+// itself lives only in the owner's table, and a caller-supplied
+// predicate confirms a hash match against it. Linear probing, at most
+// half full, doubled when needed. No removal: ParkingSystem never
+// forgets a vehicle.
+class PlateIndex {
+public:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+private:
+    struct Entry {
+        uint32_t hash;
+        uint32_t handle;     // NONE = empty
+    };
+
+    std::vector<Entry> table;   // size is a power of two
+    size_t count;
+
+    void grow();
+
+public:
+    PlateIndex();
+
+    static uint32_t keyHash(const VehiclePlate& plate, Vehicle::VehicleType type) {
+        return plate.getHash() ^ (static_cast<uint32_t>(type) * 0x9E3779B9u);
+    }
+
+    // Handle stored for the key, or NONE. matches(handle) tells whether
+    // the vehicle behind a handle with the same hash is the key.
+    template<typename Matches>
+    uint32_t find(uint32_t hash, Matches matches) const {
+        size_t mask = table.size() - 1;
+        for (size_t at = hash & mask; table[at].handle != NONE; at = (at + 1) & mask)
+            if (table[at].hash == hash && matches(table[at].handle))
+                return table[at].handle;
+        return NONE;
+    }
+
+    // The key must not be present yet
+    void insert(uint32_t hash, uint32_t handle);
+
+    size_t size() const;
+};
+
+#endif
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+
+// Plate search against a linear scan.
+//
+//   PlateSearchBenchmark [--sessions N] [--history N] [--queries N] [--seed S]
+//
+// Parks --sessions vehicles with "ABC-1234" style plates, finishing
+// most of them, then runs three kinds of operator query: a 3-6
+// character prefix, the same prefix with one character misread, and a
+// whole plate with one character misread or two swapped. Each query is
+// answered by ParkingSystem::searchPlates (limit 20) and by scanning
+// every searchable request; the unlimited index answer must equal the
+// scan, and the limited one must be its best-ranked head.
+
+typedef std::chrono::steady_clock WallClock;
+
+struct SearchQuery {
+    VehiclePlate text;
+    bool prefix;
+};
+
+// Optimal string alignment distance (Levenshtein plus adjacent swaps)
+static int editDistance(const char* a, int aLength, const char* b, int bLength) {
+    int d[VehiclePlate::CAPACITY + 1][VehiclePlate::CAPACITY + 1];
+    for (int i = 0; i <= aLength; i++) d[i][0] = i;
+    for (int j = 0; j <= bLength; j++) d[0][j] = j;
+    for (int i = 1; i <= aLength; i++)
+        for (int j = 1; j <= bLength; j++) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            d[i][j] = std::min(std::min(d[i - 1][j] + 1, d[i][j - 1] + 1), d[i - 1][j - 1] + cost);
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+        }
+    return d[aLength][bLength];
+}
+
+// Fewest edits from the query to the plate (or to any of its prefixes)
+static int matchEdits(const SearchQuery& query, const VehiclePlate& plate) {
+    if (!query.prefix)
+        return editDistance(query.text.c_str(), query.text.size(), plate.c_str(), plate.size());
+    int best = VehiclePlate::CAPACITY + 1;
+    for (int length = 0; length <= plate.size(); length++)
+        best = std::min(best, editDistance(query.text.c_str(), query.text.size(), plate.c_str(), length));
+    return best;
+}
+
+// Every searchable request within one edit, ranked like the index
+static void scan(const std::vector<uint32_t>& searchable, const std::deque<ParkingRequest>& requests,
+                 const SearchQuery& query, std::vector<PlateMatch>& out) {
+    out.clear();
+    for (uint32_t handle : searchable) {
+        int edits = matchEdits(query, requests[handle].getVehicleNumber());
+        if (edits > 1)
+            continue;
+        ParkingRequest::RequestState state = requests[handle].getState();
+        PlateMatch match;
+        match.handle = handle;
+        match.edits = static_cast<uint8_t>(edits);
+        match.active = state != ParkingRequest::RELEASED && state != ParkingRequest::CANCELLED;
+        out.push_back(match);
+    }
+}
+
+static bool betterRank(const PlateMatch& a, const PlateMatch& b) {
+    if (a.edits != b.edits) return a.edits < b.edits;
+    return a.active && !b.active;
+}
+
+static bool rankedBefore(const PlateMatch& a, const PlateMatch& b) {
+    if (betterRank(a, b) || betterRank(b, a)) return betterRank(a, b);
+    return a.handle < b.handle;
+}
+
+// Same matches ignoring order within a rank
+static bool sameMatches(std::vector<PlateMatch> a, std::vector<PlateMatch> b) {
+    if (a.size() != b.size())
+        return false;
+    std::sort(a.begin(), a.end(), rankedBefore);
+    std::sort(b.begin(), b.end(), rankedBefore);
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].handle != b[i].handle || a[i].edits != b[i].edits || a[i].active != b[i].active)
+            return false;
+    return true;
+}
+
+// The limited answer is in rank order and no better match was left out
+static bool isRankedHead(const std::vector<PlateMatch>& head, const std::vector<PlateMatch>& all) {
+    if (head.size() != std::min(all.size(), static_cast<size_t>(20)))
+        return false;
+    for (size_t i = 1; i < head.size(); i++)
+        if (betterRank(head[i], head[i - 1]))
+            return false;
+    if (head.empty() || head.size() == all.size())
+        return true;
+    const PlateMatch& last = head.back();
+    for (const PlateMatch& match : all) {
+        bool listed = false;
+        for (const PlateMatch& h : head)
+            listed = listed || h.handle == match.handle;
+        if (!listed && betterRank(match, last))
+            return false;
+    }
+    return true;
+}
+
+static char randomPlateChar(std::mt19937& random, bool letter) {
+    return letter ? static_cast<char>('A' + random() % 26) : static_cast<char>('0' + random() % 10);
+}
+
+static VehiclePlate makePlate(std::mt19937& random) {
+    char text[9];
+    for (int i = 0; i < 3; i++) text[i] = randomPlateChar(random, true);
+    text[3] = '-';
+    for (int i = 4; i < 8; i++) text[i] = randomPlateChar(random, false);
+    text[8] = '\0';
+    return VehiclePlate(text);
+}
+
+// One misread character, or (whole plates only) two swapped
+static VehiclePlate misread(std::mt19937& random, const char* text, int length, bool allowSwap) {
+    char copy[VehiclePlate::CAPACITY + 1];
+    std::memcpy(copy, text, length);
+    copy[length] = '\0';
+    int at = static_cast<int>(random() % length);
+    if (allowSwap && at + 1 < length && random() % 3 == 0)
+        std::swap(copy[at], copy[at + 1]);
+    else if (copy[at] != '-')
+        copy[at] = randomPlateChar(random, copy[at] >= 'A');
+    return VehiclePlate(copy);
+}
+
+int main(int argc, char** argv) {
+    int sessions = 50000;
+    int history = 5000;
+    int queryCount = 3000;
+    uint32_t seed = 11;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--sessions") == 0)     sessions = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--history") == 0) history = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--queries") == 0) queryCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)    seed = static_cast<uint32_t>(atoi(argv[i + 1]));
+        else {
+            std::printf("Usage: PlateSearchBenchmark [--sessions N] [--history N] [--queries N] [--seed S]\n");
+            return 1;
+        }
+    }
+    if (sessions <= 0 || history < 0 || queryCount <= 0) {
+        std::printf("❌ --sessions and --queries must be positive\n");
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    VirtualClock clock;
+    ParkingSystem* system = new ParkingSystem(CityLayout(100, 10, 200), &clock);
+    system->setSearchHistoryDepth(history);
+
+    // Handles still searchable: live ones plus the newest `history` finished
+    std::vector<uint32_t> live;
+    std::deque<uint32_t> finished;
+    std::vector<VehiclePlate> plates;
+    {
+        ConsoleMute mute;
+        for (int i = 0; i < sessions; i++) {
+            clock.advanceSeconds(30);
+            VehiclePlate plate = makePlate(random);
+            int fee = 0;
+            bool crossZone = false;
+            if (!system->createParkingRequest(plate, Vehicle::CAR, 1 + i % 100, fee, crossZone))
+                continue;
+            uint32_t handle = static_cast<uint32_t>(system->getRequests().size() - 1);
+            plates.push_back(plate);
+
+            uint32_t roll = random() % 10;
+            bool done = roll < 7;
+            if (roll == 0) {
+                system->cancelRequest(plate, Vehicle::CAR);
+            } else {
+                system->occupyParking(plate, Vehicle::CAR);
+                if (done)
+                    system->releaseParking(plate, Vehicle::CAR);
+            }
+            if (!done) {
+                live.push_back(handle);
+            } else {
+                finished.push_back(handle);
+                if (static_cast<int>(finished.size()) > history)
+                    finished.pop_front();
+            }
+        }
+    }
+    std::vector<uint32_t> searchable(live);
+    searchable.insert(searchable.end(), finished.begin(), finished.end());
+
+    // Query texts are drawn from every plate seen, searchable or not
+    const int KINDS = 3;
+    const char* kindNames[KINDS] = { "prefix", "misread prefix", "misread plate" };
+    std::vector<SearchQuery> queries[KINDS];
+    for (int i = 0; i < queryCount; i++) {
+        const VehiclePlate& plate = plates[random() % plates.size()];
+        int length = 3 + static_cast<int>(random() % 4);
+        queries[0].push_back({ VehiclePlate(plate.c_str(), length), true });
+        queries[1].push_back({ misread(random, plate.c_str(), length, false), true });
+        queries[2].push_back({ misread(random, plate.c_str(), plate.size(), true), false });
+    }
+
+    const std::deque<ParkingRequest>& requests = system->getRequests();
+    std::vector<PlateMatch> indexed, limited, scanned;
+    int mismatches = 0;
+    long long matchTotal[KINDS] = { 0, 0, 0 };
+
+    std::printf("🔎 %d sessions (%zu live, %zu finished searchable), %d queries per kind\n",
+                sessions, live.size(), finished.size(), queryCount);
+    std::printf("   %-16s %12s %12s %10s\n", "query", "index ns", "scan ns", "matches");
+
+    for (int kind = 0; kind < KINDS; kind++) {
+        const std::vector<SearchQuery>& list = queries[kind];
+
+        WallClock::time_point start = WallClock::now();
+        for (const SearchQuery& query : list)
+            system->searchPlates(query.text, query.prefix, 1, 20, limited);
+        double indexNanos = std::chrono::duration<double, std::nano>(WallClock::now() - start).count();
+
+        start = WallClock::now();
+        for (const SearchQuery& query : list)
+            scan(searchable, requests, query, scanned);
+        double scanNanos = std::chrono::duration<double, std::nano>(WallClock::now() - start).count();
+
+        for (const SearchQuery& query : list) {
+            system->searchPlates(query.text, query.prefix, 1, SIZE_MAX, indexed);
+            system->searchPlates(query.text, query.prefix, 1, 20, limited);
+            scan(searchable, requests, query, scanned);
+            matchTotal[kind] += static_cast<long long>(scanned.size());
+            if (!sameMatches(indexed, scanned) || !isRankedHead(limited, scanned))
+                mismatches++;
+        }
+
+        std::printf("   %-16s %12.0f %12.0f %10.1f\n", kindNames[kind],
+                    indexNanos / list.size(), scanNanos / list.size(),
+                    static_cast<double>(matchTotal[kind]) / list.size());
+    }
+
+    delete system;
+    if (mismatches != 0) {
+        std::printf("❌ %d queries differ from the scan\n", mismatches);
+        return 1;
+    }
+    std::printf("✅ Every query matches the scan\n");
+    return 0;
+}
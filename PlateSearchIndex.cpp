@@ -0,0 +1,316 @@
+#include "PlateSearchIndex.h"
+#include <algorithm>
+
+// -------- Constructor --------
+PlateSearchIndex::PlateSearchIndex()
+    : freeNodes(NIL), freeEntries(NIL), entryCount(0), nodeCount(0) {
+    newNode('\0');   // root
+}
+
+// -------- Pools --------
+uint32_t PlateSearchIndex::newNode(char ch) {
+    uint32_t node;
+    if (freeNodes != NIL) {
+        node = freeNodes;
+        freeNodes = nodes[node].nextSibling;
+    } else {
+        node = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node());
+    }
+    Node& n = nodes[node];
+    n.firstChild = n.nextSibling = n.entries = NIL;
+    n.total = n.active = 0;
+    n.ch = ch;
+    nodeCount++;
+    return node;
+}
+
+// -------- Trie Navigation --------
+uint32_t PlateSearchIndex::findChild(uint32_t node, char ch) const {
+    for (uint32_t child = nodes[node].firstChild; child != NIL; child = nodes[child].nextSibling) {
+        if (nodes[child].ch == ch)
+            return child;
+        if (nodes[child].ch > ch)
+            break;
+    }
+    return NIL;
+}
+
+uint32_t PlateSearchIndex::findOrAddChild(uint32_t node, char ch) {
+    uint32_t previous = NIL;
+    uint32_t child = nodes[node].firstChild;
+    while (child != NIL && nodes[child].ch < ch) {
+        previous = child;
+        child = nodes[child].nextSibling;
+    }
+    if (child != NIL && nodes[child].ch == ch)
+        return child;
+
+    uint32_t added = newNode(ch);   // may grow the pool; only indexes are held
+    nodes[added].nextSibling = child;
+    if (previous == NIL)
+        nodes[node].firstChild = added;
+    else
+        nodes[previous].nextSibling = added;
+    return added;
+}
+
+uint32_t PlateSearchIndex::findEntry(uint32_t node, uint32_t handle) const {
+    for (uint32_t e = nodes[node].entries; e != NIL; e = entries[e].next)
+        if (entries[e].handle == handle)
+            return e;
+    return NIL;
+}
+
+// Fills path[0..size] with the root and the node of every character;
+// returns the plate length, or -1 if the plate is not in the trie
+int PlateSearchIndex::pathTo(const VehiclePlate& plate, uint32_t* path) const {
+    const char* text = plate.c_str();
+    int length = plate.size();
+    path[0] = 0;
+    for (int i = 0; i < length; i++) {
+        path[i + 1] = findChild(path[i], text[i]);
+        if (path[i + 1] == NIL)
+            return -1;
+    }
+    return length;
+}
+
+// Frees the empty nodes at the bottom of a path
+void PlateSearchIndex::prune(uint32_t* path, int depth) {
+    for (int i = depth; i > 0 && nodes[path[i]].total == 0; i--) {
+        uint32_t node = path[i];
+        uint32_t parent = path[i - 1];
+        if (nodes[parent].firstChild == node) {
+            nodes[parent].firstChild = nodes[node].nextSibling;
+        } else {
+            uint32_t previous = nodes[parent].firstChild;
+            while (nodes[previous].nextSibling != node)
+                previous = nodes[previous].nextSibling;
+            nodes[previous].nextSibling = nodes[node].nextSibling;
+        }
+        nodes[node].nextSibling = freeNodes;
+        freeNodes = node;
+        nodeCount--;
+    }
+}
+
+// -------- Updates --------
+void PlateSearchIndex::insert(const VehiclePlate& plate, uint32_t handle, bool active) {
+    const char* text = plate.c_str();
+    int length = plate.size();
+    uint32_t node = 0;
+
+    nodes[0].total++;
+    if (active) nodes[0].active++;
+    for (int i = 0; i < length; i++) {
+        node = findOrAddChild(node, text[i]);
+        nodes[node].total++;
+        if (active) nodes[node].active++;
+    }
+
+    uint32_t e;
+    if (freeEntries != NIL) {
+        e = freeEntries;
+        freeEntries = entries[e].next;
+    } else {
+        e = static_cast<uint32_t>(entries.size());
+        entries.push_back(Entry());
+    }
+    entries[e].handle = handle;
+    entries[e].active = active;
+    entries[e].next = nodes[node].entries;
+    nodes[node].entries = e;
+    entryCount++;
+}
+
+bool PlateSearchIndex::remove(const VehiclePlate& plate, uint32_t handle) {
+    uint32_t path[VehiclePlate::CAPACITY + 1];
+    int depth = pathTo(plate, path);
+    if (depth < 0)
+        return false;
+
+    uint32_t node = path[depth];
+    uint32_t previous = NIL;
+    uint32_t e = nodes[node].entries;
+    while (e != NIL && entries[e].handle != handle) {
+        previous = e;
+        e = entries[e].next;
+    }
+    if (e == NIL)
+        return false;
+
+    if (previous == NIL)
+        nodes[node].entries = entries[e].next;
+    else
+        entries[previous].next = entries[e].next;
+
+    bool active = entries[e].active;
+    entries[e].next = freeEntries;
+    freeEntries = e;
+    entryCount--;
+
+    for (int i = 0; i <= depth; i++) {
+        nodes[path[i]].total--;
+        if (active) nodes[path[i]].active--;
+    }
+    prune(path, depth);
+    return true;
+}
+
+bool PlateSearchIndex::setActive(const VehiclePlate& plate, uint32_t handle, bool active) {
+    uint32_t path[VehiclePlate::CAPACITY + 1];
+    int depth = pathTo(plate, path);
+    if (depth < 0)
+        return false;
+
+    uint32_t e = findEntry(path[depth], handle);
+    if (e == NIL || entries[e].active == active)
+        return false;
+
+    entries[e].active = active;
+    for (int i = 0; i <= depth; i++) {
+        if (active) nodes[path[i]].active++;
+        else nodes[path[i]].active--;
+    }
+    return true;
+}
+
+// -------- Search --------
+// Whether the subtree holds any entry still being looked for
+bool PlateSearchIndex::wanted(const Walk& walk, uint32_t node) const {
+    const Node& n = nodes[node];
+    return (walk.wantActive && n.active > 0) || (walk.wantInactive && n.total > n.active);
+}
+
+static bool listed(const std::vector<PlateMatch>& matches, uint32_t handle) {
+    for (size_t i = 0; i < matches.size(); i++)
+        if (matches[i].handle == handle)
+            return true;
+    return false;
+}
+
+// Appends the node's own entries; false once the active bucket is full,
+// which ends the search (nothing left can outrank it)
+bool PlateSearchIndex::emit(Walk& walk, uint32_t node, int edits) const {
+    for (uint32_t e = nodes[node].entries; e != NIL; e = entries[e].next) {
+        bool active = entries[e].active;
+        if (active ? !walk.wantActive : !walk.wantInactive)
+            continue;
+
+        // Edit paths can reach one plate more than once, and a wider
+        // budget finds again what a narrower pass already listed
+        std::vector<PlateMatch>& bucket = active ? walk.active : walk.inactive;
+        uint32_t handle = entries[e].handle;
+        if (walk.maxEdits > 0 && (listed(bucket, handle) || listed(*walk.out, handle)))
+            continue;
+
+        PlateMatch match;
+        match.handle = handle;
+        match.edits = static_cast<uint8_t>(edits);
+        match.active = active;
+        bucket.push_back(match);
+        if (bucket.size() >= walk.room) {
+            if (active)
+                return false;
+            walk.wantInactive = false;
+        }
+    }
+    return true;
+}
+
+bool PlateSearchIndex::emitSubtree(Walk& walk, uint32_t node, int edits) const {
+    if (!wanted(walk, node))
+        return true;
+    if (!emit(walk, node, edits))
+        return false;
+    for (uint32_t child = nodes[node].firstChild; child != NIL; child = nodes[child].nextSibling)
+        if (!emitSubtree(walk, child, edits))
+            return false;
+    return true;
+}
+
+// node has consumed the first pos query characters with edits spent
+bool PlateSearchIndex::walkFrom(Walk& walk, uint32_t node, int pos, int edits) const {
+    if (!wanted(walk, node))
+        return true;
+
+    if (pos == walk.length) {
+        if (walk.prefix)
+            return emitSubtree(walk, node, edits);
+        if (!emit(walk, node, edits))
+            return false;
+        // Plate has extra trailing characters
+        if (edits < walk.maxEdits)
+            for (uint32_t child = nodes[node].firstChild; child != NIL; child = nodes[child].nextSibling)
+                if (!walkFrom(walk, child, pos, edits + 1))
+                    return false;
+        return true;
+    }
+
+    char ch = walk.text[pos];
+    uint32_t exact = findChild(node, ch);
+    if (exact != NIL && !walkFrom(walk, exact, pos + 1, edits))
+        return false;
+    if (edits == walk.maxEdits)
+        return true;
+
+    // Query has an extra character
+    if (!walkFrom(walk, node, pos + 1, edits + 1))
+        return false;
+
+    // Misread character, or plate has an extra one here (inserting the
+    // query's own character is the same as inserting it one step later)
+    for (uint32_t child = nodes[node].firstChild; child != NIL; child = nodes[child].nextSibling) {
+        if (nodes[child].ch == ch)
+            continue;
+        if (!walkFrom(walk, child, pos + 1, edits + 1) || !walkFrom(walk, child, pos, edits + 1))
+            return false;
+    }
+
+    // Two neighbouring characters swapped
+    if (pos + 1 < walk.length && walk.text[pos + 1] != ch) {
+        uint32_t first = findChild(node, walk.text[pos + 1]);
+        uint32_t second = first != NIL ? findChild(first, ch) : NIL;
+        if (second != NIL && !walkFrom(walk, second, pos + 2, edits + 1))
+            return false;
+    }
+    return true;
+}
+
+void PlateSearchIndex::search(const VehiclePlate& query, bool prefix, int maxEdits, size_t limit,
+                              std::vector<PlateMatch>& out) const {
+    out.clear();
+    if (!query.isValid() || limit == 0)
+        return;
+
+    Walk walk;
+    walk.text = query.c_str();
+    walk.length = query.size();
+    walk.prefix = prefix;
+    walk.out = &out;
+
+    // Exact before fuzzy: one pass per edit budget
+    for (int budget = 0; budget <= maxEdits && out.size() < limit; budget++) {
+        walk.maxEdits = budget;
+        walk.room = limit - out.size();
+        walk.wantActive = walk.wantInactive = true;
+        walk.active.clear();
+        walk.inactive.clear();
+
+        bool finished = walkFrom(walk, 0, 0, 0);
+        out.insert(out.end(), walk.active.begin(), walk.active.end());
+        size_t take = std::min(walk.inactive.size(), limit - out.size());
+        out.insert(out.end(), walk.inactive.begin(), walk.inactive.begin() + take);
+        if (!finished)
+            return;
+    }
+}
+
+size_t PlateSearchIndex::size() const {
+    return entryCount;
+}
+
+size_t PlateSearchIndex::getNodeCount() const {
+    return nodeCount;
+}
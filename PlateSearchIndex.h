@@ -0,0 +1,104 @@
+#ifndef PLATE_SEARCH_INDEX_H
+#define PLATE_SEARCH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "VehiclePlate.h"
+
+// One plate found by PlateSearchIndex::search
+struct PlateMatch {
+    uint32_t handle;     // as inserted (ParkingSystem: index into getRequests())
+    uint8_t edits;       // 0 = exact / prefix match
+    bool active;
+};
+
+// Character trie over normalized plates for operator lookups with a
+// partial or misread plate.
+//
+// Nodes and entries live in two pools linked by 32-bit indexes and are
+// recycled through free lists, so insert and remove cost O(plate length)
+// and never touch the rest of the trie. Every node counts the entries
+// (and active entries) below it, which lets a search skip dead branches
+// and list active sessions first.
+//
+// search walks the trie once per edit budget, spending at most maxEdits
+// substitutions, insertions, deletions or adjacent transpositions, so a
+// 1-edit lookup visits O(length x alphabet) nodes, independent of how
+// many plates are stored.
+class PlateSearchIndex {
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        uint32_t firstChild;     // children are kept in character order
+        uint32_t nextSibling;    // also links the free list
+        uint32_t entries;        // plates ending here, NIL = none
+        uint32_t total;          // entries in this subtree
+        uint32_t active;         // of which active
+        char ch;
+    };
+
+    struct Entry {
+        uint32_t handle;
+        uint32_t next;           // also links the free list
+        bool active;
+    };
+
+    // One pass of search with a fixed edit budget. Active and inactive
+    // matches are gathered apart and appended to out in that order; a
+    // bucket that is full stops being looked for.
+    struct Walk {
+        const char* text;
+        int length;
+        bool prefix;
+        int maxEdits;
+        size_t room;                       // limit - out.size() at the start
+        bool wantActive;
+        bool wantInactive;
+        const std::vector<PlateMatch>* out;
+        std::vector<PlateMatch> active;
+        std::vector<PlateMatch> inactive;
+    };
+
+    std::vector<Node> nodes;     // nodes[0] is the root
+    std::vector<Entry> entries;
+    uint32_t freeNodes;
+    uint32_t freeEntries;
+    size_t entryCount;
+    size_t nodeCount;
+
+    uint32_t newNode(char ch);
+    uint32_t findChild(uint32_t node, char ch) const;
+    uint32_t findOrAddChild(uint32_t node, char ch);
+    uint32_t findEntry(uint32_t node, uint32_t handle) const;
+    int pathTo(const VehiclePlate& plate, uint32_t* path) const;
+    void prune(uint32_t* path, int depth);
+
+    bool wanted(const Walk& walk, uint32_t node) const;
+    bool emit(Walk& walk, uint32_t node, int edits) const;
+    bool emitSubtree(Walk& walk, uint32_t node, int edits) const;
+    bool walkFrom(Walk& walk, uint32_t node, int pos, int edits) const;
+
+public:
+    PlateSearchIndex();
+
+    // -------- Updates, O(plate length) --------
+    void insert(const VehiclePlate& plate, uint32_t handle, bool active);
+    bool remove(const VehiclePlate& plate, uint32_t handle);
+
+    // False if the entry is missing or already in that state
+    bool setActive(const VehiclePlate& plate, uint32_t handle, bool active);
+
+    // -------- Search --------
+    // Plates equal to the query (or starting with it, with prefix) within
+    // maxEdits edits. Matches are ranked by edits, then active before
+    // inactive; out is cleared and holds at most limit.
+    void search(const VehiclePlate& query, bool prefix, int maxEdits, size_t limit,
+                std::vector<PlateMatch>& out) const;
+
+    size_t size() const;
+    size_t getNodeCount() const;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <vector>
+#include "ConsoleMute.h"
+#include "ParkingSystem.h"
+
+// Plate search ranking on a small city.
+//
+//   PlateSearchTest
+//
+// Matches come by edit count first (exact before fuzzy), then live
+// requests before finished ones; a limit keeps the best of that order,
+// and finished requests leave the search once the history depth is
+// exceeded. Exits non-zero if any expectation fails.
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("❌ %s\n", what);
+        failures++;
+    }
+}
+
+static void park(ParkingSystem& system, const char* plate, Vehicle::VehicleType type) {
+    int fee = 0;
+    bool crossZone = false;
+    check(system.createParkingRequest(VehiclePlate(plate), type, 1, fee, crossZone), plate);
+}
+
+static void finish(ParkingSystem& system, const char* plate, Vehicle::VehicleType type) {
+    park(system, plate, type);
+    check(system.occupyParking(VehiclePlate(plate), type), plate);
+    check(system.releaseParking(VehiclePlate(plate), type), plate);
+}
+
+static bool is(const ParkingSystem& system, const PlateMatch& match, const char* plate,
+               Vehicle::VehicleType type, int edits, bool active) {
+    const ParkingRequest& request = system.getRequests()[match.handle];
+    return request.getVehicleNumber() == VehiclePlate(plate) && request.getVehicleType() == type &&
+           match.edits == edits && match.active == active;
+}
+
+int main() {
+    ConsoleMute mute;
+    VirtualClock clock;
+    ParkingSystem system(CityLayout(1, 1, 8), &clock);
+    std::vector<PlateMatch> found;
+
+    // Finished first, so insertion order cannot explain a live-first answer
+    finish(system, "KHI101", Vehicle::CAR);
+    finish(system, "KHI100", Vehicle::CAR);
+    park(system, "KHI101", Vehicle::BIKE);
+    park(system, "KHI102", Vehicle::CAR);
+    park(system, "LHR555", Vehicle::CAR);
+
+    // -------- Exact before fuzzy, live before finished --------
+    system.searchPlates(VehiclePlate("KHI101"), false, 1, 10, found);
+    check(found.size() == 4, "1-edit search finds the four KHI10x requests");
+    if (found.size() == 4) {
+        check(is(system, found[0], "KHI101", Vehicle::BIKE, 0, true), "live exact match first");
+        check(is(system, found[1], "KHI101", Vehicle::CAR, 0, false), "finished exact match second");
+        check(is(system, found[2], "KHI102", Vehicle::CAR, 1, true), "live fuzzy match third");
+        check(is(system, found[3], "KHI100", Vehicle::CAR, 1, false), "finished fuzzy match last");
+    }
+
+    system.searchPlates(VehiclePlate("KHI101"), false, 0, 10, found);
+    check(found.size() == 2 && found[0].edits == 0 && found[1].edits == 0, "0 edits finds only exact matches");
+
+    // -------- Limit keeps the best --------
+    system.searchPlates(VehiclePlate("KHI101"), false, 1, 1, found);
+    check(found.size() == 1 && is(system, found[0], "KHI101", Vehicle::BIKE, 0, true),
+          "limit 1 keeps the live exact match");
+    system.searchPlates(VehiclePlate("KHI109"), false, 1, 2, found);
+    check(found.size() == 2 && found[0].active && found[1].active,
+          "limit 2 over fuzzy matches keeps the live ones");
+
+    // -------- Misreads --------
+    system.searchPlates(VehiclePlate("KHI011"), false, 1, 10, found);
+    check(found.size() == 2 && found[0].edits == 1 && found[0].active,
+          "a swapped pair is one edit, live first");
+    system.searchPlates(VehiclePlate("KHI10"), true, 0, 10, found);
+    check(found.size() == 4 && found[0].active && found[1].active && !found[2].active && !found[3].active,
+          "prefix search lists live requests first");
+    system.searchPlates(VehiclePlate("LHR55"), false, 1, 10, found);
+    check(found.size() == 1 && is(system, found[0], "LHR555", Vehicle::CAR, 1, true),
+          "a missing character is one edit");
+
+    // -------- Finishing and history depth --------
+    check(system.releaseParking(VehiclePlate("KHI102"), Vehicle::CAR) == false, "KHI102 is not occupied yet");
+    check(system.cancelRequest(VehiclePlate("KHI102"), Vehicle::CAR), "cancel KHI102");
+    system.searchPlates(VehiclePlate("KHI102"), false, 0, 10, found);
+    check(found.size() == 1 && !found[0].active, "a cancelled request is searchable as finished");
+
+    system.setSearchHistoryDepth(0);
+    system.searchPlates(VehiclePlate("KHI10"), true, 0, 10, found);
+    check(found.size() == 1 && is(system, found[0], "KHI101", Vehicle::BIKE, 0, true),
+          "history depth 0 leaves only live requests");
+
+    if (failures != 0) {
+        std::printf("❌ %d plate search check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("✅ Plate search ranks exact, then live, first\n");
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "ResponseJson.h"
+#include "JsonWriter.h"
+#include "ParkingSystem.h"
+
+// -------- STATUS --------
+void ResponseJson::writeStatus(JsonWriter& out, const ParkingSystem& system) {
+    out.beginObject().key("zones").beginArray();
+    for (auto zone : system.getZones()) {
+        const std::string& zoneName = zone->getZoneName();
+        out.beginObject()
+           .key("id").value(zone->getZoneId())
+           .key("name").value(zoneName.data(), zoneName.size())
+           .key("areas").beginArray();
+
+        for (const auto& area : zone->getParkingAreas()) {
+            const std::string& areaName = area.getAreaName();
+            out.beginObject()
+               .key("id").value(area.getAreaId())
+               .key("name").value(areaName.data(), areaName.size())
+               .key("slots").beginArray();
+
+            for (const auto& slot : area.getSlots()) {
+                out.beginObject()
+                   .key("id").value(slot.getSlotId())
+                   .key("isAvailable").value(slot.isAvailable())
+                   .endObject();
+            }
+            out.endArray().endObject();
+        }
+        out.endArray().endObject();
+    }
+    out.endArray().endObject();
+}
+
+// -------- HISTORY --------
+// Times are sent twice: epoch seconds (what the dashboard already reads)
+// and ISO-8601 UTC, formatted without ctime.
+void ResponseJson::writeHistory(JsonWriter& out, const ParkingSystem& system, int count) {
+    const std::deque<ParkingRequest>& requests = system.getRequests();
+    out.beginObject().key("history").beginArray();
+
+    int shown = 0;
+    for (int i = static_cast<int>(requests.size()) - 1; i >= 0 && shown < count; i--, shown++) {
+        const ParkingRequest* req = &requests[i];
+        const VehiclePlate& plate = req->getVehicleNumber();
+        int64_t requestTime = req->getRequestTime();
+        int64_t occupyTime = req->getOccupyTime();
+        int64_t releaseTime = req->getReleaseTime();
+
+        out.beginObject()
+           .key("id").value(req->getRequestId())
+           .key("vehicle").value(plate.c_str(), plate.size())
+           .key("type").value(Vehicle::vehicleTypeName(req->getVehicleType()))
+           .key("status").value(req->getStateName())
+           .key("zone").value(req->getAllocatedZoneId())
+           .key("area").value(req->getAllocatedAreaId())
+           .key("slot").value(req->getAllocatedSlotId())
+           .key("requestTime").value(requestTime)
+           .key("occupyTime").value(occupyTime)
+           .key("releaseTime").value(releaseTime)
+           .key("requestedAt").timestamp(requestTime)
+           .key("occupiedAt").timestamp(occupyTime)
+           .key("releasedAt").timestamp(releaseTime)
+           .key("durationHours").value(req->getParkingDurationHours())
+           .key("waitSeconds").value(req->getWaitSeconds())
+           .key("dwellSeconds").value(req->getDwellSeconds())
+           .key("charge").value(req->getCharge() / 100.0, 2)
+           .endObject();
+    }
+    out.endArray().endObject();
+}
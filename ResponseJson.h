@@ -0,0 +1,19 @@
+#ifndef RESPONSE_JSON_H
+#define RESPONSE_JSON_H
+
+class JsonWriter;
+class ParkingSystem;
+
+// Serialisers for the two large protocol responses, shared by the
+// command server and JsonBenchmark. Both append one JSON value to the
+// writer and allocate nothing once the writer's buffer has grown.
+class ResponseJson {
+public:
+    // {"zones":[{"id","name","areas":[{"id","name","slots":[{"id","isAvailable"}]}]}]}
+    static void writeStatus(JsonWriter& out, const ParkingSystem& system);
+
+    // {"history":[...]} with the newest `count` requests first
+    static void writeHistory(JsonWriter& out, const ParkingSystem& system, int count);
+};
+
+#endif
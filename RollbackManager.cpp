@@ -1,10 +1,14 @@
 #include "RollbackManager.h"
 
+// -------- Constructor --------
+RollbackManager::RollbackManager(RollbackTarget* t) : target(t) {}
+
+
 // -------- Record Allocation --------
-void RollbackManager::recordAllocation(ParkingRequest* request, ParkingSlot* slot) {
+void RollbackManager::recordAllocation(uint32_t requestIndex, const ParkingRequest& request) {
     RollbackEntry entry;
-    entry.request = request;
-    entry.slot = slot;
+    entry.requestIndex = requestIndex;
+    entry.slotId = request.hasAllocatedSlot() ? request.getAllocatedSlotId() : 0;
     entry.previousState = ParkingRequest::REQUESTED;
 
     rollbackStack.push(entry);
@@ -12,11 +16,11 @@ void RollbackManager::recordAllocation(ParkingRequest* request, ParkingSlot* slo
 
 
 // -------- Record Cancellation --------
-void RollbackManager::recordCancellation(ParkingRequest* request) {
+void RollbackManager::recordCancellation(uint32_t requestIndex, const ParkingRequest& request) {
     RollbackEntry entry;
-    entry.request = request;
-    entry.slot = request->getAllocatedSlot();
-    entry.previousState = ParkingRequest::ALLOCATED;
+    entry.requestIndex = requestIndex;
+    entry.slotId = request.hasAllocatedSlot() ? request.getAllocatedSlotId() : 0;
+    entry.previousState = entry.slotId != 0 ? ParkingRequest::ALLOCATED : ParkingRequest::REQUESTED;
 
     rollbackStack.push(entry);
 }
@@ -27,38 +31,35 @@ bool RollbackManager::rollbackLast() {
     if (rollbackStack.empty())
         return false;
 
-    RollbackEntry entry = rollbackStack.top();
-    rollbackStack.pop();
+    const RollbackEntry& entry = rollbackStack.top();
+    ParkingSlot* slot = entry.slotId != 0 ? target->slotAt(entry.slotId) : nullptr;
+    ParkingRequest* request = target->requestAt(entry.requestIndex);
+    if (request == nullptr)
+        return false;
 
-    // Restore slot
-    if (entry.slot != nullptr) {
-        entry.slot->markFree();
-    }
-
-    // Restore request state
-    if (entry.request != nullptr) {
-        if (entry.previousState == ParkingRequest::REQUESTED) {
-            // undo allocation
-            entry.request->cancel(); // safe reset
-        } else if (entry.previousState == ParkingRequest::ALLOCATED) {
-            // undo cancellation
-            entry.request->allocateSlot(entry.slot);
-        }
-    }
+    // The request checks its own state, so an entry it has moved past is refused
+    bool restored = entry.previousState == ParkingRequest::ALLOCATED
+                  ? request->restoreAllocated(slot)
+                  : request->restoreRequested(slot);
+    if (!restored)
+        return false;
 
+    uint32_t requestIndex = entry.requestIndex;
+    rollbackStack.pop();
+    target->requestRolledBack(requestIndex);
     return true;
 }
 
 
 // -------- Rollback K Operations --------
-bool RollbackManager::rollbackK(int k) {
+int RollbackManager::rollbackK(int k) {
     if (k <= 0 || rollbackStack.size() < static_cast<size_t>(k))
-        return false;
+        return 0;
 
-    for (int i = 0; i < k; i++) {
-        rollbackLast();
-    }
-    return true;
+    int undone = 0;
+    while (undone < k && rollbackLast())
+        undone++;
+    return undone;
 }
 
 
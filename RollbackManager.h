@@ -1,31 +1,52 @@
 #ifndef ROLLBACK_MANAGER_H
 #define ROLLBACK_MANAGER_H
 
+#include <cstdint>
 #include <stack>
 #include "ParkingRequest.h"
 #include "ParkingSlot.h"
 
+// Owner of the tables that rollback entries index into
+class RollbackTarget {
+public:
+    virtual ~RollbackTarget() {}
+    virtual ParkingRequest* requestAt(uint32_t requestIndex) = 0;
+    virtual ParkingSlot* slotAt(int slotId) = 0;   // null if unknown
+
+    // Called once an entry has been undone
+    virtual void requestRolledBack(uint32_t requestIndex) { (void)requestIndex; }
+};
+
 class RollbackManager {
 private:
+    // 12 bytes: handles instead of pointers
     struct RollbackEntry {
-        ParkingRequest* request;
-        ParkingSlot* slot;
-        ParkingRequest::RequestState previousState;
+        uint32_t requestIndex;
+        int32_t slotId;                  // 0 = none
+        uint8_t previousState;           // ParkingRequest::RequestState
     };
 
+    RollbackTarget* target;              // not owned
     std::stack<RollbackEntry> rollbackStack;
 
 public:
+    explicit RollbackManager(RollbackTarget* target);
+
     // -------- Recording Operations --------
-    void recordAllocation(ParkingRequest* request, ParkingSlot* slot);
-    void recordCancellation(ParkingRequest* request);
+    void recordAllocation(uint32_t requestIndex, const ParkingRequest& request);
+    void recordCancellation(uint32_t requestIndex, const ParkingRequest& request);
 
     // -------- Rollback --------
+    // Undoes the newest entry. An entry whose request has moved on since
+    // (occupied, released, or its slot taken by another request) cannot be
+    // undone: it is refused, stays on the stack, and false is returned.
     bool rollbackLast();
-    bool rollbackK(int k);
+    // Undoes up to k entries, stopping at the first refused one; returns
+    // how many were undone (0 if fewer than k are recorded)
+    int rollbackK(int k);
 
     // -------- Utility --------
     bool isEmpty() const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,115 @@
+#include <cstdio>
+#include "ConsoleMute.h"
+#include "ParkingSystem.h"
+
+// Rollback round trips on a one-zone city.
+//
+//   RollbackTest
+//
+// Undoing an allocation frees its slot and leaves the request REQUESTED;
+// undoing a cancellation gives the slot back. An entry whose request has
+// moved on (occupied, or its slot taken by someone else) is refused and
+// changes nothing. Exits non-zero if any expectation fails.
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("❌ %s\n", what);
+        failures++;
+    }
+}
+
+static ParkingRequest::RequestState stateOf(const ParkingSystem& system, const char* plate) {
+    return system.lookupRequest(VehiclePlate(plate), Vehicle::CAR)->getState();
+}
+
+static bool park(ParkingSystem& system, const char* plate) {
+    int fee = 0;
+    bool crossZone = false;
+    return system.createParkingRequest(VehiclePlate(plate), Vehicle::CAR, 1, fee, crossZone);
+}
+
+int main() {
+    ConsoleMute mute;
+    VirtualClock clock;
+
+    // allocate -> rollback
+    {
+        ParkingSystem system(CityLayout(1, 1, 4), &clock);
+        check(park(system, "A1"), "park A1");
+        check(system.getFreeSlots() == 3, "allocation takes a slot");
+        check(system.rollbackLast(1), "undo allocation");
+        check(system.getFreeSlots() == 4, "undone allocation frees its slot");
+        check(stateOf(system, "A1") == ParkingRequest::REQUESTED, "undone allocation leaves REQUESTED");
+        check(!system.rollbackLast(1), "nothing left to undo");
+        check(system.audit(false).isClean(), "audit clean after undoing an allocation");
+    }
+
+    // allocate -> occupy -> rollback: refused, the car stays
+    {
+        ParkingSystem system(CityLayout(1, 1, 4), &clock);
+        check(park(system, "B1"), "park B1");
+        check(system.occupyParking(VehiclePlate("B1"), Vehicle::CAR), "occupy B1");
+        check(!system.rollbackLast(1), "undoing the allocation of an occupied request is refused");
+        check(stateOf(system, "B1") == ParkingRequest::OCCUPIED, "refused rollback keeps OCCUPIED");
+        check(system.getFreeSlots() == 3, "refused rollback keeps the slot taken");
+        check(system.releaseParking(VehiclePlate("B1"), Vehicle::CAR), "release B1 after the refusal");
+        check(!system.rollbackLast(1), "undoing the allocation of a released request is refused");
+        check(system.getFreeSlots() == 4, "released slot stays free");
+        check(system.audit(false).isClean(), "audit clean after refused rollbacks");
+    }
+
+    // allocate -> cancel -> rollback -> rollback
+    {
+        ParkingSystem system(CityLayout(1, 1, 4), &clock);
+        check(park(system, "C1"), "park C1");
+        int slotId = system.lookupRequest(VehiclePlate("C1"), Vehicle::CAR)->getAllocatedSlotId();
+        check(system.cancelRequest(VehiclePlate("C1"), Vehicle::CAR), "cancel C1");
+        check(system.getFreeSlots() == 4, "cancel frees the slot");
+        check(system.rollbackLast(1), "undo cancellation");
+        check(stateOf(system, "C1") == ParkingRequest::ALLOCATED, "undone cancellation is ALLOCATED again");
+        check(system.lookupRequest(VehiclePlate("C1"), Vehicle::CAR)->getAllocatedSlotId() == slotId,
+              "undone cancellation keeps its slot");
+        check(system.getFreeSlots() == 3, "undone cancellation takes the slot back");
+        check(system.occupyParking(VehiclePlate("C1"), Vehicle::CAR), "restored request can be occupied");
+        check(system.releaseParking(VehiclePlate("C1"), Vehicle::CAR), "restored request can be released");
+        check(system.audit(false).isClean(), "audit clean after undoing a cancellation");
+    }
+
+    // cancel -> the slot goes to someone else -> undo cancellation refused
+    {
+        ParkingSystem system(CityLayout(1, 1, 1), &clock);
+        check(park(system, "D1"), "park D1");
+        check(system.cancelRequest(VehiclePlate("D1"), Vehicle::CAR), "cancel D1");
+        check(park(system, "D2"), "D2 takes the only slot");
+        check(system.occupyParking(VehiclePlate("D2"), Vehicle::CAR), "occupy D2");
+        check(!system.rollbackLast(2), "rollback stops at D2's occupied allocation");
+        check(stateOf(system, "D1") == ParkingRequest::CANCELLED, "D1 stays cancelled");
+        check(stateOf(system, "D2") == ParkingRequest::OCCUPIED, "D2 keeps its slot");
+        check(system.getFreeSlots() == 0, "the slot stays taken");
+        check(system.audit(false).isClean(), "audit clean after a refused undo");
+    }
+
+    // rollback K: partial undo stops at the first refused entry
+    {
+        ParkingSystem system(CityLayout(1, 1, 4), &clock);
+        check(park(system, "E1"), "park E1");
+        check(system.occupyParking(VehiclePlate("E1"), Vehicle::CAR), "occupy E1");
+        check(park(system, "E2"), "park E2");
+        check(park(system, "E3"), "park E3");
+        check(!system.rollbackLast(3), "rollback of 3 stops at E1");
+        check(stateOf(system, "E3") == ParkingRequest::REQUESTED, "E3 undone");
+        check(stateOf(system, "E2") == ParkingRequest::REQUESTED, "E2 undone");
+        check(stateOf(system, "E1") == ParkingRequest::OCCUPIED, "E1 untouched");
+        check(system.getFreeSlots() == 3, "only E1's slot is taken");
+        check(system.audit(false).isClean(), "audit clean after a partial rollback");
+    }
+
+    if (failures != 0) {
+        std::printf("❌ %d rollback check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("✅ Rollback round trips behave\n");
+    return 0;
+}
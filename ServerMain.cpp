@@ -0,0 +1,718 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ParkingSystem.h"
+#include "BinaryProtocol.h"
+#include "JsonWriter.h"
+#include "ResponseJson.h"
+#include "CommandParser.h"
+#include "Metrics.h"
+#include "SpanTracer.h"
+
+// Line-oriented command server driven by the Node bridge (backend/server.js).
+// Every command answers with one JSON document between JSON_START / JSON_END.
+// Gate controllers send BINARY first and then speak BinaryProtocol frames.
+//
+//   ServerMain [--shm [NAME]] [--audit SECONDS]
+//
+// --shm also publishes live counters to a shared-memory status region
+// (default /parking-status) for StatusMonitor and other local readers.
+// --audit audits and repairs the whole city every SECONDS in the
+// background (see runAuditor), reporting findings on stderr.
+
+using namespace std;
+
+// One response is built at a time (under Subscription::guard), so a single
+// writer is reused for every document and its buffer stops growing after
+// the first full STATUS.
+static JsonWriter response;
+
+static void emit(const char* frameStart, const char* frameEnd) {
+    cout << frameStart << '\n';
+    response.writeTo(cout);
+    cout << '\n' << frameEnd << endl;
+}
+
+static void emit() {
+    emit("JSON_START", "JSON_END");
+}
+
+// -------- Status Subscription --------
+// One subscriber: the bridge. Deltas are pushed between PUSH_START /
+// PUSH_END so they cannot be mistaken for a command response.
+struct Subscription {
+    mutex guard;                 // held while a command runs or a push is built
+    condition_variable wake;
+    bool active;
+    bool stopping;
+    int intervalMs;
+    uint64_t lastVersion;
+
+    Subscription() : active(false), stopping(false), intervalMs(250), lastVersion(0) {}
+};
+
+static void emitResult(bool ok, const char* message) {
+    response.clear();
+    response.beginObject()
+            .key("result").value(ok ? "success" : "error")
+            .key("message").value(message)
+            .endObject();
+    emit();
+}
+
+static void emitPark(const ParkingSystem& system, const Command& cmd, int fee, bool crossZone) {
+    const ParkingRequest* req = system.lookupRequest(cmd.plate, cmd.vehicleType);
+    const ParkingSlot* slot = req ? system.findSlot(req->getAllocatedSlotId()) : nullptr;
+    char attributes[32];
+    ParkingSlot::formatAttributes(slot ? slot->getAttributes() : 0, attributes, sizeof(attributes));
+    response.clear();
+    response.beginObject()
+            .key("result").value("success")
+            .key("vehicle").value(cmd.plate.c_str(), cmd.plate.size())
+            .key("slot").value(req ? req->getAllocatedSlotId() : -1)
+            .key("zone").value(req ? req->getAllocatedZoneId() : -1)
+            .key("area").value(req ? req->getAllocatedAreaId() : -1)
+            .key("fee").value(fee)
+            .key("crossZone").value(crossZone)
+            .key("attributes").value(attributes)
+            .endObject();
+    emit();
+}
+
+static void emitStatus(const ParkingSystem& system) {
+    response.clear();
+    ResponseJson::writeStatus(response, system);
+    emit();
+}
+
+// Changed slots since `since`, plus the current free counters of every
+// zone and area they belong to. Falls back to a full snapshot when the
+// change log no longer reaches back that far.
+static void writeDelta(const ParkingSystem& system, uint64_t since) {
+    static vector<const ParkingSlot*> slots;
+    uint64_t version = system.getChangeLog().getVersion();
+    bool covered = system.getChangeLog().changedSince(since, slots);
+
+    response.beginObject().key("from").value(since).key("to").value(version);
+    if (!covered) {
+        response.key("resync").value(true).key("status");
+        ResponseJson::writeStatus(response, system);
+        response.endObject();
+        return;
+    }
+
+    const FreeCapacityIndex& index = system.getFreeIndex();
+    response.key("resync").value(false).key("slots").beginArray();
+    for (auto slot : slots) {
+        response.beginObject()
+                .key("id").value(slot->getSlotId())
+                .key("zone").value(slot->getZoneId())
+                .key("area").value(slot->getAreaId())
+                .key("isAvailable").value(slot->isAvailable())
+                .endObject();
+    }
+
+    // Slots are ordered by id, so each zone's and area's slots are adjacent
+    response.endArray().key("areas").beginArray();
+    int lastZone = -1, lastArea = -1;
+    for (auto slot : slots) {
+        if (slot->getZoneId() == lastZone && slot->getAreaId() == lastArea)
+            continue;
+        lastZone = slot->getZoneId();
+        lastArea = slot->getAreaId();
+        response.beginObject()
+                .key("zone").value(lastZone)
+                .key("id").value(lastArea)
+                .key("free").value(index.getAreaFree(lastZone, lastArea))
+                .endObject();
+    }
+
+    response.endArray().key("zones").beginArray();
+    lastZone = -1;
+    for (auto slot : slots) {
+        if (slot->getZoneId() == lastZone)
+            continue;
+        lastZone = slot->getZoneId();
+        response.beginObject()
+                .key("id").value(lastZone)
+                .key("free").value(index.getZoneFree(lastZone))
+                .endObject();
+    }
+    response.endArray().endObject();
+}
+
+static void emitSubscribe(const ParkingSystem& system, Subscription& subscription, int intervalMs) {
+    subscription.active = true;
+    subscription.intervalMs = intervalMs;
+    subscription.lastVersion = system.getChangeLog().getVersion();
+
+    response.clear();
+    response.beginObject()
+            .key("version").value(subscription.lastVersion)
+            .key("intervalMs").value(intervalMs)
+            .key("status");
+    ResponseJson::writeStatus(response, system);
+    response.endObject();
+    emit();
+    subscription.wake.notify_all();
+}
+
+static void emitDelta(const ParkingSystem& system, uint64_t since) {
+    response.clear();
+    writeDelta(system, since);
+    emit();
+}
+
+// Wakes every interval and pushes one coalesced delta if anything changed
+static void runPusher(const ParkingSystem& system, Subscription& subscription) {
+    unique_lock<mutex> lock(subscription.guard);
+    while (!subscription.stopping) {
+        if (!subscription.active) {
+            subscription.wake.wait(lock);
+            continue;
+        }
+
+        subscription.wake.wait_for(lock, chrono::milliseconds(subscription.intervalMs));
+        if (subscription.stopping || !subscription.active)
+            continue;
+
+        uint64_t version = system.getChangeLog().getVersion();
+        if (version == subscription.lastVersion)
+            continue;
+
+        response.clear();
+        writeDelta(system, subscription.lastVersion);
+        subscription.lastVersion = version;
+        emit("PUSH_START", "PUSH_END");
+    }
+}
+
+static void emitHistory(const ParkingSystem& system, int count) {
+    response.clear();
+    ResponseJson::writeHistory(response, system, count);
+    emit();
+}
+
+// {"matches":[{"vehicle","type","status","zone","area","slot","edits","active"}]}
+static void emitSearch(const ParkingSystem& system, const Command& cmd) {
+    static vector<PlateMatch> matches;
+    system.searchPlates(cmd.plate, true, 1, static_cast<size_t>(max(cmd.count, 0)), matches);
+
+    const deque<ParkingRequest>& requests = system.getRequests();
+    response.clear();
+    response.beginObject().key("matches").beginArray();
+    for (const PlateMatch& match : matches) {
+        const ParkingRequest& req = requests[match.handle];
+        const VehiclePlate& plate = req.getVehicleNumber();
+        response.beginObject()
+                .key("vehicle").value(plate.c_str(), plate.size())
+                .key("type").value(Vehicle::vehicleTypeName(req.getVehicleType()))
+                .key("status").value(req.getStateName())
+                .key("zone").value(req.getAllocatedZoneId())
+                .key("area").value(req.getAllocatedAreaId())
+                .key("slot").value(req.getAllocatedSlotId())
+                .key("edits").value(static_cast<int>(match.edits))
+                .key("active").value(match.active)
+                .endObject();
+    }
+    response.endArray().endObject();
+    emit();
+}
+
+static void emitStats() {
+    response.clear();
+    response.beginObject().key("enabled").value(Metrics::isEnabled());
+
+    if (Metrics::isEnabled()) {
+        MetricsSnapshot snapshot = Metrics::snapshot();
+        response.key("threads").value(snapshot.threads).key("operations").beginArray();
+
+        for (int op = 0; op < METRIC_OP_COUNT; op++) {
+            const LatencyHistogram& h = snapshot.latency[op];
+            response.beginObject()
+                    .key("op").value(Metrics::opName(static_cast<MetricOp>(op)))
+                    .key("count").value(h.getCount())
+                    .key("failures").value(snapshot.failures[op])
+                    .key("meanNs").value(static_cast<int64_t>(h.getMean()))
+                    .key("p50Ns").value(h.percentile(50))
+                    .key("p90Ns").value(h.percentile(90))
+                    .key("p99Ns").value(h.percentile(99))
+                    .key("p999Ns").value(h.percentile(99.9))
+                    .key("maxNs").value(h.getMax())
+                    .endObject();
+        }
+        response.endArray();
+    }
+    response.endObject();
+    emit();
+}
+
+static void writeOccupancy(const vector<OccupancyPoint>& points) {
+    response.beginArray();
+    for (const OccupancyPoint& p : points) {
+        response.beginObject()
+                .key("start").value(p.startNanos / Clock::NANOS_PER_SECOND)
+                .key("average").value(p.averageOccupied)
+                .key("peak").value(p.peakOccupied)
+                .key("transitions").value(p.transitions)
+                .key("utilization").value(p.getAverageUtilization())
+                .endObject();
+    }
+    response.endArray();
+}
+
+static void writeQuantiles(const LatencyHistogram& h) {
+    response.beginObject()
+            .key("count").value(h.getCount())
+            .key("meanSeconds").value(h.getMean() / 1e9)
+            .key("p50Seconds").value(h.percentile(50) / 1e9)
+            .key("p90Seconds").value(h.percentile(90) / 1e9)
+            .key("p99Seconds").value(h.percentile(99) / 1e9)
+            .key("maxSeconds").value(h.getMax() / 1e9)
+            .endObject();
+}
+
+static void emitAnalytics(const ParkingSystem& system, const Command& cmd) {
+    const OccupancyAnalytics& analytics = system.getAnalytics();
+    int64_t now = system.getClock().nowNanos();
+    vector<OccupancyPoint> minutes, hours;
+
+    if (!analytics.getSeries(cmd.zoneId, cmd.areaId, RESOLUTION_MINUTE, now, minutes) ||
+        !analytics.getSeries(cmd.zoneId, cmd.areaId, RESOLUTION_HOUR, now, hours)) {
+        emitResult(false, "Unknown zone or area");
+        return;
+    }
+
+    OccupancyPoint peakHour;
+    analytics.getPeak(cmd.zoneId, cmd.areaId, RESOLUTION_HOUR, now, peakHour);
+
+    response.clear();
+    response.beginObject()
+            .key("zone").value(cmd.zoneId)
+            .key("area").value(cmd.areaId)
+            .key("occupied").value(analytics.getOccupied(cmd.zoneId, cmd.areaId))
+            .key("capacity").value(analytics.getCapacity(cmd.zoneId, cmd.areaId))
+            .key("minutes");
+    writeOccupancy(minutes);
+    response.key("hours");
+    writeOccupancy(hours);
+    response.key("peakHour").beginObject()
+            .key("start").value(peakHour.startNanos / Clock::NANOS_PER_SECOND)
+            .key("average").value(peakHour.averageOccupied)
+            .key("peak").value(peakHour.peakOccupied)
+            .endObject();
+
+    // Durations are kept per zone; an area query reports its zone
+    response.key("dwell");
+    writeQuantiles(analytics.getDwellHistogram(cmd.zoneId));
+    response.key("wait");
+    writeQuantiles(analytics.getWaitHistogram(cmd.zoneId));
+    response.endObject();
+    emit();
+}
+
+static void emitCapacity(const vector<CapacityEntry>& entries) {
+    response.clear();
+    response.beginObject().key("results").beginArray();
+    for (const CapacityEntry& entry : entries) {
+        response.beginObject().key("zone").value(entry.zoneId);
+        if (entry.areaId)
+            response.key("area").value(entry.areaId);
+        response.key("free").value(entry.freeSlots).endObject();
+    }
+    response.endArray().endObject();
+    emit();
+}
+
+// Findings listed in one AUDIT response; the counts cover all of them
+static const size_t AUDIT_ISSUES_SHOWN = 100;
+
+static void emitAudit(ParkingSystem& system, const Command& cmd) {
+    AuditReport report = system.audit(cmd.count == 1, 0, cmd.zoneId, cmd.toZoneId);
+    const deque<ParkingRequest>& requests = system.getRequests();
+
+    response.clear();
+    response.beginObject()
+            .key("result").value("success")
+            .key("threads").value(report.threads)
+            .key("zones").value(report.zones)
+            .key("slots").value(static_cast<int64_t>(report.slots))
+            .key("requests").value(static_cast<int64_t>(report.requests))
+            .key("millis").value(report.millis, 2)
+            .key("repaired").value(report.repaired)
+            .key("found").beginObject();
+    for (int k = 0; k < AuditIssue::KIND_COUNT; k++)
+        response.key(AuditIssue::kindName(static_cast<AuditIssue::Kind>(k))).value(report.found[k]);
+    response.endObject().key("issues").beginArray();
+
+    for (size_t i = 0; i < report.issues.size() && i < AUDIT_ISSUES_SHOWN; i++) {
+        const AuditIssue& issue = report.issues[i];
+        response.beginObject()
+                .key("kind").value(AuditIssue::kindName(issue.kind))
+                .key("zone").value(issue.zoneId)
+                .key("area").value(issue.areaId)
+                .key("slot").value(issue.slotId);
+        if (issue.request != AuditIssue::NONE) {
+            const VehiclePlate& plate = requests[issue.request].getVehicleNumber();
+            response.key("vehicle").value(plate.c_str(), plate.size());
+        }
+        if (issue.otherRequest != AuditIssue::NONE) {
+            const VehiclePlate& plate = requests[issue.otherRequest].getVehicleNumber();
+            response.key("otherVehicle").value(plate.c_str(), plate.size());
+        }
+        if (issue.slotId == 0)
+            response.key("expected").value(issue.expected).key("actual").value(issue.actual);
+        response.key("repaired").value(issue.repaired).endObject();
+    }
+    response.endArray().endObject();
+    emit();
+}
+
+static void emitFreeQuery(const ParkingSystem& system, const Command& cmd) {
+    const FreeCapacityIndex& index = system.getFreeIndex();
+    vector<CapacityEntry> entries;
+
+    switch (cmd.type) {
+        case Command::FREE: {
+            int toZone = cmd.toZoneId > 0 ? cmd.toZoneId : system.getLayout().zoneCount;
+            response.clear();
+            response.beginObject()
+                    .key("fromZone").value(cmd.zoneId)
+                    .key("toZone").value(toZone)
+                    .key("free").value(static_cast<int64_t>(index.sumFree(cmd.zoneId, cmd.toZoneId)))
+                    .endObject();
+            emit();
+            return;
+        }
+        case Command::ATLEAST:
+            index.zonesWithAtLeast(cmd.count, cmd.zoneId, cmd.toZoneId, entries);
+            break;
+        case Command::TOPK:
+            index.topZones(cmd.count, cmd.zoneId, cmd.toZoneId, entries);
+            break;
+        default:
+            index.areasWithAtLeast(cmd.zoneId, cmd.count, entries);
+            break;
+    }
+    emitCapacity(entries);
+}
+
+// CLOSE/OPEN/REMOVE/ATTRIBUTES/ADDZONE: {"result", "changed"} or {"result", "zone"}
+static void emitTopology(ParkingSystem& system, const Command& cmd) {
+    int changed;
+    switch (cmd.type) {
+        case Command::ADDZONE: {
+            int zone = system.addZone();
+            response.clear();
+            response.beginObject()
+                    .key("result").value("success")
+                    .key("zone").value(zone)
+                    .endObject();
+            emit();
+            return;
+        }
+        case Command::CLOSE:
+            changed = cmd.areaId == 0 ? system.closeZone(cmd.zoneId)
+                                      : system.closeSlots(cmd.zoneId, cmd.areaId, cmd.fromSlot, cmd.toSlot);
+            break;
+        case Command::OPEN:
+            changed = cmd.areaId == 0 ? system.openZone(cmd.zoneId)
+                                      : system.openSlots(cmd.zoneId, cmd.areaId, cmd.fromSlot, cmd.toSlot);
+            break;
+        case Command::ATTRIBUTES:
+            changed = system.setSlotAttributes(cmd.zoneId, cmd.areaId, cmd.fromSlot, cmd.toSlot,
+                                               cmd.requiredAttributes);
+            break;
+        default:
+            changed = cmd.areaId == 0 ? system.removeZone(cmd.zoneId)
+                                      : system.removeArea(cmd.zoneId, cmd.areaId);
+            break;
+    }
+
+    if (changed < 0) {
+        emitResult(false, "Unknown or removed zone/area");
+        return;
+    }
+    response.clear();
+    response.beginObject()
+            .key("result").value("success")
+            .key("changed").value(changed)
+            .endObject();
+    emit();
+}
+
+static void emitTrace(const Command& cmd) {
+    if (cmd.count >= 0) {
+        SpanTracer::setSampleEvery(static_cast<uint32_t>(cmd.count));
+        emitResult(true, cmd.count ? "Span sampling updated" : "Span sampling disabled");
+        return;
+    }
+
+    ostringstream trace;
+    SpanTracer::exportChromeTrace(trace);
+    string json = trace.str();
+    response.clear();
+    response.raw(json.data(), json.size());
+    emit();
+}
+
+// Returns false on EXIT, and on BINARY once the switch is acknowledged
+static bool runCommand(ParkingSystem& system, Subscription& subscription, const string& line, Command& cmd) {
+    if (!CommandParser::parse(line.data(), line.size(), cmd)) {
+        if (line.find_first_not_of(" \t\r") != string::npos)
+            emitResult(false, "Malformed command");
+        return true;
+    }
+
+    switch (cmd.type) {
+        case Command::PARK: {
+            int fee = 0;
+            bool crossZone = false;
+            bool ok;
+            if (cmd.requiredAttributes != 0 || cmd.preferredAttributes != 0)
+                ok = system.createParkingRequestWithAttributes(cmd.plate, cmd.vehicleType, cmd.zoneId, cmd.areaId,
+                                                               cmd.requiredAttributes, cmd.preferredAttributes,
+                                                               fee, crossZone);
+            else if (cmd.areaId == 0)
+                ok = system.createParkingRequest(cmd.plate, cmd.vehicleType, cmd.zoneId, fee, crossZone);
+            else
+                ok = system.createParkingRequestWithArea(cmd.plate, cmd.vehicleType, cmd.zoneId,
+                                                         cmd.areaId, fee, crossZone);
+            if (ok)
+                emitPark(system, cmd, fee, crossZone);
+            else
+                emitResult(false, "Allocation failed");
+            break;
+        }
+
+        case Command::OCCUPY:
+            if (system.occupyParking(cmd.plate, cmd.vehicleType))
+                emitResult(true, "Occupied");
+            else
+                emitResult(false, "Vehicle not allocated or cannot occupy");
+            break;
+
+        case Command::RELEASE:
+            if (system.releaseParking(cmd.plate, cmd.vehicleType))
+                emitResult(true, "Released");
+            else
+                emitResult(false, "Vehicle not in system or not occupied");
+            break;
+
+        case Command::CANCEL:
+            if (system.cancelRequest(cmd.plate, cmd.vehicleType))
+                emitResult(true, "Cancelled");
+            else
+                emitResult(false, "Request cannot be cancelled");
+            break;
+
+        case Command::ROLLBACK:
+            if (system.rollbackLast(cmd.count))
+                emitResult(true, "Rolled back");
+            else
+                emitResult(false, "Not enough operations to roll back, or a request has moved on");
+            break;
+
+        case Command::STATUS:
+            emitStatus(system);
+            break;
+
+        case Command::HISTORY:
+            emitHistory(system, cmd.count);
+            break;
+
+        case Command::SEARCH:
+            emitSearch(system, cmd);
+            break;
+
+        case Command::STATS:
+            emitStats();
+            break;
+
+        case Command::ANALYTICS:
+            emitAnalytics(system, cmd);
+            break;
+
+        case Command::FREE:
+        case Command::ATLEAST:
+        case Command::TOPK:
+        case Command::AREAS:
+            emitFreeQuery(system, cmd);
+            break;
+
+        case Command::SUBSCRIBE:
+            emitSubscribe(system, subscription, cmd.count);
+            break;
+
+        case Command::UNSUBSCRIBE:
+            subscription.active = false;
+            emitResult(true, "Unsubscribed");
+            break;
+
+        case Command::DELTA:
+            emitDelta(system, cmd.version);
+            break;
+
+        case Command::TRACE:
+            emitTrace(cmd);
+            break;
+
+        case Command::CLOSE:
+        case Command::OPEN:
+        case Command::REMOVE:
+        case Command::ATTRIBUTES:
+        case Command::ADDZONE:
+            emitTopology(system, cmd);
+            break;
+
+        case Command::AUDIT:
+            emitAudit(system, cmd);
+            break;
+
+        case Command::BINARY:
+            subscription.active = false;   // text pushes would corrupt the frame stream
+            emitResult(true, "Binary protocol");
+            return false;
+
+        case Command::EXIT:
+            return false;
+
+        default:
+            emitResult(false, "Unknown command");
+    }
+
+    return true;
+}
+
+// Work per hold of the command lock
+static const int AUDIT_SLICE = 64;            // zones
+static const size_t AUDIT_REQUESTS = 262144;  // requests claimed
+
+// Every `seconds`, sweeps the city with one CityAudit, letting commands
+// in between steps so a multi-million-slot city never holds up traffic
+// for a whole pass. Slots those commands touch are left to the next
+// pass; a pass that falls too far behind the change log is abandoned.
+static void runAuditor(ParkingSystem& system, Subscription& subscription, int seconds) {
+    unique_lock<mutex> lock(subscription.guard);
+    chrono::steady_clock::time_point due = chrono::steady_clock::now() + chrono::seconds(seconds);
+    auto pause = [&]() {
+        lock.unlock();
+        this_thread::yield();
+        lock.lock();
+        return !subscription.stopping;
+    };
+
+    while (!subscription.stopping) {
+        if (subscription.wake.wait_until(lock, due) != cv_status::timeout)
+            continue;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        AuditReport report;
+        CityAudit audit(system);
+        bool running = true;
+        while (running && !audit.claimSlots(report, AUDIT_REQUESTS))
+            running = pause();
+        for (int from = 1; running && from <= audit.getZoneCount(); from += AUDIT_SLICE) {
+            if (!audit.checkSlots(report, from, from + AUDIT_SLICE - 1)) {
+                cerr << "⚠ Audit: too much traffic, pass abandoned\n";
+                break;
+            }
+            system.repairAudit(report, 0);
+            size_t counters = report.issues.size();
+            audit.checkCounters(report, from, from + AUDIT_SLICE - 1);
+            system.repairAudit(report, counters);
+            report.issues.clear();
+            running = pause();
+        }
+        if (report.totalFound() > 0)
+            cerr << "⚠ Audit: " << report.totalFound() << " inconsistencies, " << report.repaired
+                 << " repaired (" << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+                 << " ms)\n";
+        due = chrono::steady_clock::now() + chrono::seconds(seconds);
+    }
+}
+
+// Serves frames until end of input. Per-operation console messages are
+// muted so they cannot interleave with frames; responses bypass the
+// muted stream and go to its buffer, one write per burst of requests.
+static void runBinary(ParkingSystem& system, Subscription& subscription) {
+    BinaryFrameReader reader(cin.rdbuf());
+    BinaryFrameWriter writer;
+    const BinaryHeader* header;
+    const char* body;
+
+    cout.flush();
+    cout.setstate(ios::failbit);
+    while (reader.next(header, body)) {
+        {
+            lock_guard<mutex> lock(subscription.guard);
+            BinaryProtocol::handle(system, *header, body, writer);
+        }
+        if (!reader.hasBufferedFrame() || writer.size() >= 64 * 1024)
+            writer.flushTo(cout.rdbuf());
+    }
+    writer.flushTo(cout.rdbuf());
+    cout.clear();
+
+    if (reader.isBroken())
+        cerr << "❌ Binary protocol: invalid frame length, closing\n";
+}
+
+int main(int argc, char** argv) {
+    ParkingSystem system;
+    int auditSeconds = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--shm") == 0) {
+            const char* segment = StatusPublisher::DEFAULT_NAME;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                segment = argv[++i];
+            if (!system.publishStatus(segment))
+                cerr << "⚠ Cannot create shared status region " << segment << "\n";
+        } else if (strcmp(argv[i], "--audit") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            auditSeconds = atoi(argv[++i]);
+        } else {
+            cerr << "Usage: ServerMain [--shm [NAME]] [--audit SECONDS]\n";
+            return 1;
+        }
+    }
+
+    // Fix the tick length now rather than on the first STATS
+    Metrics::calibrate();
+
+    Subscription subscription;
+    string line;
+    Command cmd;
+
+    thread pusher(runPusher, cref(system), ref(subscription));
+    thread auditor;
+    if (auditSeconds > 0)
+        auditor = thread(runAuditor, ref(system), ref(subscription), auditSeconds);
+
+    // getline reuses the same buffer, so steady-state parsing allocates nothing
+    while (getline(cin, line)) {
+        lock_guard<mutex> lock(subscription.guard);
+        if (!runCommand(system, subscription, line, cmd))
+            break;
+    }
+
+    if (cmd.type == Command::BINARY)
+        runBinary(system, subscription);
+
+    {
+        lock_guard<mutex> lock(subscription.guard);
+        subscription.stopping = true;
+    }
+    subscription.wake.notify_all();
+    pusher.join();
+    if (auditor.joinable())
+        auditor.join();
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ParkingSystem.h"
+#include "ShardCoordinator.h"
+#include "ConsoleMute.h"
+
+// One process holding the whole city vs zones sharded across workers.
+//
+//   ShardBenchmark [--shards N] [--ops N] [--zones N] [--areas N] [--slots N] [--hot P]
+//
+// The workload parks a new vehicle, occupies it and releases the one
+// parked `live` cycles earlier, keeping about 60% of the city busy. P% of
+// the PARKs (default 30) target zone 1, which overflows and exercises the
+// cross-zone fallback. The same command list is run:
+//   in-process        ParkingSystem calls, no IPC
+//   1 shard           the whole city in one worker behind the coordinator
+//   N shards, sync    one command per round trip
+//   N shards, piped   ShardCoordinator::WINDOW commands per round trip
+
+typedef std::chrono::steady_clock WallClock;
+
+struct RunStats {
+    double seconds;
+    unsigned long long ok;
+    unsigned long long crossZone;
+    unsigned long long fallbacks;    // placed on another shard by scatter-gather
+};
+
+static void buildWorkload(const CityLayout& layout, int cycles, int hotPercent, std::vector<IngestCommand>& out) {
+    std::mt19937 random(42);
+    int live = layout.getTotalSlots() * 6 / 10;
+    char plate[16];
+    out.clear();
+    for (int i = 0; i < cycles; i++) {
+        std::snprintf(plate, sizeof(plate), "SH%07d", i);
+        int zone = static_cast<int>(random() % 100) < hotPercent ? 1 : 1 + static_cast<int>(random() % layout.zoneCount);
+        out.push_back(IngestCommand::park(plate, Vehicle::CAR, zone));
+        out.push_back(IngestCommand::occupy(plate, Vehicle::CAR));
+        if (i >= live) {
+            std::snprintf(plate, sizeof(plate), "SH%07d", i - live);
+            out.push_back(IngestCommand::release(plate, Vehicle::CAR));
+        }
+    }
+}
+
+static RunStats runInProcess(const CityLayout& layout, const std::vector<IngestCommand>& commands) {
+    ConsoleMute mute;
+    ParkingSystem system(layout);
+    RunStats stats = { 0.0, 0, 0, 0 };
+
+    auto start = WallClock::now();
+    for (const IngestCommand& command : commands) {
+        int fee = 0;
+        bool crossZone = false;
+        bool ok;
+        if (command.type == IngestCommand::PARK) {
+            ok = system.createParkingRequest(command.plate, command.vehicleType, command.zoneId, fee, crossZone);
+            if (ok && crossZone) stats.crossZone++;
+        } else if (command.type == IngestCommand::OCCUPY) {
+            ok = system.occupyParking(command.plate, command.vehicleType);
+        } else {
+            ok = system.releaseParking(command.plate, command.vehicleType);
+        }
+        if (ok) stats.ok++;
+    }
+    stats.seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+    return stats;
+}
+
+static RunStats runSharded(const CityLayout& layout, int shards, bool pipelined,
+                           const std::vector<IngestCommand>& commands) {
+    RunStats stats = { 0.0, 0, 0, 0 };
+    ShardCoordinator coordinator;
+    if (!coordinator.start(layout, shards)) {
+        std::cerr << "could not start " << shards << " shards\n";
+        return stats;
+    }
+
+    std::vector<IngestResult> results(commands.size());
+    auto start = WallClock::now();
+    if (pipelined) {
+        coordinator.execute(commands.data(), commands.size(), results.data());
+    } else {
+        for (size_t i = 0; i < commands.size(); i++)
+            coordinator.execute(commands[i], results[i]);
+    }
+    stats.seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+
+    for (const IngestResult& result : results)
+        if (result.ok) {
+            stats.ok++;
+            if (result.crossZone) stats.crossZone++;
+        }
+    stats.fallbacks = coordinator.getFallbackCount();
+    coordinator.stop();
+    return stats;
+}
+
+static void print(const char* label, const RunStats& stats, size_t commands) {
+    std::printf("%-20s %10.0f cmd/s   ok %llu/%zu   cross-zone %llu (cross-shard %llu)\n", label,
+                commands / stats.seconds, stats.ok, commands, stats.crossZone, stats.fallbacks);
+}
+
+int main(int argc, char* argv[]) {
+    int shards = 4;
+    int cycles = 100000;
+    int hotPercent = 30;
+    CityLayout layout;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) shards = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) cycles = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--zones") == 0 && i + 1 < argc) layout.zoneCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--areas") == 0 && i + 1 < argc) layout.areasPerZone = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--slots") == 0 && i + 1 < argc) layout.slotsPerArea = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--hot") == 0 && i + 1 < argc) hotPercent = std::atoi(argv[++i]);
+        else {
+            std::cerr << "usage: ShardBenchmark [--shards N] [--ops N] [--zones N] [--areas N] [--slots N] [--hot P]\n";
+            return 1;
+        }
+    }
+    if (shards < 1 || shards > layout.zoneCount) {
+        std::cerr << "--shards must be between 1 and the zone count\n";
+        return 1;
+    }
+
+    std::vector<IngestCommand> commands;
+    buildWorkload(layout, cycles, hotPercent, commands);
+    std::printf("%d zones x %d areas x %d slots, %zu commands, %d%% of PARKs to zone 1\n\n",
+                layout.zoneCount, layout.areasPerZone, layout.slotsPerArea, commands.size(), hotPercent);
+
+    print("in-process", runInProcess(layout, commands), commands.size());
+    print("1 shard, sync", runSharded(layout, 1, false, commands), commands.size());
+    char label[32];
+    std::snprintf(label, sizeof(label), "%d shards, sync", shards);
+    print(label, runSharded(layout, shards, false, commands), commands.size());
+    std::snprintf(label, sizeof(label), "%d shards, piped", shards);
+    print(label, runSharded(layout, shards, true, commands), commands.size());
+    return 0;
+}
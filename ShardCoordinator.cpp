@@ -0,0 +1,283 @@
+#include "ShardCoordinator.h"
+#include "ConsoleMute.h"
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// -------- Lifecycle --------
+ShardCoordinator::ShardCoordinator() : nextSequence(1), fallbacks(0) {}
+
+ShardCoordinator::~ShardCoordinator() {
+    stop();
+}
+
+// Worker process main loop: answers every frame, flushing once per burst
+void ShardCoordinator::runWorker(int fd, const CityLayout& layout) {
+    ConsoleMute mute;   // the forked child shares the parent's stdout
+    ParkingSystem system(layout);
+    FdStreamBuf stream(fd);
+    BinaryFrameReader reader(&stream);
+    BinaryFrameWriter writer;
+
+    const BinaryHeader* header;
+    const char* body;
+    while (reader.next(header, body)) {
+        BinaryProtocol::handle(system, *header, body, writer);
+        if (!reader.hasBufferedFrame())
+            writer.flushTo(&stream);
+    }
+}
+
+bool ShardCoordinator::start(const CityLayout& layout, int shardCount) {
+    stop();
+    if (shardCount < 1 || shardCount > layout.zoneCount)
+        return false;
+
+    city = layout;
+    int firstZone = 1;
+    std::cout.flush();
+
+    for (int i = 0; i < shardCount; i++) {
+        int zones = layout.zoneCount / shardCount + (i < layout.zoneCount % shardCount ? 1 : 0);
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            stop();
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            ::close(pair[0]);
+            ::close(pair[1]);
+            stop();
+            return false;
+        }
+        if (pid == 0) {
+            // Worker: drop every coordinator-side socket so EOF reaches the others
+            ::close(pair[0]);
+            for (auto shard : shards)
+                ::close(shard->fd);
+            runWorker(pair[1], CityLayout(zones, layout.areasPerZone, layout.slotsPerArea));
+            _exit(0);
+        }
+
+        ::close(pair[1]);
+        Shard* shard = new Shard();
+        shard->firstZone = firstZone;
+        shard->zoneCount = zones;
+        shard->slotOffset = (firstZone - 1) * layout.areasPerZone * layout.slotsPerArea;
+        shard->pid = pid;
+        shard->fd = pair[0];
+        shard->stream = new FdStreamBuf(pair[0]);
+        shard->reader = new BinaryFrameReader(shard->stream);
+        shards.push_back(shard);
+        firstZone += zones;
+    }
+    return true;
+}
+
+// Closing the socket ends the worker's read loop
+void ShardCoordinator::stop() {
+    for (auto shard : shards) {
+        delete shard->reader;
+        delete shard->stream;
+        ::close(shard->fd);
+        waitpid(shard->pid, nullptr, 0);
+        delete shard;
+    }
+    shards.clear();
+    plateShard[0].clear();
+    plateShard[1].clear();
+}
+
+int ShardCoordinator::getShardCount() const {
+    return static_cast<int>(shards.size());
+}
+
+uint64_t ShardCoordinator::getFallbackCount() const {
+    return fallbacks;
+}
+
+int ShardCoordinator::shardForZone(int zoneId) const {
+    for (size_t i = 0; i < shards.size(); i++)
+        if (zoneId >= shards[i]->firstZone && zoneId < shards[i]->firstZone + shards[i]->zoneCount)
+            return static_cast<int>(i);
+    return -1;
+}
+
+// -------- Frames --------
+static uint16_t binaryOp(IngestCommand::Type type) {
+    switch (type) {
+        case IngestCommand::PARK: return BIN_PARK;
+        case IngestCommand::OCCUPY: return BIN_OCCUPY;
+        case IngestCommand::RELEASE: return BIN_RELEASE;
+        default: return BIN_CANCEL;
+    }
+}
+
+void ShardCoordinator::send(Shard& shard, uint16_t op, const IngestCommand* command, int localZone) {
+    BinaryHeader header;
+    header.length = 0;
+    header.op = op;
+    header.status = 0;
+    header.sequence = nextSequence++;
+    shard.writer.beginFrame(header, 0);
+
+    if (command) {
+        BinaryVehicleRequest* request = static_cast<BinaryVehicleRequest*>(shard.writer.appendBody(sizeof(BinaryVehicleRequest)));
+        std::memcpy(request->plate, command->plate.c_str(), static_cast<size_t>(command->plate.size()));
+        request->vehicleType = command->vehicleType == Vehicle::CAR ? 1 : 2;
+        request->zoneId = localZone;
+        request->areaId = command->areaId;
+    }
+    shard.writer.endFrame();
+}
+
+bool ShardCoordinator::receive(Shard& shard, const BinaryHeader*& header, const char*& body) {
+    return shard.reader->next(header, body);
+}
+
+// Shard-local ids to city-wide ids
+void ShardCoordinator::decode(const Shard& shard, const BinaryHeader& header, const char* body,
+                              IngestResult& result) const {
+    result.ok = header.status == BIN_OK;
+    if (!result.ok)
+        return;
+
+    if (header.op == BIN_PARK && header.length >= sizeof(BinaryParkResponse)) {
+        const BinaryParkResponse* park = reinterpret_cast<const BinaryParkResponse*>(body);
+        result.slotId = park->slotId + shard.slotOffset;
+        result.zoneId = park->zoneId + shard.firstZone - 1;
+        result.areaId = park->areaId;
+        result.fee = park->fee;
+        result.crossZone = park->crossZone != 0;
+    } else if (header.op == BIN_RELEASE && header.length >= sizeof(BinaryReleaseResponse)) {
+        BinaryReleaseResponse release;
+        std::memcpy(&release, body, sizeof(release));
+        result.charge = release.chargePaisa;
+    }
+}
+
+// -------- Routing --------
+// Returns the shard to send the command to, or -1 when it is answered
+// here (unknown plate, duplicate, invalid input, ROLLBACK)
+int ShardCoordinator::routeCommand(const IngestCommand& command, IngestResult& result) {
+    result.ok = false;
+    if (command.type == IngestCommand::ROLLBACK || !command.plate.isValid())
+        return -1;
+
+    std::unordered_map<VehiclePlate, int, VehiclePlateHash>& plates = plateShard[command.vehicleType];
+    auto known = plates.find(command.plate);
+
+    if (command.type != IngestCommand::PARK)
+        return known == plates.end() ? -1 : known->second;
+
+    // A plate is registered for good once it has asked for a slot, as in
+    // ParkingSystem, so it can never be parked on two shards
+    if (known != plates.end() || command.areaId < 0 || command.areaId > city.areasPerZone)
+        return -1;
+
+    int home = shardForZone(command.zoneId);
+    plates[command.plate] = home >= 0 ? home : 0;
+    return home >= 0 ? home : -2;   // -2: no home shard, go straight to the fallback
+}
+
+// Scatter FREE to every other shard, gather the counts, then PARK on the
+// first shard with room in zone order (what AllocationEngine's cross-zone
+// loop does within one process).
+bool ShardCoordinator::fallbackPark(const IngestCommand& command, int homeShard, IngestResult& result) {
+    for (size_t i = 0; i < shards.size(); i++)
+        if (static_cast<int>(i) != homeShard) {
+            send(*shards[i], BIN_FREE, nullptr, 0);
+            shards[i]->writer.flushTo(shards[i]->stream);
+        }
+
+    std::vector<int> freeSlots(shards.size(), 0);
+    const BinaryHeader* header;
+    const char* body;
+    for (size_t i = 0; i < shards.size(); i++)
+        if (static_cast<int>(i) != homeShard && receive(*shards[i], header, body) &&
+            header->status == BIN_OK && header->length >= sizeof(BinaryFreeResponse))
+            freeSlots[i] = reinterpret_cast<const BinaryFreeResponse*>(body)->freeSlots;
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        if (freeSlots[i] <= 0)
+            continue;
+        Shard& shard = *shards[i];
+        send(shard, BIN_PARK, &command, 1);
+        shard.writer.flushTo(shard.stream);
+        if (!receive(shard, header, body))
+            continue;
+        decode(shard, *header, body, result);
+        if (!result.ok)
+            continue;
+
+        plateShard[command.vehicleType][command.plate] = static_cast<int>(i);
+        if (!result.crossZone)
+            result.fee += 50;   // cross-zone penalty, as AllocationEngine charges
+        result.crossZone = true;
+        fallbacks++;
+        return true;
+    }
+    return false;
+}
+
+// One pipelined round. PARKs that fail on their home shard are placed
+// afterwards by fallbackPark; later commands in the window for the same
+// plate were refused by the home shard without side effects and are
+// re-run on the shard the vehicle ended up on.
+void ShardCoordinator::runWindow(const IngestCommand* commands, size_t count, IngestResult* results) {
+    route.assign(count, -1);
+    for (size_t k = 0; k < count; k++) {
+        results[k] = IngestResult();
+        int target = routeCommand(commands[k], results[k]);
+        route[k] = target;
+        if (target >= 0) {
+            int localZone = commands[k].type == IngestCommand::PARK
+                ? commands[k].zoneId - shards[target]->firstZone + 1 : 0;
+            send(*shards[target], binaryOp(commands[k].type), &commands[k], localZone);
+        }
+    }
+    for (auto shard : shards)
+        shard->writer.flushTo(shard->stream);
+
+    const BinaryHeader* header;
+    const char* body;
+    for (size_t k = 0; k < count; k++)
+        if (route[k] >= 0 && receive(*shards[route[k]], header, body))
+            decode(*shards[route[k]], *header, body, results[k]);
+
+    for (size_t k = 0; k < count; k++) {
+        if (commands[k].type != IngestCommand::PARK || results[k].ok || route[k] == -1)
+            continue;
+        if (!fallbackPark(commands[k], route[k], results[k]))
+            continue;
+
+        for (size_t later = k + 1; later < count; later++) {
+            if (commands[later].type == IngestCommand::PARK || commands[later].plate != commands[k].plate ||
+                commands[later].vehicleType != commands[k].vehicleType)
+                continue;
+            IngestResult retry;
+            int target = routeCommand(commands[later], retry);
+            if (target < 0)
+                continue;
+            send(*shards[target], binaryOp(commands[later].type), &commands[later], 0);
+            shards[target]->writer.flushTo(shards[target]->stream);
+            if (receive(*shards[target], header, body))
+                decode(*shards[target], *header, body, retry);
+            results[later] = retry;
+        }
+    }
+}
+
+void ShardCoordinator::execute(const IngestCommand* commands, size_t count, IngestResult* results) {
+    for (size_t done = 0; done < count; done += WINDOW)
+        runWindow(commands + done, count - done < static_cast<size_t>(WINDOW) ? count - done : WINDOW,
+                  results + done);
+}
+
+void ShardCoordinator::execute(const IngestCommand& command, IngestResult& result) {
+    runWindow(&command, 1, &result);
+}
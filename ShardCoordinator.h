@@ -0,0 +1,88 @@
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+#include "BinaryProtocol.h"
+#include "FdStreamBuf.h"
+#include "IngestEngine.h"    // IngestCommand / IngestResult
+#include "ParkingSystem.h"   // CityLayout
+#include "VehiclePlate.h"
+
+// Zones partitioned across worker processes on one machine.
+//
+// start() forks one worker per shard. Each worker owns a ParkingSystem
+// for a contiguous range of zones and talks BinaryProtocol frames over
+// its end of a Unix socket pair. The coordinator keeps only routing
+// state:
+//   PARK                     goes to the shard owning requestedZoneId;
+//                            if that shard has no slot, the cross-zone
+//                            fallback runs as a scatter-gather (FREE to
+//                            every other shard, then PARK on the first
+//                            one with room, in zone order)
+//   OCCUPY / RELEASE / CANCEL go to the shard that holds the plate
+// Results use city-wide zone and slot ids, as if one process held the
+// whole city.
+//
+// execute() on a batch pipelines it: frames for every shard are written
+// first, a window at a time, and the answers read back afterwards, so
+// the shards work in parallel and each round trip is paid once per
+// window. ROLLBACK is not supported across shards (ok = false).
+//
+// Not thread-safe: one thread drives the coordinator.
+class ShardCoordinator {
+public:
+    static const int WINDOW = 256;   // commands in flight per pipelined round
+
+private:
+    struct Shard {
+        int firstZone;               // city-wide id of the shard's zone 1
+        int zoneCount;
+        int slotOffset;              // city-wide id of the shard's slot 1, minus one
+        pid_t pid;
+        int fd;
+        FdStreamBuf* stream;
+        BinaryFrameReader* reader;
+        BinaryFrameWriter writer;
+    };
+
+    CityLayout city;
+    std::vector<Shard*> shards;
+    std::unordered_map<VehiclePlate, int, VehiclePlateHash> plateShard[2];
+    uint32_t nextSequence;
+    uint64_t fallbacks;
+
+    std::vector<int> route;          // per command in the current window, -1 = answered locally
+
+    int shardForZone(int zoneId) const;
+    static void runWorker(int fd, const CityLayout& layout);
+
+    void send(Shard& shard, uint16_t op, const IngestCommand* command, int localZone);
+    bool receive(Shard& shard, const BinaryHeader*& header, const char*& body);
+    void decode(const Shard& shard, const BinaryHeader& header, const char* body, IngestResult& result) const;
+    int routeCommand(const IngestCommand& command, IngestResult& result);
+    bool fallbackPark(const IngestCommand& command, int homeShard, IngestResult& result);
+    void runWindow(const IngestCommand* commands, size_t count, IngestResult* results);
+
+    ShardCoordinator(const ShardCoordinator&);
+    ShardCoordinator& operator=(const ShardCoordinator&);
+
+public:
+    ShardCoordinator();
+    ~ShardCoordinator();             // stops the workers
+
+    // Splits city.zoneCount zones into shardCount contiguous ranges
+    bool start(const CityLayout& city, int shardCount);
+    void stop();
+
+    int getShardCount() const;
+    uint64_t getFallbackCount() const;   // PARKs placed by scatter-gather
+
+    void execute(const IngestCommand& command, IngestResult& result);
+    void execute(const IngestCommand* commands, size_t count, IngestResult* results);
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "SpanTracer.h"
+#include "TrafficSimulator.h"
+
+// Load generator for ParkingSystem.
+//
+//   Simulator [--zones N] [--areas N] [--slots N] [--hours H] [--rate R]
+//             [--dwell H] [--sample M] [--seed S] [--flat]
+//             [--record FILE] [--trace FILE]
+//             [--spans FILE] [--span-every N]
+//
+// --rate is arrivals/hour per zone; --trace replays a recorded gate trace
+// instead of generating traffic; --record saves the generated trace;
+// --spans writes sampled allocation spans as Chrome trace JSON (one
+// request in --span-every, default 100).
+
+using namespace std;
+
+static void usage() {
+    cout << "Usage: Simulator [--zones N] [--areas N] [--slots N] [--hours H]\n"
+         << "                 [--rate R] [--dwell H] [--sample M] [--seed S] [--flat]\n"
+         << "                 [--record FILE] [--trace FILE]\n"
+         << "                 [--spans FILE] [--span-every N]\n";
+}
+
+int main(int argc, char** argv) {
+    SimulationConfig config;
+    const char* tracePath = nullptr;
+    const char* recordPath = nullptr;
+    const char* spansPath = nullptr;
+    int spanEvery = 100;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--flat") == 0) {
+            config.dailyPeaks = false;
+            continue;
+        }
+        if (strcmp(arg, "--help") == 0 || value == nullptr) {
+            usage();
+            return strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+
+        if (strcmp(arg, "--zones") == 0)       config.layout.zoneCount = atoi(value);
+        else if (strcmp(arg, "--areas") == 0)  config.layout.areasPerZone = atoi(value);
+        else if (strcmp(arg, "--slots") == 0)  config.layout.slotsPerArea = atoi(value);
+        else if (strcmp(arg, "--hours") == 0)  config.durationHours = atof(value);
+        else if (strcmp(arg, "--rate") == 0)   config.defaultProfile.arrivalsPerHour = atof(value);
+        else if (strcmp(arg, "--dwell") == 0)  config.defaultProfile.meanDwellHours = atof(value);
+        else if (strcmp(arg, "--sample") == 0) config.sampleMinutes = atof(value);
+        else if (strcmp(arg, "--seed") == 0)   config.seed = static_cast<unsigned int>(atoi(value));
+        else if (strcmp(arg, "--trace") == 0)  tracePath = value;
+        else if (strcmp(arg, "--record") == 0) recordPath = value;
+        else if (strcmp(arg, "--spans") == 0)  spansPath = value;
+        else if (strcmp(arg, "--span-every") == 0) spanEvery = atoi(value);
+        else {
+            usage();
+            return 1;
+        }
+        i++;
+    }
+
+    if (config.layout.zoneCount <= 0 || config.layout.areasPerZone <= 0 || config.layout.slotsPerArea <= 0) {
+        cout << "❌ City dimensions must be positive\n";
+        return 1;
+    }
+
+    if (spansPath)
+        SpanTracer::setSampleEvery(spanEvery > 0 ? static_cast<uint32_t>(spanEvery) : 1);
+
+    TrafficSimulator simulator(config);
+    SimulationReport report;
+
+    if (tracePath) {
+        ifstream trace(tracePath);
+        if (!trace) {
+            cout << "❌ Cannot open trace " << tracePath << "\n";
+            return 1;
+        }
+        report = simulator.replayTrace(trace);
+    } else if (recordPath) {
+        ofstream record(recordPath);
+        if (!record) {
+            cout << "❌ Cannot write trace " << recordPath << "\n";
+            return 1;
+        }
+        report = simulator.runSynthetic(&record);
+    } else {
+        report = simulator.runSynthetic();
+    }
+
+    cout << "City: " << config.layout.zoneCount << " zones x " << config.layout.areasPerZone
+         << " areas x " << config.layout.slotsPerArea << " slots = "
+         << config.layout.getTotalSlots() << " slots\n";
+    report.print(cout);
+
+    if (spansPath) {
+        ofstream spans(spansPath);
+        if (!spans) {
+            cout << "❌ Cannot write spans " << spansPath << "\n";
+            return 1;
+        }
+        SpanTracer::exportChromeTrace(spans);
+        cout << "Spans written to " << spansPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "SlotAttributeIndex.h"
+
+// -------- Constructor --------
+SlotAttributeIndex::SlotAttributeIndex(int zones, int areas, int slots)
+    : zoneCount(0), areasPerZone(areas), slotsPerArea(slots),
+      bitWords((slots + 63) / 64), summaryWords((bitWords + 63) / 64) {
+    for (int z = 0; z < zones; z++)
+        addZone();
+}
+
+int SlotAttributeIndex::addZone() {
+    zoneFree.resize(zoneFree.size() + CLASSES, 0);
+    zoneCount++;
+    for (int a = 0; a < areasPerZone; a++)
+        addArea();
+    return zoneCount;
+}
+
+// Every slot of a new area is free and plain
+void SlotAttributeIndex::addArea() {
+    int leaf = static_cast<int>(sets.size() / CLASSES);
+    sets.resize(sets.size() + CLASSES, static_cast<uint32_t>(ABSENT));
+    areaFree.resize(areaFree.size() + CLASSES, 0);
+
+    int firstSlot = leaf * slotsPerArea + 1;
+    for (int s = 0; s < slotsPerArea; s++)
+        setBit(firstSlot + s, 0, true);
+}
+
+// -------- Helpers --------
+bool SlotAttributeIndex::matches(int cls, uint8_t required, uint8_t forbidden) {
+    return (cls & required) == required && (cls & forbidden) == 0;
+}
+
+uint32_t SlotAttributeIndex::setFor(int leaf, int cls) {
+    uint32_t& offset = sets[static_cast<size_t>(leaf) * CLASSES + cls];
+    if (offset == ABSENT) {
+        offset = static_cast<uint32_t>(words.size());
+        words.resize(words.size() + summaryWords + bitWords, 0);
+    }
+    return offset;
+}
+
+// Returns whether the bit changed; counts follow only real changes
+bool SlotAttributeIndex::setBit(int slotId, int cls, bool free) {
+    int leaf = (slotId - 1) / slotsPerArea;
+    int position = (slotId - 1) % slotsPerArea;
+    if (slotId < 1 || leaf >= static_cast<int>(areaFree.size() / CLASSES))
+        return false;
+    if (!free && sets[static_cast<size_t>(leaf) * CLASSES + cls] == ABSENT)
+        return false;
+
+    uint32_t offset = setFor(leaf, cls);
+    int word = position >> 6;
+    uint64_t bit = uint64_t(1) << (position & 63);
+    uint64_t& bits = words[offset + summaryWords + word];
+    if (((bits & bit) != 0) == free)
+        return false;
+
+    uint64_t& summary = words[offset + (word >> 6)];
+    uint64_t summaryBit = uint64_t(1) << (word & 63);
+    if (free) {
+        bits |= bit;
+        summary |= summaryBit;
+    } else {
+        bits &= ~bit;
+        if (bits == 0)
+            summary &= ~summaryBit;
+    }
+
+    int delta = free ? 1 : -1;
+    areaFree[static_cast<size_t>(leaf) * CLASSES + cls] += delta;
+    zoneFree[static_cast<size_t>(leaf / areasPerZone) * CLASSES + cls] += delta;
+    return true;
+}
+
+// Position of the first free slot of a set, -1 if none
+int SlotAttributeIndex::firstInSet(uint32_t offset) const {
+    for (int s = 0; s < summaryWords; s++) {
+        uint64_t summary = words[offset + s];
+        if (summary == 0)
+            continue;
+        // A summary bit is set only for a non-zero word, so ctz is defined
+        int word = s * 64 + __builtin_ctzll(summary);
+        return word * 64 + __builtin_ctzll(words[offset + summaryWords + word]);
+    }
+    return -1;
+}
+
+// -------- Updates --------
+void SlotAttributeIndex::recordSlotChange(const ParkingSlot& slot, bool nowAvailable) {
+    setBit(slot.getSlotId(), slot.getAttributes(), nowAvailable);
+}
+
+void SlotAttributeIndex::recordAttributeChange(const ParkingSlot& slot, uint8_t before) {
+    if (!slot.isAvailable())
+        return;
+    setBit(slot.getSlotId(), before, false);
+    setBit(slot.getSlotId(), slot.getAttributes(), true);
+}
+
+// -------- Queries --------
+int SlotAttributeIndex::findFree(int zoneId, int areaId, uint8_t required, uint8_t forbidden) const {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 1 || areaId > areasPerZone)
+        return 0;
+
+    int leaf = (zoneId - 1) * areasPerZone + areaId - 1;
+    int best = -1;
+    for (int cls = 0; cls < CLASSES; cls++) {
+        size_t key = static_cast<size_t>(leaf) * CLASSES + cls;
+        if (areaFree[key] == 0 || !matches(cls, required, forbidden))
+            continue;
+        int position = firstInSet(sets[key]);
+        if (position >= 0 && (best < 0 || position < best))
+            best = position;
+    }
+    return best < 0 ? 0 : leaf * slotsPerArea + best + 1;
+}
+
+int SlotAttributeIndex::getAreaFree(int zoneId, int areaId, uint8_t required, uint8_t forbidden) const {
+    if (zoneId < 1 || zoneId > zoneCount || areaId < 1 || areaId > areasPerZone)
+        return 0;
+
+    size_t base = static_cast<size_t>((zoneId - 1) * areasPerZone + areaId - 1) * CLASSES;
+    int free = 0;
+    for (int cls = 0; cls < CLASSES; cls++)
+        if (matches(cls, required, forbidden))
+            free += areaFree[base + cls];
+    return free;
+}
+
+int SlotAttributeIndex::getZoneFree(int zoneId, uint8_t required, uint8_t forbidden) const {
+    if (zoneId < 1 || zoneId > zoneCount)
+        return 0;
+
+    size_t base = static_cast<size_t>(zoneId - 1) * CLASSES;
+    int free = 0;
+    for (int cls = 0; cls < CLASSES; cls++)
+        if (matches(cls, required, forbidden))
+            free += zoneFree[base + cls];
+    return free;
+}
@@ -0,0 +1,71 @@
+#ifndef SLOT_ATTRIBUTE_INDEX_H
+#define SLOT_ATTRIBUTE_INDEX_H
+
+#include <cstdint>
+#include <vector>
+#include "ParkingSlot.h"
+
+// Free slots by attribute, for allocation and routing.
+//
+// Slots of one area are split into classes by their exact attribute
+// flags (2^ATTRIBUTE_COUNT of them). Every class that occurs in an area
+// gets a two-level bitset of its free slots, indexed by position in the
+// area, so "first free slot in area A with attributes >= mask" tests at
+// most one summary word per 4096 slots for each matching class instead
+// of scanning the slots. Free counts per area, zone and class let
+// callers skip areas and zones without a match in O(classes).
+//
+// A query names the flags a slot must have (required) and those it must
+// not have (forbidden); the classes that satisfy both are combined.
+// Setting a bit that is already set (or clearing a clear one) changes no
+// count, so a slot repaired by CityAudit cannot skew the counters.
+class SlotAttributeIndex {
+public:
+    static const int CLASSES = 1 << ParkingSlot::ATTRIBUTE_COUNT;
+
+private:
+    static const uint32_t ABSENT = 0xFFFFFFFFu;
+
+    int zoneCount;
+    int areasPerZone;
+    int slotsPerArea;
+    int bitWords;        // free bits per set, one per slot of the area
+    int summaryWords;    // one summary bit per non-empty bit word
+
+    // Area leaf = (zoneId - 1) * areasPerZone + areaId - 1; slot ids are
+    // dense, so a slot's leaf and position are arithmetic
+    std::vector<uint32_t> sets;       // leaf * CLASSES + class -> offset into words, ABSENT if unused
+    std::vector<uint64_t> words;      // per set: summaryWords summary words, then bitWords free bits
+    std::vector<int32_t> areaFree;    // leaf * CLASSES + class
+    std::vector<int32_t> zoneFree;    // (zoneId - 1) * CLASSES + class
+
+    static bool matches(int cls, uint8_t required, uint8_t forbidden);
+    uint32_t setFor(int leaf, int cls);
+    bool setBit(int slotId, int cls, bool free);
+    int firstInSet(uint32_t offset) const;
+    void addArea();
+
+public:
+    SlotAttributeIndex(int zoneCount, int areasPerZone, int slotsPerArea);
+
+    // A slot (with its current attributes) entering or leaving the free pool
+    void recordSlotChange(const ParkingSlot& slot, bool nowAvailable);
+
+    // A slot's attributes changed from `before`; moves it between classes
+    // if it is free
+    void recordAttributeChange(const ParkingSlot& slot, uint8_t before);
+
+    // Appends zone zoneCount + 1 with every slot free and plain; returns its id
+    int addZone();
+
+    // -------- Queries --------
+    // Lowest free slot id in the area whose attributes include required
+    // and exclude forbidden, 0 if none
+    int findFree(int zoneId, int areaId, uint8_t required, uint8_t forbidden) const;
+
+    // Free slots matching required / forbidden, O(classes)
+    int getAreaFree(int zoneId, int areaId, uint8_t required, uint8_t forbidden) const;
+    int getZoneFree(int zoneId, uint8_t required, uint8_t forbidden) const;
+};
+
+#endif
@@ -0,0 +1,156 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ParkingSystem.h"
+#include "ConsoleMute.h"
+
+// Writer throughput with concurrent status/history readers.
+//
+//   SnapshotBenchmark [--readers N] [--seconds S] [--depth H]
+//
+// One writer cycles PARK/OCCUPY/RELEASE while N reader threads keep
+// reading zone counters and recent history, twice:
+//   locked    readers take the writer's mutex and walk the live structures
+//   snapshot  readers open a CitySnapshotView (RCU + epoch reclamation)
+// Every snapshot read is checked for internal consistency.
+
+typedef std::chrono::steady_clock WallClock;
+
+struct RunResult {
+    double writerOpsPerSecond;
+    double readsPerSecond;
+    unsigned long long torn;
+};
+
+static void writerLoop(ParkingSystem& system, std::mutex* lock, const std::atomic<bool>& stop,
+                       unsigned long long& ops) {
+    int zones = system.getLayout().zoneCount;
+    char plate[16];
+    unsigned long long n = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        std::snprintf(plate, sizeof(plate), "S%llu", n % 100000);
+        int fee = 0;
+        bool crossZone = false;
+        if (lock) lock->lock();
+        system.createParkingRequest(plate, Vehicle::CAR, 1 + static_cast<int>(n % zones), fee, crossZone);
+        system.occupyParking(plate, Vehicle::CAR);
+        system.releaseParking(plate, Vehicle::CAR);
+        if (lock) lock->unlock();
+        n++;
+    }
+    ops = n * 3;
+}
+
+// What displayZoneStatus/displayLastOperations do today, into locals
+static int lockedRead(const ParkingSystem& system, int depth) {
+    int free = 0;
+    for (auto zone : system.getZones())
+        free += zone->getFreeSlots();
+
+    const std::deque<ParkingRequest>& requests = system.getRequests();
+    int seen = 0;
+    for (int i = static_cast<int>(requests.size()) - 1; i >= 0 && seen < depth; i--, seen++)
+        free += requests[i].getState() == ParkingRequest::RELEASED ? 0 : 1;
+    return free;
+}
+
+static bool consistent(const CitySnapshot& snapshot) {
+    int zoneFree = 0, areaFree = 0;
+    for (const ZoneCounters& zone : snapshot.zones) zoneFree += zone.freeSlots;
+    for (const AreaCounters& area : snapshot.areas) areaFree += area.freeSlots;
+    if (zoneFree != snapshot.freeSlots || areaFree != snapshot.freeSlots)
+        return false;
+    for (size_t i = 1; i < snapshot.history.size(); i++)
+        if (snapshot.history[i].requestId >= snapshot.history[i - 1].requestId)
+            return false;
+    return true;
+}
+
+static RunResult run(bool useSnapshots, int readers, double seconds, int depth) {
+    ConsoleMute mute;
+    ParkingSystem system;
+    std::mutex lock;
+    if (useSnapshots)
+        system.enableSnapshots(depth);
+
+    std::atomic<bool> stop(false);
+    std::vector<unsigned long long> reads(readers, 0);
+    std::atomic<unsigned long long> torn(0);
+    std::atomic<int> sink(0);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r]() {
+            unsigned long long n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (useSnapshots) {
+                    CitySnapshotView view(system.getSnapshots());
+                    if (!consistent(*view))
+                        torn++;
+                } else {
+                    std::lock_guard<std::mutex> guard(lock);
+                    sink.fetch_add(lockedRead(system, depth), std::memory_order_relaxed);
+                }
+                n++;
+            }
+            reads[r] = n;
+        });
+    }
+
+    unsigned long long ops = 0;
+    std::thread writer(writerLoop, std::ref(system), useSnapshots ? nullptr : &lock, std::cref(stop), std::ref(ops));
+    auto start = WallClock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    writer.join();
+    for (auto& t : threads) t.join();
+    double elapsed = std::chrono::duration<double>(WallClock::now() - start).count();
+
+    unsigned long long totalReads = 0;
+    for (auto n : reads) totalReads += n;
+
+    RunResult result;
+    result.writerOpsPerSecond = ops / elapsed;
+    result.readsPerSecond = totalReads / elapsed;
+    result.torn = torn.load();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int readers = 4;
+    double seconds = 2.0;
+    int depth = 100;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--readers") == 0)      readers = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seconds") == 0) seconds = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--depth") == 0)   depth = atoi(argv[i + 1]);
+        else {
+            std::printf("Usage: SnapshotBenchmark [--readers N] [--seconds S] [--depth H]\n");
+            return 1;
+        }
+    }
+    if (readers < 0 || seconds <= 0 || depth <= 0) {
+        std::printf("❌ --readers must be >= 0, --seconds and --depth positive\n");
+        return 1;
+    }
+
+    RunResult locked = run(false, readers, seconds, depth);
+    RunResult rcu = run(true, readers, seconds, depth);
+
+    std::printf("%d readers, %.1f s, history depth %d (%u hardware threads)\n",
+                readers, seconds, depth, std::thread::hardware_concurrency());
+    std::printf("  %-10s %12.0f writer ops/s %12.0f reads/s\n", "locked", locked.writerOpsPerSecond, locked.readsPerSecond);
+    std::printf("  %-10s %12.0f writer ops/s %12.0f reads/s\n", "snapshot", rcu.writerOpsPerSecond, rcu.readsPerSecond);
+    if (rcu.torn) {
+        std::printf("❌ %llu inconsistent snapshots\n", rcu.torn);
+        return 1;
+    }
+    return 0;
+}
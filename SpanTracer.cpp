@@ -0,0 +1,185 @@
+#include "SpanTracer.h"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// -------- Per-thread ring --------
+// Single writer. Each slot carries a sequence number (odd while being
+// written) so an exporter can detect and skip a slot it raced with.
+struct SpanSlot {
+    std::atomic<uint64_t> seq;
+    SpanEvent event;
+};
+
+struct SpanRing {
+    uint32_t threadId;
+    std::atomic<uint64_t> head;
+    SpanSlot slots[SpanTracer::RING_CAPACITY];
+
+    explicit SpanRing(uint32_t id) : threadId(id), head(0) {
+        for (int i = 0; i < SpanTracer::RING_CAPACITY; i++)
+            slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct TraceThreadState {
+    SpanRing* ring;
+    bool sampled;
+    int depth;
+    uint32_t requestSeq;
+    uint32_t requestCounter;
+
+    TraceThreadState() : ring(nullptr), sampled(false), depth(0), requestSeq(0), requestCounter(0) {}
+};
+
+static thread_local TraceThreadState t_state;
+static std::atomic<uint32_t> g_sampleEvery(0);
+static std::atomic<uint32_t> g_requestSeq(0);
+
+static std::mutex& ringMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<SpanRing*>& rings() {
+    static std::vector<SpanRing*> all;
+    return all;
+}
+
+static SpanRing* threadRing() {
+    if (t_state.ring == nullptr) {
+        std::lock_guard<std::mutex> lock(ringMutex());
+        t_state.ring = new SpanRing(static_cast<uint32_t>(rings().size() + 1));
+        rings().push_back(t_state.ring);
+    }
+    return t_state.ring;
+}
+
+// -------- Sampling --------
+void SpanTracer::setSampleEvery(uint32_t n) {
+    g_sampleEvery.store(n, std::memory_order_relaxed);
+}
+
+uint32_t SpanTracer::getSampleEvery() {
+    return g_sampleEvery.load(std::memory_order_relaxed);
+}
+
+bool SpanTracer::beginRequest() {
+    uint32_t every = g_sampleEvery.load(std::memory_order_relaxed);
+    if (every == 0)
+        return false;
+    if (++t_state.requestCounter % every != 0)
+        return false;
+
+    threadRing();   // allocate outside the span being timed
+    t_state.sampled = true;
+    t_state.requestSeq = g_requestSeq.fetch_add(1, std::memory_order_relaxed) + 1;
+    return true;
+}
+
+void SpanTracer::endRequest() {
+    t_state.sampled = false;
+}
+
+bool SpanTracer::inSampledRequest() {
+    return t_state.sampled;
+}
+
+int64_t SpanTracer::nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------- Recording --------
+void SpanTracer::record(const char* name, int64_t startNanos, int64_t endNanos, int depth) {
+    SpanRing* ring = threadRing();
+    uint64_t index = ring->head.load(std::memory_order_relaxed);
+    SpanSlot& slot = ring->slots[index % RING_CAPACITY];
+
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.event.name = name;
+    slot.event.startNanos = startNanos;
+    slot.event.durationNanos = endNanos - startNanos;
+    slot.event.requestSeq = t_state.requestSeq;
+    slot.event.depth = static_cast<uint16_t>(depth);
+
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+// -------- Export --------
+void SpanTracer::exportChromeTrace(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(ringMutex());
+    char line[256];
+    bool first = true;
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (auto ring : rings()) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > static_cast<uint64_t>(RING_CAPACITY) ? head - RING_CAPACITY : 0;
+
+        for (uint64_t i = begin; i < head; i++) {
+            const SpanSlot& slot = ring->slots[i % RING_CAPACITY];
+            uint64_t before = slot.seq.load(std::memory_order_acquire);
+            if (before != 2 * i + 2)
+                continue;
+            SpanEvent event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before)
+                continue;
+
+            std::snprintf(line, sizeof(line),
+                "%s\n{\"name\":\"%s\",\"cat\":\"parking\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"request\":%u,\"depth\":%u}}",
+                first ? "" : ",", event.name, ring->threadId,
+                event.startNanos / 1000.0, event.durationNanos / 1000.0,
+                event.requestSeq, static_cast<unsigned>(event.depth));
+            out << line;
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
+
+void SpanTracer::clear() {
+    std::lock_guard<std::mutex> lock(ringMutex());
+    for (auto ring : rings()) {
+        for (int i = 0; i < RING_CAPACITY; i++)
+            ring->slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+// -------- TraceSpan --------
+TraceSpan::TraceSpan(const char* spanName, bool isRequest)
+    : name(spanName), start(0), depth(0), active(false), root(false) {
+    if (isRequest && !SpanTracer::inSampledRequest()) {
+        root = SpanTracer::beginRequest();
+        active = root;
+    } else {
+        active = SpanTracer::inSampledRequest();
+    }
+
+    if (active) {
+        depth = t_state.depth++;
+        start = SpanTracer::nowNanos();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    finish();
+}
+
+void TraceSpan::finish() {
+    if (!active)
+        return;
+
+    active = false;
+    SpanTracer::record(name, start, SpanTracer::nowNanos(), depth);
+    t_state.depth--;
+    if (root)
+        SpanTracer::endRequest();
+}
@@ -0,0 +1,75 @@
+#ifndef SPAN_TRACER_H
+#define SPAN_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+// Sampled span tracing for ParkingSystem and AllocationEngine, exported
+// as Chrome trace-event JSON (open in chrome://tracing or Perfetto).
+//
+// A request-level span (TRACE_REQUEST) decides whether the request is
+// sampled; nested spans (TRACE_SPAN) record only inside a sampled request.
+// Each thread appends to its own fixed-size ring, so recording never
+// locks. Sampling is off until setSampleEvery() is called; build with
+// -DPARKING_TRACING=0 to compile all spans out.
+
+#ifndef PARKING_TRACING
+#define PARKING_TRACING 1
+#endif
+
+struct SpanEvent {
+    const char* name;          // string literal, never freed
+    int64_t startNanos;
+    int64_t durationNanos;
+    uint32_t requestSeq;       // groups spans of one sampled request
+    uint16_t depth;
+};
+
+class SpanTracer {
+public:
+    static const int RING_CAPACITY = 1 << 16;   // events per thread
+
+    // 0 disables; 1 traces every request; N traces one request in N
+    static void setSampleEvery(uint32_t n);
+    static uint32_t getSampleEvery();
+
+    // Called by TraceSpan
+    static bool beginRequest();
+    static void endRequest();
+    static bool inSampledRequest();
+    static void record(const char* name, int64_t startNanos, int64_t endNanos, int depth);
+    static int64_t nowNanos();
+
+    // Writes every buffered span from every thread; spans being overwritten
+    // concurrently are skipped rather than torn.
+    static void exportChromeTrace(std::ostream& out);
+    static void clear();
+};
+
+// -------- Scoped span --------
+class TraceSpan {
+private:
+    const char* name;
+    int64_t start;
+    int depth;
+    bool active;
+    bool root;
+
+public:
+    TraceSpan(const char* spanName, bool isRequest);
+    ~TraceSpan();
+    void finish();
+};
+
+#if PARKING_TRACING
+#define TRACE_REQUEST(var, name)  TraceSpan var(name, true)
+#define TRACE_SPAN(var, name)     TraceSpan var(name, false)
+#define TRACE_END(var)            var.finish()
+#else
+#define TRACE_REQUEST(var, name)  ((void)0)
+#define TRACE_SPAN(var, name)     ((void)0)
+#define TRACE_END(var)            ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef STATIC_CITY_H
+#define STATIC_CITY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include "AllocationLadder.h"
+#include "Clock.h"
+#include "ParkingOperations.h"
+#include "ParkingRequest.h"
+#include "ParkingSlot.h"
+#include "TariffEngine.h"
+
+// Fixed-topology city for embedded gate controllers that manage one known
+// lot: Zones x Areas x Slots is a compile-time constant, every slot and
+// request lives inline in std::arrays, and no operation allocates.
+//
+// The request lifecycle is ParkingRequest's own state machine acting on
+// real ParkingSlots, and allocation is AllocationLadder, the code
+// AllocationEngine runs (search order, attribute ladder, quote), so a
+// gate sees the same answers it would get from ParkingSystem. Per-area
+// free counters, kept by the slot listener, skip full areas without
+// scanning them.
+//
+// Memory is bounded, so a vehicle is refused only while it has a live
+// request (ParkingSystem remembers every plate for good), and the records
+// of finished requests are recycled oldest first once all Requests are in
+// use. A finished request stays visible to lookupRequest until then.
+//
+// Slots and requests point into the object, so it is neither copyable
+// nor movable; give it static storage on the controller.
+template<int Zones, int Areas, int Slots, int Requests = Zones * Areas * Slots>
+class StaticCity final : public ParkingOperations, public SlotListener {
+    static_assert(Zones > 0 && Areas > 0 && Slots > 0, "StaticCity needs at least one slot");
+    static_assert(Requests > 0, "StaticCity needs at least one request record");
+
+public:
+    static constexpr int ZONE_COUNT = Zones;
+    static constexpr int AREAS_PER_ZONE = Areas;
+    static constexpr int SLOTS_PER_AREA = Slots;
+    static constexpr int TOTAL_SLOTS = Zones * Areas * Slots;
+
+    // Same numbering as ParkingSystem::initializeCity (1-based, zone,
+    // area, slot order)
+    static constexpr int slotIdOf(int zoneId, int areaId, int slot) {
+        return ((zoneId - 1) * Areas + (areaId - 1)) * Slots + slot;
+    }
+    static constexpr int zoneOfIndex(int index) { return index / (Areas * Slots) + 1; }
+    static constexpr int areaOfIndex(int index) { return index / Slots % Areas + 1; }
+
+private:
+    // Open-addressed plate index, at most half full
+    static constexpr size_t tableSizeFor(size_t records) {
+        size_t size = 1;
+        while (size < 2 * records)
+            size <<= 1;
+        return size;
+    }
+    static constexpr size_t TABLE_SIZE = tableSizeFor(Requests);
+    static constexpr int32_t EMPTY = -1;
+
+    template<size_t... I>
+    static std::array<ParkingSlot, TOTAL_SLOTS> makeSlots(std::index_sequence<I...>) {
+        return {{ ParkingSlot(static_cast<int>(I) + 1, zoneOfIndex(static_cast<int>(I)),
+                              areaOfIndex(static_cast<int>(I)))... }};
+    }
+
+    std::array<ParkingSlot, TOTAL_SLOTS> slots;
+    std::array<int32_t, Zones * Areas> areaFree;
+    std::array<int32_t, Zones> zoneFree;
+    int32_t freeSlots;
+
+    std::array<std::optional<ParkingRequest>, Requests> records;
+    std::array<int32_t, TABLE_SIZE> index;        // record number, or EMPTY
+    std::array<int32_t, Requests> finished;       // ring, oldest first
+    int32_t finishedHead;
+    int32_t finishedCount;
+    int32_t recordsUsed;                          // never-used records are taken first
+
+    RealClock defaultClock;
+    Clock* clock;
+    const TariffEngine* tariff;                   // not owned, may be null (charge stays 0)
+    int nextRequestId;
+
+    StaticCity(const StaticCity&) = delete;
+    StaticCity& operator=(const StaticCity&) = delete;
+
+    // -------- Plate Index --------
+    static size_t slotFor(const VehiclePlate& plate, Vehicle::VehicleType type) {
+        return (plate.getHash() ^ (static_cast<uint32_t>(type) * 0x9E3779B9u)) & (TABLE_SIZE - 1);
+    }
+
+    bool matches(int32_t record, const VehiclePlate& plate, Vehicle::VehicleType type) const {
+        const ParkingRequest& request = *records[record];
+        return request.getVehicleType() == type && request.getVehicleNumber() == plate;
+    }
+
+    size_t findSlot(const VehiclePlate& plate, Vehicle::VehicleType type) const {
+        size_t at = slotFor(plate, type);
+        while (index[at] != EMPTY && !matches(index[at], plate, type))
+            at = (at + 1) & (TABLE_SIZE - 1);
+        return at;
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken
+    void unindex(int32_t record) {
+        const ParkingRequest& request = *records[record];
+        size_t at = findSlot(request.getVehicleNumber(), request.getVehicleType());
+        if (index[at] != record)
+            return;   // a newer request of the same vehicle replaced it
+
+        size_t hole = at;
+        for (size_t next = (hole + 1) & (TABLE_SIZE - 1); index[next] != EMPTY;
+             next = (next + 1) & (TABLE_SIZE - 1)) {
+            const ParkingRequest& moved = *records[index[next]];
+            size_t home = slotFor(moved.getVehicleNumber(), moved.getVehicleType());
+            // Move it into the hole unless its home lies cyclically in (hole, next]
+            bool stays = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+            if (!stays) {
+                index[hole] = index[next];
+                hole = next;
+            }
+        }
+        index[hole] = EMPTY;
+    }
+
+    static bool isLive(const ParkingRequest& request) {
+        ParkingRequest::RequestState state = request.getState();
+        return state == ParkingRequest::REQUESTED || state == ParkingRequest::ALLOCATED ||
+               state == ParkingRequest::OCCUPIED;
+    }
+
+    int32_t findRecord(const VehiclePlate& plate, Vehicle::VehicleType type) const {
+        return index[findSlot(plate, type)];
+    }
+
+    // A fresh record if any is left, else the oldest finished one
+    int32_t takeRecord() {
+        if (recordsUsed < Requests)
+            return recordsUsed++;
+        if (finishedCount == 0)
+            return EMPTY;
+        int32_t record = finished[finishedHead];
+        finishedHead = (finishedHead + 1) % Requests;
+        finishedCount--;
+        unindex(record);
+        return record;
+    }
+
+    void retire(int32_t record) {
+        finished[(finishedHead + finishedCount) % Requests] = record;
+        finishedCount++;
+    }
+
+    ParkingSlot* slotOf(const ParkingRequest& request) {
+        return request.hasAllocatedSlot() ? &slots[request.getAllocatedSlotId() - 1] : nullptr;
+    }
+
+    // -------- City for AllocationLadder --------
+    friend class AllocationLadder;
+
+    int zoneCount() const { return Zones; }
+    int areaCount(int) const { return Areas; }
+    bool mayHaveFree(int zoneId, const SlotFilter&) const { return zoneFree[zoneId - 1] > 0; }
+    void notice(AllocationLadder::Notice) {}
+
+    bool allocateIn(int zoneId, int areaId, const SlotFilter& filter, ParkingRequest& request) {
+        if (areaFree[(zoneId - 1) * Areas + (areaId - 1)] == 0)
+            return false;
+        ParkingSlot* first = &slots[slotIdOf(zoneId, areaId, 1) - 1];
+        for (ParkingSlot* slot = first; slot != first + Slots; ++slot)
+            if (slot->isAvailable() && slot->hasAttributes(filter.required) &&
+                !(slot->getAttributes() & filter.forbidden))
+                return request.allocateSlot(slot);
+        return false;
+    }
+
+    bool create(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type,
+                int preferredZone, int preferredArea, uint8_t requiredAttributes,
+                uint8_t preferredAttributes, int& fee, bool& crossZoneUsed) {
+        fee = 0;
+        crossZoneUsed = false;
+        if (!vehicleNumber.isValid() || freeSlots == 0)
+            return false;
+        size_t at = findSlot(vehicleNumber, type);
+        if (index[at] != EMPTY && isLive(*records[index[at]]))
+            return false;
+
+        int32_t record = takeRecord();
+        if (record == EMPTY)
+            return false;
+        ParkingRequest& request = records[record].emplace(nextRequestId, Vehicle(vehicleNumber, type, preferredZone),
+                                                          preferredZone, clock->nowNanos(),
+                                                          requiredAttributes, preferredAttributes);
+
+        bool allocated = preferredArea == 0
+            ? AllocationLadder::allocate(*this, request, fee, crossZoneUsed)
+            : AllocationLadder::allocateWithArea(*this, request, preferredArea, fee, crossZoneUsed);
+        if (!allocated) {
+            // Only free slots the attributes rule out; the record goes back unindexed
+            request.cancel(nullptr);
+            retire(record);
+            return false;
+        }
+
+        nextRequestId++;
+        // takeRecord may have shifted entries; probe again
+        index[findSlot(vehicleNumber, type)] = record;
+        return true;
+    }
+
+public:
+    explicit StaticCity(Clock* c = nullptr, const TariffEngine* t = nullptr)
+        : slots(makeSlots(std::make_index_sequence<TOTAL_SLOTS>())),
+          freeSlots(TOTAL_SLOTS), finishedHead(0), finishedCount(0), recordsUsed(0),
+          clock(c ? c : &defaultClock), tariff(t), nextRequestId(1) {
+        areaFree.fill(Slots);
+        zoneFree.fill(Areas * Slots);
+        index.fill(EMPTY);
+        for (ParkingSlot& slot : slots)
+            slot.setListener(this);
+    }
+
+    // -------- ParkingOperations --------
+    bool createParkingRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type,
+                              int preferredZone, int& fee, bool& crossZoneUsed) override {
+        return create(vehicleNumber, type, preferredZone, 0, 0, 0, fee, crossZoneUsed);
+    }
+
+    bool createParkingRequestWithArea(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type,
+                                      int preferredZone, int preferredArea,
+                                      int& fee, bool& crossZoneUsed) override {
+        if (preferredArea < 1 || preferredArea > Areas) {
+            fee = 0;
+            crossZoneUsed = false;
+            return false;
+        }
+        return create(vehicleNumber, type, preferredZone, preferredArea, 0, 0, fee, crossZoneUsed);
+    }
+
+    // As ParkingSystem::createParkingRequestWithAttributes (preferredArea 0 = any area)
+    bool createParkingRequestWithAttributes(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type,
+                                            int preferredZone, int preferredArea,
+                                            uint8_t requiredAttributes, uint8_t preferredAttributes,
+                                            int& fee, bool& crossZoneUsed) {
+        if (preferredArea < 0 || preferredArea > Areas) {
+            fee = 0;
+            crossZoneUsed = false;
+            return false;
+        }
+        return create(vehicleNumber, type, preferredZone, preferredArea,
+                      requiredAttributes, preferredAttributes, fee, crossZoneUsed);
+    }
+
+    bool occupyParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override {
+        int32_t record = findRecord(vehicleNumber, type);
+        return record != EMPTY && records[record]->occupy(clock->nowNanos());
+    }
+
+    bool releaseParking(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override {
+        int32_t record = findRecord(vehicleNumber, type);
+        if (record == EMPTY)
+            return false;
+        ParkingRequest& request = *records[record];
+        if (!request.release(slotOf(request), clock->nowNanos()))
+            return false;
+        if (tariff)
+            request.setCharge(tariff->price(request.getAllocatedZoneId(), request.getVehicleType(),
+                                            request.isCrossZone(), request.getOccupyTimeNanos(),
+                                            request.getReleaseTimeNanos()));
+        retire(record);
+        return true;
+    }
+
+    bool cancelRequest(const VehiclePlate& vehicleNumber, Vehicle::VehicleType type) override {
+        int32_t record = findRecord(vehicleNumber, type);
+        if (record == EMPTY || !records[record]->cancel(slotOf(*records[record])))
+            return false;
+        retire(record);
+        return true;
+    }
+
+    const ParkingRequest* lookupRequest(const VehiclePlate& vehicleNumber,
+                                        Vehicle::VehicleType type) const override {
+        int32_t record = findRecord(vehicleNumber, type);
+        return record == EMPTY ? nullptr : &*records[record];
+    }
+
+    int getFreeSlots() const override { return freeSlots; }
+
+    // -------- Slot Attributes --------
+    // As ParkingSystem::setSlotAttributes: slots fromSlot..toSlot of one
+    // area (toSlot 0 = the last), returns how many changed or -1
+    int setSlotAttributes(int zoneId, int areaId, int fromSlot, int toSlot, uint8_t attributes) {
+        if (zoneId < 1 || zoneId > Zones || areaId < 1 || areaId > Areas)
+            return -1;
+        if (fromSlot < 1) fromSlot = 1;
+        if (toSlot <= 0 || toSlot > Slots) toSlot = Slots;
+
+        attributes &= ParkingSlot::ALL_ATTRIBUTES;
+        int changed = 0;
+        for (int s = fromSlot; s <= toSlot; s++) {
+            ParkingSlot& slot = slots[slotIdOf(zoneId, areaId, s) - 1];
+            if (slot.getAttributes() != attributes) {
+                slot.setAttributes(attributes);
+                changed++;
+            }
+        }
+        return changed;
+    }
+
+    // -------- Queries --------
+    int getZoneFree(int zoneId) const {
+        return zoneId >= 1 && zoneId <= Zones ? zoneFree[zoneId - 1] : 0;
+    }
+    int getAreaFree(int zoneId, int areaId) const {
+        if (zoneId < 1 || zoneId > Zones || areaId < 1 || areaId > Areas)
+            return 0;
+        return areaFree[(zoneId - 1) * Areas + (areaId - 1)];
+    }
+    const ParkingSlot& getSlot(int slotId) const { return slots[slotId - 1]; }
+
+    // -------- SlotListener --------
+    void onSlotChanged(const ParkingSlot& slot, bool available) override {
+        int delta = available ? 1 : -1;
+        areaFree[(slot.getZoneId() - 1) * Areas + (slot.getAreaId() - 1)] += delta;
+        zoneFree[slot.getZoneId() - 1] += delta;
+        freeSlots += delta;
+    }
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ParkingSystem.h"
+#include "StaticCity.h"
+#include "ConsoleMute.h"
+
+// StaticCity against ParkingSystem on one gate workload.
+//
+//   StaticCityBenchmark [--ops N] [--seed S]
+//
+// The same script of PARK / OCCUPY / RELEASE / CANCEL calls is driven
+// through ParkingOperations into both implementations of a 15 x 3 x 20
+// lot, using a VirtualClock each. Every answer (success, slot, fee,
+// cross-zone, charge) must match; then both are timed on the script.
+
+typedef std::chrono::steady_clock WallClock;
+typedef StaticCity<15, 3, 20> GateCity;
+
+struct GateOp {
+    enum Type { PARK, OCCUPY, RELEASE, CANCEL };
+
+    Type type;
+    int vehicle;              // index into the plate table
+    Vehicle::VehicleType vehicleType;
+    int zoneId;
+    int areaId;               // 0 = any
+};
+
+struct GateAnswer {
+    bool ok;
+    int slotId;
+    int fee;
+    bool crossZone;
+    int64_t charge;
+
+    bool operator==(const GateAnswer& other) const {
+        return ok == other.ok && slotId == other.slotId && fee == other.fee &&
+               crossZone == other.crossZone && charge == other.charge;
+    }
+};
+
+// Vehicles arrive, mostly occupy, and leave; ParkingSystem never lets a
+// plate park twice, so every arrival gets a new plate
+static void makeScript(int ops, uint32_t seed, int zones, int areas,
+                       std::vector<GateOp>& script, std::vector<VehiclePlate>& plates) {
+    std::mt19937 random(seed);
+    std::vector<int> allocated, occupied;
+    int vehicles = 0;
+
+    while (static_cast<int>(script.size()) < ops) {
+        uint32_t roll = random() % 100;
+        GateOp op;
+        op.zoneId = op.areaId = 0;
+        op.vehicleType = Vehicle::CAR;
+
+        if (roll < 34 || (allocated.empty() && occupied.empty())) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "G%07d", vehicles);
+            plates.push_back(VehiclePlate(text));
+            op.type = GateOp::PARK;
+            op.vehicle = vehicles++;
+            op.vehicleType = random() % 4 == 0 ? Vehicle::BIKE : Vehicle::CAR;
+            op.zoneId = static_cast<int>(random() % (zones + 1)) + 1;   // sometimes out of range
+            op.areaId = random() % 2 == 0 ? 0 : static_cast<int>(random() % areas) + 1;
+            allocated.push_back(op.vehicle);
+        } else if (roll < 67 && !allocated.empty()) {
+            size_t at = random() % allocated.size();
+            op.type = random() % 10 == 0 ? GateOp::CANCEL : GateOp::OCCUPY;
+            op.vehicle = allocated[at];
+            allocated[at] = allocated.back();
+            allocated.pop_back();
+            if (op.type == GateOp::OCCUPY)
+                occupied.push_back(op.vehicle);
+        } else if (!occupied.empty()) {
+            size_t at = random() % occupied.size();
+            op.type = GateOp::RELEASE;
+            op.vehicle = occupied[at];
+            occupied[at] = occupied.back();
+            occupied.pop_back();
+        } else {
+            continue;
+        }
+        script.push_back(op);
+    }
+}
+
+// Vehicle types are fixed at PARK; later ops look them up from there
+static Vehicle::VehicleType typeOf(std::vector<Vehicle::VehicleType>& types, const GateOp& op) {
+    if (op.type == GateOp::PARK)
+        types[op.vehicle] = op.vehicleType;
+    return types[op.vehicle];
+}
+
+static GateAnswer apply(ParkingOperations& city, const GateOp& op, const VehiclePlate& plate,
+                        Vehicle::VehicleType type) {
+    GateAnswer answer = { false, -1, 0, false, 0 };
+    switch (op.type) {
+        case GateOp::PARK:
+            answer.ok = op.areaId == 0
+                ? city.createParkingRequest(plate, type, op.zoneId, answer.fee, answer.crossZone)
+                : city.createParkingRequestWithArea(plate, type, op.zoneId, op.areaId, answer.fee, answer.crossZone);
+            break;
+        case GateOp::OCCUPY:  answer.ok = city.occupyParking(plate, type); break;
+        case GateOp::RELEASE: answer.ok = city.releaseParking(plate, type); break;
+        case GateOp::CANCEL:  answer.ok = city.cancelRequest(plate, type); break;
+    }
+    if (answer.ok) {
+        const ParkingRequest* request = city.lookupRequest(plate, type);
+        answer.slotId = request ? request->getAllocatedSlotId() : -1;
+        answer.charge = request ? request->getCharge() : 0;
+    }
+    return answer;
+}
+
+// Runs the script; with check, compares against answers, else fills them
+static double run(ParkingOperations& city, VirtualClock& clock, const std::vector<GateOp>& script,
+                  const std::vector<VehiclePlate>& plates, std::vector<GateAnswer>& answers, bool check,
+                  int& mismatches) {
+    std::vector<Vehicle::VehicleType> types(plates.size(), Vehicle::CAR);
+    if (!check)
+        answers.resize(script.size());
+
+    ConsoleMute mute;
+    WallClock::time_point start = WallClock::now();
+    for (size_t i = 0; i < script.size(); i++) {
+        clock.advanceSeconds(37);
+        const GateOp& op = script[i];
+        GateAnswer answer = apply(city, op, plates[op.vehicle], typeOf(types, op));
+        if (!check)
+            answers[i] = answer;
+        else if (!(answer == answers[i]))
+            mismatches++;
+    }
+    return std::chrono::duration<double, std::milli>(WallClock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int ops = 200000;
+    uint32_t seed = 7;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--ops") == 0) ops = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0) seed = static_cast<uint32_t>(atoi(argv[i + 1]));
+        else {
+            std::printf("Usage: StaticCityBenchmark [--ops N] [--seed S]\n");
+            return 1;
+        }
+    }
+    if (ops <= 0) {
+        std::printf("❌ --ops must be positive\n");
+        return 1;
+    }
+
+    std::vector<GateOp> script;
+    std::vector<VehiclePlate> plates;
+    makeScript(ops, seed, GateCity::ZONE_COUNT, GateCity::AREAS_PER_ZONE, script, plates);
+
+    std::vector<GateAnswer> answers;
+    int mismatches = 0;
+
+    VirtualClock systemClock;
+    ParkingSystem* system = new ParkingSystem(CityLayout(GateCity::ZONE_COUNT, GateCity::AREAS_PER_ZONE,
+                                                         GateCity::SLOTS_PER_AREA), &systemClock);
+    double systemMillis = run(*system, systemClock, script, plates, answers, false, mismatches);
+
+    // The tariff is built once up front, as a controller would at boot
+    TariffEngine tariff;
+    VirtualClock staticClock;
+    static GateCity city(&staticClock, &tariff);
+    double staticMillis = run(city, staticClock, script, plates, answers, true, mismatches);
+
+    int parks = 0, parked = 0;
+    for (size_t i = 0; i < script.size(); i++)
+        if (script[i].type == GateOp::PARK) {
+            parks++;
+            if (answers[i].ok) parked++;
+        }
+
+    std::printf("🚦 %d ops (%d parks, %d parked) on %d slots\n", ops, parks, parked, GateCity::TOTAL_SLOTS);
+    std::printf("   ParkingSystem  %8.1f ms  %6.0f ns/op\n", systemMillis, systemMillis * 1e6 / ops);
+    std::printf("   StaticCity     %8.1f ms  %6.0f ns/op  (%zu bytes, no heap)\n",
+                staticMillis, staticMillis * 1e6 / ops, sizeof(GateCity));
+    std::printf("   Free at end: %d vs %d\n", system->getFreeSlots(), city.getFreeSlots());
+
+    bool ok = mismatches == 0 && system->getFreeSlots() == city.getFreeSlots();
+    delete system;
+    if (!ok) {
+        std::printf("❌ %d answers differ\n", mismatches);
+        return 1;
+    }
+    std::printf("✅ Every answer matches\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ConsoleMute.h"
+#include "ParkingSystem.h"
+#include "StaticCity.h"
+
+// StaticCity against ParkingSystem on the same layout.
+//
+//   StaticCityTest
+//
+// Both allocate through AllocationLadder, so a scripted mix of parks (any
+// area, one area, with attributes, bad zones), occupies, releases,
+// cancels and attribute changes must give the same answers, fees and
+// slots on both. RESERVED slots go only to requests that require them.
+// Exits non-zero if any expectation fails.
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("❌ %s\n", what);
+        failures++;
+    }
+}
+
+typedef StaticCity<2, 2, 3> City;
+
+static int slotOf(const ParkingOperations& ops, const char* plate) {
+    const ParkingRequest* request = ops.lookupRequest(VehiclePlate(plate), Vehicle::CAR);
+    return request && request->hasAllocatedSlot() ? request->getAllocatedSlotId() : 0;
+}
+
+// -------- Reserved slots --------
+static void reservedSlots(VirtualClock& clock) {
+    StaticCity<1, 1, 3>* city = new StaticCity<1, 1, 3>(&clock);
+    check(city->setSlotAttributes(1, 1, 1, 2, ParkingSlot::RESERVED) == 2, "reserve slots 1-2");
+    check(city->setSlotAttributes(1, 1, 1, 2, ParkingSlot::RESERVED) == 0, "unchanged attributes are not counted");
+    check(city->setSlotAttributes(2, 1, 1, 0, 0) == -1, "unknown zone is refused");
+
+    int fee = 0;
+    bool crossZone = false;
+    check(city->createParkingRequest(VehiclePlate("R1"), Vehicle::CAR, 1, fee, crossZone),
+          "plain request parks");
+    check(slotOf(*city, "R1") == 3, "plain request skips the reserved slots");
+    check(!city->createParkingRequest(VehiclePlate("R2"), Vehicle::CAR, 1, fee, crossZone),
+          "plain request is refused while only reserved slots are free");
+    check(city->getFreeSlots() == 2, "refused request takes no slot");
+    check(city->createParkingRequestWithAttributes(VehiclePlate("R3"), Vehicle::CAR, 1, 0,
+                                                   ParkingSlot::RESERVED, 0, fee, crossZone),
+          "permit holder parks");
+    check(slotOf(*city, "R3") == 1, "permit holder takes a reserved slot");
+    delete city;
+}
+
+// -------- Scripted parity --------
+static uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+static void scriptedParity(VirtualClock& clock) {
+    ParkingSystem system(CityLayout(City::ZONE_COUNT, City::AREAS_PER_ZONE, City::SLOTS_PER_AREA), &clock);
+    City* city = new City(&clock);
+    std::vector<std::string> plates;
+    uint32_t state = 12345;
+    char what[128];
+
+    for (int step = 0; step < 4000; step++) {
+        clock.advanceSeconds(60);
+        uint32_t op = nextRandom(state) % 10;
+        int zone = static_cast<int>(nextRandom(state) % (City::ZONE_COUNT + 2));   // 0 and Z+1 are bad zones
+        int area = static_cast<int>(nextRandom(state) % (City::AREAS_PER_ZONE + 1));
+        uint8_t required = static_cast<uint8_t>(nextRandom(state) % 8 == 0 ? nextRandom(state) % 8 : 0);
+        uint8_t preferred = static_cast<uint8_t>(nextRandom(state) % 4 == 0 ? nextRandom(state) % 8 : 0);
+
+        bool systemOk = false, cityOk = false;
+        int systemFee = 0, cityFee = 0;
+        bool systemCross = false, cityCross = false;
+        const char* plate = nullptr;
+
+        if (op < 5) {
+            plates.push_back("S" + std::to_string(step));
+            plate = plates.back().c_str();
+            VehiclePlate vehicle(plate);
+            systemOk = system.createParkingRequestWithAttributes(vehicle, Vehicle::CAR, zone, area, required,
+                                                                 preferred, systemFee, systemCross);
+            cityOk = city->createParkingRequestWithAttributes(vehicle, Vehicle::CAR, zone, area, required,
+                                                              preferred, cityFee, cityCross);
+        } else if (op < 9 && !plates.empty()) {
+            plate = plates[nextRandom(state) % plates.size()].c_str();
+            VehiclePlate vehicle(plate);
+            if (op < 7) {
+                systemOk = system.occupyParking(vehicle, Vehicle::CAR);
+                cityOk = city->occupyParking(vehicle, Vehicle::CAR);
+            } else if (op == 7) {
+                systemOk = system.releaseParking(vehicle, Vehicle::CAR);
+                cityOk = city->releaseParking(vehicle, Vehicle::CAR);
+            } else {
+                systemOk = system.cancelRequest(vehicle, Vehicle::CAR);
+                cityOk = city->cancelRequest(vehicle, Vehicle::CAR);
+            }
+        } else {
+            int from = static_cast<int>(nextRandom(state) % City::SLOTS_PER_AREA) + 1;
+            uint8_t attributes = static_cast<uint8_t>(nextRandom(state) % 8);
+            int z = zone < 1 || zone > City::ZONE_COUNT ? 1 : zone;
+            int a = area == 0 ? 1 : area;
+            systemOk = system.setSlotAttributes(z, a, from, from, attributes) >= 0;
+            cityOk = city->setSlotAttributes(z, a, from, from, attributes) >= 0;
+        }
+
+        std::snprintf(what, sizeof(what), "step %d (op %u, plate %s): same answer", step, op, plate ? plate : "-");
+        check(systemOk == cityOk, what);
+        if (op < 5 && systemOk && cityOk) {
+            std::snprintf(what, sizeof(what), "step %d (%s): same quote", step, plate);
+            check(systemFee == cityFee && systemCross == cityCross, what);
+            std::snprintf(what, sizeof(what), "step %d (%s): same slot", step, plate);
+            check(slotOf(system, plate) == slotOf(*city, plate), what);
+            if (!(required & ParkingSlot::RESERVED)) {
+                std::snprintf(what, sizeof(what), "step %d (%s): no reserved slot", step, plate);
+                check(!(city->getSlot(slotOf(*city, plate)).getAttributes() & ParkingSlot::RESERVED), what);
+            }
+        }
+        std::snprintf(what, sizeof(what), "step %d: same free count", step);
+        check(system.getFreeSlots() == city->getFreeSlots(), what);
+        if (failures > 10)
+            break;
+    }
+    delete city;
+}
+
+int main() {
+    ConsoleMute mute;
+    VirtualClock clock;
+
+    reservedSlots(clock);
+    scriptedParity(clock);
+
+    if (failures != 0) {
+        std::printf("❌ %d StaticCity check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("✅ StaticCity allocates like ParkingSystem\n");
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "StatusChangeLog.h"
+#include "ParkingSlot.h"
+#include <algorithm>
+
+StatusChangeLog::StatusChangeLog(int capacity) : version(0) {
+    Entry empty = { 0, nullptr };
+    ring.assign(capacity > 0 ? capacity : 1, empty);
+}
+
+void StatusChangeLog::record(const ParkingSlot* slot) {
+    version++;
+    Entry& entry = ring[version % ring.size()];
+    entry.version = version;
+    entry.slot = slot;
+}
+
+uint64_t StatusChangeLog::getVersion() const {
+    return version;
+}
+
+bool StatusChangeLog::changedSince(uint64_t sinceVersion, std::vector<const ParkingSlot*>& slots) const {
+    slots.clear();
+    if (sinceVersion > version)
+        return false;
+
+    uint64_t pending = version - sinceVersion;
+    if (pending > ring.size())
+        return false;
+
+    for (uint64_t v = sinceVersion + 1; v <= version; v++) {
+        const Entry& entry = ring[v % ring.size()];
+        if (entry.version != v)
+            return false;   // cleared by reset()
+        slots.push_back(entry.slot);
+    }
+
+    // A slot that flipped several times is reported once, at its current state
+    std::sort(slots.begin(), slots.end(), [](const ParkingSlot* a, const ParkingSlot* b) {
+        return a->getSlotId() < b->getSlotId();
+    });
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return true;
+}
+
+void StatusChangeLog::reset() {
+    for (auto& entry : ring) {
+        entry.version = 0;
+        entry.slot = nullptr;
+    }
+}
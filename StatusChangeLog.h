@@ -0,0 +1,44 @@
+#ifndef STATUS_CHANGE_LOG_H
+#define STATUS_CHANGE_LOG_H
+
+#include <cstdint>
+#include <vector>
+
+class ParkingSlot;
+
+// Versioned log of slot transitions, used to answer "what changed since
+// version v" for STATUS subscribers.
+//
+// Every transition bumps the version and appends one entry to a fixed
+// ring. A delta walks only the entries newer than the caller's version,
+// so it costs O(changes), not O(slots). A caller that has fallen further
+// behind than the ring holds is told to resync from a full snapshot.
+class StatusChangeLog {
+public:
+    static const int DEFAULT_CAPACITY = 1 << 16;
+
+private:
+    struct Entry {
+        uint64_t version;
+        const ParkingSlot* slot;
+    };
+
+    std::vector<Entry> ring;
+    uint64_t version;
+
+public:
+    explicit StatusChangeLog(int capacity = DEFAULT_CAPACITY);
+
+    void record(const ParkingSlot* slot);
+    uint64_t getVersion() const;
+
+    // Slots that changed in (sinceVersion, current], each once, ordered
+    // by slot id. Returns false when sinceVersion is no longer covered.
+    bool changedSince(uint64_t sinceVersion, std::vector<const ParkingSlot*>& slots) const;
+
+    // Forgets all entries (e.g. after slots are destroyed); every
+    // subscriber older than the current version will resync.
+    void reset();
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "StatusReader.h"
+
+// Sample reader for the shared-memory status region.
+//
+//   StatusMonitor [--name SEGMENT] [--interval MS] [--count N] [--zones]
+//
+// Attaches read-only to a running ServerMain --shm (or any other
+// publisher) and prints city occupancy every interval, only when the
+// change version moved. --zones adds one line per zone; --count stops
+// after N prints (default: run until interrupted). When the publisher
+// replaces the segment (a zone was added) or exits, the monitor waits
+// for the segment to reappear and re-attaches.
+
+using namespace std;
+
+static void usage() {
+    cout << "Usage: StatusMonitor [--name SEGMENT] [--interval MS] [--count N] [--zones]\n";
+}
+
+static void describe(const StatusReader& reader, const char* segment) {
+    cout << "Attached to " << segment << " (publisher pid " << reader.getPublisherPid() << ", "
+         << reader.getZoneCount() << " zones x " << reader.getAreasPerZone() << " areas x "
+         << reader.getSlotsPerArea() << " slots)\n";
+}
+
+int main(int argc, char** argv) {
+    const char* segment = StatusPublisher::DEFAULT_NAME;
+    int intervalMs = 500;
+    long long count = -1;
+    bool showZones = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--zones") == 0) {
+            showZones = true;
+            continue;
+        }
+        if (strcmp(arg, "--help") == 0 || value == nullptr) {
+            usage();
+            return strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+
+        if (strcmp(arg, "--name") == 0)          segment = value;
+        else if (strcmp(arg, "--interval") == 0) intervalMs = atoi(value);
+        else if (strcmp(arg, "--count") == 0)    count = atoll(value);
+        else {
+            usage();
+            return 1;
+        }
+        i++;
+    }
+
+    StatusReader reader;
+    if (!reader.attach(segment)) {
+        cout << "❌ No status region " << segment << " (start ServerMain --shm)\n";
+        return 1;
+    }
+    describe(reader, segment);
+
+    StatusSnapshot snapshot;
+    uint64_t lastVersion = ~0ULL;
+    long long printed = 0;
+
+    while (count < 0 || printed < count) {
+        if (reader.isStale()) {
+            cout << "🔄 " << segment << " was retired, waiting for the publisher\n";
+            cout.flush();
+            while (!reader.attach(segment))
+                this_thread::sleep_for(chrono::milliseconds(intervalMs));
+            describe(reader, segment);
+            lastVersion = ~0ULL;
+        }
+
+        if (!reader.snapshot(snapshot)) {
+            if (!reader.isPublisherAlive()) {
+                cout << "❌ Publisher " << reader.getPublisherPid() << " died mid-update\n";
+                return 1;
+            }
+        } else if (snapshot.changeVersion != lastVersion) {
+            lastVersion = snapshot.changeVersion;
+            printed++;
+
+            int total = snapshot.city.free + snapshot.city.occupied;
+            cout << "v" << snapshot.changeVersion << "  free " << snapshot.city.free << "/" << total
+                 << "  occupied " << fixed << setprecision(1)
+                 << (total ? 100.0 * snapshot.city.occupied / total : 0.0) << "%\n";
+            if (showZones) {
+                for (int z = 1; z <= snapshot.zoneCount; z++) {
+                    const StatusCounter& zone = snapshot.getZone(z);
+                    cout << "  Zone-" << z << "  free " << zone.free << "  occupied " << zone.occupied << "\n";
+                }
+            }
+            cout.flush();
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(intervalMs));
+    }
+    return 0;
+}
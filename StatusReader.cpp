@@ -0,0 +1,179 @@
+#include "StatusReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+// -------- Snapshot --------
+StatusSnapshot::StatusSnapshot()
+    : changeVersion(0), updatedNanos(0), zoneCount(0), areasPerZone(0), slotsPerArea(0) {
+    city.free = 0;
+    city.occupied = 0;
+}
+
+const StatusCounter& StatusSnapshot::getZone(int zoneId) const {
+    return zones[zoneId - 1];
+}
+
+const StatusCounter& StatusSnapshot::getArea(int zoneId, int areaId) const {
+    return areas[(zoneId - 1) * areasPerZone + (areaId - 1)];
+}
+
+bool StatusSnapshot::isSlotFree(int slotId) const {
+    int index = slotId - 1;
+    return (bitmap[index / 64] >> (index % 64)) & 1;
+}
+
+// -------- Attach --------
+StatusReader::StatusReader() : base(nullptr), bytes(0), header(nullptr) {}
+
+StatusReader::~StatusReader() {
+    detach();
+}
+
+bool StatusReader::attach(const char* segmentName) {
+    detach();
+
+    int fd = shm_open(segmentName, O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StatusRegionHeader)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    const StatusRegionHeader* candidate = static_cast<const StatusRegionHeader*>(mapped);
+    uint32_t magic = reinterpret_cast<const std::atomic<uint32_t>*>(&candidate->magic)->load(std::memory_order_acquire);
+    if (magic != StatusRegionHeader::MAGIC ||
+        candidate->formatVersion != StatusRegionHeader::FORMAT_VERSION ||
+        candidate->regionBytes > size) {
+        munmap(mapped, size);
+        return false;
+    }
+
+    base = static_cast<const unsigned char*>(mapped);
+    bytes = size;
+    header = candidate;
+    return true;
+}
+
+void StatusReader::detach() {
+    if (!base)
+        return;
+    munmap(const_cast<unsigned char*>(base), bytes);
+    base = nullptr;
+    header = nullptr;
+    bytes = 0;
+}
+
+bool StatusReader::isAttached() const {
+    return base != nullptr;
+}
+
+bool StatusReader::isStale() const {
+    uint32_t magic = reinterpret_cast<const std::atomic<uint32_t>*>(&header->magic)->load(std::memory_order_acquire);
+    return magic != StatusRegionHeader::MAGIC;
+}
+
+int StatusReader::getZoneCount() const {
+    return header->zoneCount;
+}
+
+int StatusReader::getAreasPerZone() const {
+    return header->areasPerZone;
+}
+
+int StatusReader::getSlotsPerArea() const {
+    return header->slotsPerArea;
+}
+
+int StatusReader::getPublisherPid() const {
+    return header->publisherPid;
+}
+
+// EPERM still means the process exists, just under another user
+bool StatusReader::isPublisherAlive() const {
+    return kill(static_cast<pid_t>(header->publisherPid), 0) == 0 || errno == EPERM;
+}
+
+// -------- Seqlock Reads --------
+template <typename Copy>
+bool StatusReader::readConsistent(Copy copy) const {
+    for (int attempt = 1; attempt <= MAX_READ_ATTEMPTS; attempt++) {
+        uint64_t before = header->sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            copy();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header->sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+        // The writer is inside an update, which can span a whole batch;
+        // let it run, and stop waiting on one that has died holding it
+        std::this_thread::yield();
+        if (attempt % 1024 == 0 && !isPublisherAlive())
+            return false;
+    }
+    return false;
+}
+
+bool StatusReader::getChangeVersion(uint64_t& out) const {
+    out = 0;
+    return readConsistent([&]() { out = header->changeVersion; });
+}
+
+bool StatusReader::getCity(StatusCounter& out) const {
+    out.free = out.occupied = 0;
+    return readConsistent([&]() { out = header->city; });
+}
+
+bool StatusReader::getZone(int zoneId, StatusCounter& out) const {
+    out.free = out.occupied = 0;
+    if (zoneId < 1 || zoneId > header->zoneCount)
+        return false;
+
+    const StatusCounter* zones = reinterpret_cast<const StatusCounter*>(base + header->zoneOffset);
+    return readConsistent([&]() { out = zones[zoneId - 1]; });
+}
+
+bool StatusReader::getArea(int zoneId, int areaId, StatusCounter& out) const {
+    out.free = out.occupied = 0;
+    if (zoneId < 1 || zoneId > header->zoneCount || areaId < 1 || areaId > header->areasPerZone)
+        return false;
+
+    const StatusCounter* areas = reinterpret_cast<const StatusCounter*>(base + header->areaOffset);
+    return readConsistent([&]() { out = areas[(zoneId - 1) * header->areasPerZone + (areaId - 1)]; });
+}
+
+bool StatusReader::snapshot(StatusSnapshot& out) const {
+    int zoneCount = header->zoneCount;
+    int areaCount = zoneCount * header->areasPerZone;
+    int words = (header->totalSlots + 63) / 64;
+
+    out.zoneCount = zoneCount;
+    out.areasPerZone = header->areasPerZone;
+    out.slotsPerArea = header->slotsPerArea;
+    out.zones.resize(zoneCount);
+    out.areas.resize(areaCount);
+    out.bitmap.resize(words);
+
+    return readConsistent([&]() {
+        out.changeVersion = header->changeVersion;
+        out.updatedNanos = header->updatedNanos;
+        out.city = header->city;
+        std::memcpy(out.zones.data(), base + header->zoneOffset, zoneCount * sizeof(StatusCounter));
+        std::memcpy(out.areas.data(), base + header->areaOffset, areaCount * sizeof(StatusCounter));
+        std::memcpy(out.bitmap.data(), base + header->bitmapOffset, words * sizeof(uint64_t));
+    });
+}
@@ -0,0 +1,83 @@
+#ifndef STATUS_READER_H
+#define STATUS_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "StatusRegion.h"
+
+// One consistent copy of the shared status region
+struct StatusSnapshot {
+    uint64_t changeVersion;
+    int64_t updatedNanos;
+    int zoneCount;
+    int areasPerZone;
+    int slotsPerArea;
+    StatusCounter city;
+    std::vector<StatusCounter> zones;   // zoneCount entries
+    std::vector<StatusCounter> areas;   // zoneCount * areasPerZone entries
+    std::vector<uint64_t> bitmap;       // bit i set = slot id i+1 free
+
+    StatusSnapshot();
+
+    const StatusCounter& getZone(int zoneId) const;
+    const StatusCounter& getArea(int zoneId, int areaId) const;
+    bool isSlotFree(int slotId) const;
+};
+
+// Read-only view of a StatusPublisher segment for dashboard processes.
+// After attach() every call is plain memory reads (no syscalls, no
+// locks); a read that overlaps an update is retried, yielding while the
+// writer is inside one. Updates can be long (a whole ingest batch) and a
+// publisher that dies mid-update leaves the sequence odd for good, so a
+// read gives up after MAX_READ_ATTEMPTS, or as soon as the publisher
+// process is gone, and returns false.
+class StatusReader {
+public:
+    static const int MAX_READ_ATTEMPTS = 1 << 16;
+
+private:
+    const unsigned char* base;
+    size_t bytes;
+    const StatusRegionHeader* header;
+
+    StatusReader(const StatusReader&);
+    StatusReader& operator=(const StatusReader&);
+
+    template <typename Copy>
+    bool readConsistent(Copy copy) const;
+
+public:
+    StatusReader();
+    ~StatusReader();
+
+    // Maps the segment read-only; false if it does not exist or is not a
+    // status region of this format
+    bool attach(const char* segmentName = StatusPublisher::DEFAULT_NAME);
+    void detach();
+    bool isAttached() const;
+
+    // True once the publisher closed or replaced the segment (e.g. after
+    // adding a zone); the data stays readable but frozen, so detach and
+    // attach() again by name
+    bool isStale() const;
+
+    int getZoneCount() const;
+    int getAreasPerZone() const;
+    int getSlotsPerArea() const;
+    int getPublisherPid() const;
+    bool isPublisherAlive() const;      // one kill(pid, 0) syscall
+
+    // Cheap polls: one seqlock-protected read each. False (and {0, 0} or
+    // 0 in `out`) if out of range or no consistent copy could be taken
+    bool getChangeVersion(uint64_t& out) const;
+    bool getCity(StatusCounter& out) const;
+    bool getZone(int zoneId, StatusCounter& out) const;
+    bool getArea(int zoneId, int areaId, StatusCounter& out) const;
+
+    // Full copy; `out`'s vectors are reused, so repeated snapshots do not
+    // allocate. False if no consistent copy could be taken
+    bool snapshot(StatusSnapshot& out) const;
+};
+
+#endif
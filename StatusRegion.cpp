@@ -0,0 +1,153 @@
+#include "StatusRegion.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+const char* const StatusPublisher::DEFAULT_NAME = "/parking-status";
+
+static size_t alignUp(size_t value) {
+    return (value + 63) & ~static_cast<size_t>(63);
+}
+
+StatusPublisher::StatusPublisher()
+    : base(nullptr), bytes(0), header(nullptr), zones(nullptr), areas(nullptr), bitmap(nullptr) {
+    name[0] = '\0';
+}
+
+StatusPublisher::~StatusPublisher() {
+    close();
+}
+
+bool StatusPublisher::isOpen() const {
+    return base != nullptr;
+}
+
+const char* StatusPublisher::getName() const {
+    return name;
+}
+
+// -------- Segment --------
+bool StatusPublisher::open(const char* segmentName, int zoneCount, int areasPerZone, int slotsPerArea) {
+    close();
+    if (std::strlen(segmentName) >= sizeof(name) || zoneCount <= 0 || areasPerZone <= 0 || slotsPerArea <= 0)
+        return false;
+
+    int areaCount = zoneCount * areasPerZone;
+    int totalSlots = areaCount * slotsPerArea;
+    size_t zoneOffset = alignUp(sizeof(StatusRegionHeader));
+    size_t areaOffset = alignUp(zoneOffset + zoneCount * sizeof(StatusCounter));
+    size_t bitmapOffset = alignUp(areaOffset + areaCount * sizeof(StatusCounter));
+    size_t regionBytes = bitmapOffset + ((totalSlots + 63) / 64) * sizeof(uint64_t);
+
+    // A fresh segment, so readers of a previous run never see a resize
+    shm_unlink(segmentName);
+    int fd = shm_open(segmentName, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, static_cast<off_t>(regionBytes)) != 0) {
+        ::close(fd);
+        shm_unlink(segmentName);
+        return false;
+    }
+    void* mapped = mmap(nullptr, regionBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        shm_unlink(segmentName);
+        return false;
+    }
+
+    std::strcpy(name, segmentName);
+    base = static_cast<unsigned char*>(mapped);
+    bytes = regionBytes;
+
+    // ftruncate zero-fills; only the non-zero fields are written
+    header = new (base) StatusRegionHeader;
+    header->sequence.store(0, std::memory_order_relaxed);
+    header->formatVersion = StatusRegionHeader::FORMAT_VERSION;
+    header->regionBytes = regionBytes;
+    header->zoneCount = zoneCount;
+    header->areasPerZone = areasPerZone;
+    header->slotsPerArea = slotsPerArea;
+    header->totalSlots = totalSlots;
+    header->zoneOffset = static_cast<uint32_t>(zoneOffset);
+    header->areaOffset = static_cast<uint32_t>(areaOffset);
+    header->bitmapOffset = static_cast<uint32_t>(bitmapOffset);
+    header->publisherPid = static_cast<int32_t>(getpid());
+    header->changeVersion = 0;
+    header->updatedNanos = 0;
+    header->city.free = totalSlots;
+    header->city.occupied = 0;
+
+    zones = reinterpret_cast<StatusCounter*>(base + zoneOffset);
+    areas = reinterpret_cast<StatusCounter*>(base + areaOffset);
+    bitmap = reinterpret_cast<uint64_t*>(base + bitmapOffset);
+
+    for (int z = 0; z < zoneCount; z++)
+        zones[z].free = areasPerZone * slotsPerArea;
+    for (int a = 0; a < areaCount; a++)
+        areas[a].free = slotsPerArea;
+    for (int s = 0; s < totalSlots; s++)
+        bitmap[s / 64] |= 1ULL << (s % 64);
+
+    // Readers check the magic last, so they never attach to a half-built header
+    std::atomic_thread_fence(std::memory_order_release);
+    reinterpret_cast<std::atomic<uint32_t>*>(&header->magic)->store(StatusRegionHeader::MAGIC,
+                                                                      std::memory_order_release);
+    return true;
+}
+
+void StatusPublisher::close() {
+    if (!base)
+        return;
+    // Readers keep their mapping after the unlink; tell them it is dead
+    reinterpret_cast<std::atomic<uint32_t>*>(&header->magic)->store(StatusRegionHeader::RETIRED,
+                                                                      std::memory_order_release);
+    munmap(base, bytes);
+    shm_unlink(name);
+    base = nullptr;
+    header = nullptr;
+    zones = areas = nullptr;
+    bitmap = nullptr;
+    bytes = 0;
+    name[0] = '\0';
+}
+
+// -------- Seqlock Updates --------
+void StatusPublisher::beginUpdate() {
+    uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void StatusPublisher::setSlot(int slotId, int zoneId, int areaId, bool available) {
+    int index = slotId - 1;
+    if (index < 0 || index >= header->totalSlots ||
+        zoneId < 1 || zoneId > header->zoneCount || areaId < 1 || areaId > header->areasPerZone)
+        return;
+
+    uint64_t mask = 1ULL << (index % 64);
+    bool wasFree = (bitmap[index / 64] & mask) != 0;
+    if (wasFree == available)
+        return;
+
+    int delta = available ? 1 : -1;
+    StatusCounter& zone = zones[zoneId - 1];
+    StatusCounter& area = areas[(zoneId - 1) * header->areasPerZone + (areaId - 1)];
+    zone.free += delta;
+    zone.occupied -= delta;
+    area.free += delta;
+    area.occupied -= delta;
+    header->city.free += delta;
+    header->city.occupied -= delta;
+    bitmap[index / 64] ^= mask;
+}
+
+void StatusPublisher::endUpdate(uint64_t changeVersion, int64_t nowNanos) {
+    header->changeVersion = changeVersion;
+    header->updatedNanos = nowNanos;
+    uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_release);
+}
@@ -0,0 +1,98 @@
+#ifndef STATUS_REGION_H
+#define STATUS_REGION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Shared-memory status region for out-of-process dashboards.
+//
+// ParkingSystem publishes zone and area counters and a slot-availability
+// bitmap into a POSIX shared-memory segment ("/parking-status" by
+// default). Readers map it read-only and poll it with plain loads: no
+// syscalls, no locks, and they can never slow the command loop down.
+//
+// Consistency comes from a seqlock. The single writer makes `sequence`
+// odd, updates the data and makes it even again; a reader copies what it
+// needs and retries if the sequence was odd or moved meanwhile.
+//
+// The segment has a fixed size, so a topology change replaces it. Before
+// unlinking a segment the writer overwrites its magic with RETIRED;
+// readers still mapping the old one see that and re-attach by name.
+//
+// Segment layout (every offset is from the start of the segment):
+//   StatusRegionHeader
+//   StatusCounter zones[zoneCount]                     at zoneOffset
+//   StatusCounter areas[zoneCount * areasPerZone]      at areaOffset
+//   uint64_t bitmap[(totalSlots + 63) / 64]            at bitmapOffset
+// Area (z, a) is entry (z-1) * areasPerZone + (a-1). Bit i of the bitmap
+// (word i / 64, bit i % 64) is set when slot id i+1 is free.
+
+struct StatusCounter {
+    int32_t free;
+    int32_t occupied;
+};
+
+struct StatusRegionHeader {
+    static const uint32_t MAGIC = 0x54534b50;   // "PKST"
+    static const uint32_t RETIRED = 0x54524b50; // "PKRT": segment closed or replaced
+    static const uint32_t FORMAT_VERSION = 1;
+
+    // Written once before the segment is published, never changed
+    // (except magic, set to RETIRED when the segment goes away)
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint64_t regionBytes;
+    int32_t zoneCount;
+    int32_t areasPerZone;
+    int32_t slotsPerArea;
+    int32_t totalSlots;
+    uint32_t zoneOffset;
+    uint32_t areaOffset;
+    uint32_t bitmapOffset;
+    int32_t publisherPid;
+
+    std::atomic<uint64_t> sequence;   // odd while the writer is inside an update
+
+    // Guarded by sequence
+    uint64_t changeVersion;           // StatusChangeLog version of the data
+    int64_t updatedNanos;             // publisher Clock time of the last update
+    StatusCounter city;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock needs a lock-free counter");
+
+// -------- Writer (inside the ParkingSystem process) --------
+class StatusPublisher {
+private:
+    char name[64];
+    unsigned char* base;
+    size_t bytes;
+    StatusRegionHeader* header;
+    StatusCounter* zones;
+    StatusCounter* areas;
+    uint64_t* bitmap;
+
+    StatusPublisher(const StatusPublisher&);
+    StatusPublisher& operator=(const StatusPublisher&);
+
+public:
+    static const char* const DEFAULT_NAME;
+
+    StatusPublisher();
+    ~StatusPublisher();   // retires, unmaps and unlinks the segment
+
+    // Creates (or replaces) the segment with every slot free.
+    // Returns false and leaves the publisher closed on failure.
+    bool open(const char* segmentName, int zoneCount, int areasPerZone, int slotsPerArea);
+    bool isOpen() const;
+    const char* getName() const;
+    void close();   // marks the header RETIRED first, so readers can tell
+
+    // One seqlock-protected update; any number of setSlot() calls in between
+    void beginUpdate();
+    void setSlot(int slotId, int zoneId, int areaId, bool available);
+    void endUpdate(uint64_t changeVersion, int64_t nowNanos);
+};
+
+#endif
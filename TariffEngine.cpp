@@ -0,0 +1,152 @@
+#include "TariffEngine.h"
+#include <algorithm>
+
+// -------- TariffPlan --------
+TariffPlan::TariffPlan(const std::string& planName, int64_t entry, int64_t minimum,
+                       int64_t surcharge, const std::vector<TariffBand>& b)
+    : name(planName), entryFee(entry), minimumCharge(minimum),
+      crossZoneSurcharge(surcharge), bands(b) {
+    std::sort(bands.begin(), bands.end(),
+              [](const TariffBand& x, const TariffBand& y) { return x.startMinute < y.startMinute; });
+    compile();
+}
+
+// Minutes before the first band belong to the last band (it wraps past midnight)
+void TariffPlan::compile() {
+    minuteRate.assign(MINUTES_PER_DAY, 0);
+    cumulative.assign(MINUTES_PER_DAY + 1, 0);
+
+    if (!bands.empty()) {
+        size_t band = 0;
+        int64_t rate = bands.back().ratePerHour;
+        for (int m = 0; m < MINUTES_PER_DAY; m++) {
+            while (band < bands.size() && bands[band].startMinute <= m)
+                rate = bands[band++].ratePerHour;
+            minuteRate[m] = rate;
+        }
+    }
+
+    for (int m = 0; m < MINUTES_PER_DAY; m++)
+        cumulative[m + 1] = cumulative[m] + minuteRate[m] * 60;
+}
+
+const std::string& TariffPlan::getName() const {
+    return name;
+}
+
+int64_t TariffPlan::getEntryFee() const {
+    return entryFee;
+}
+
+int64_t TariffPlan::getCrossZoneSurcharge() const {
+    return crossZoneSurcharge;
+}
+
+const std::vector<TariffBand>& TariffPlan::getBands() const {
+    return bands;
+}
+
+// -------- SessionColumns --------
+void SessionColumns::reserve(size_t n) {
+    zoneId.reserve(n);
+    vehicleType.reserve(n);
+    crossZone.reserve(n);
+    occupySeconds.reserve(n);
+    releaseSeconds.reserve(n);
+    charge.reserve(n);
+}
+
+void SessionColumns::add(int zone, Vehicle::VehicleType type, bool cross, int64_t occupy, int64_t release) {
+    zoneId.push_back(zone);
+    vehicleType.push_back(static_cast<uint8_t>(type));
+    crossZone.push_back(cross ? 1 : 0);
+    occupySeconds.push_back(occupy);
+    releaseSeconds.push_back(release);
+    charge.push_back(0);
+}
+
+size_t SessionColumns::size() const {
+    return zoneId.size();
+}
+
+void SessionColumns::clear() {
+    zoneId.clear();
+    vehicleType.clear();
+    crossZone.clear();
+    occupySeconds.clear();
+    releaseSeconds.clear();
+    charge.clear();
+}
+
+// -------- TariffEngine --------
+TariffEngine::TariffEngine() : utcOffsetSeconds(5 * 3600) {
+    std::vector<TariffBand> carBands = { { 0, 2000 }, { 8 * 60, 4000 }, { 18 * 60, 3000 } };
+    std::vector<TariffBand> bikeBands = { { 0, 1000 }, { 8 * 60, 2000 }, { 18 * 60, 1500 } };
+
+    defaultPlan[Vehicle::CAR] = addPlan(TariffPlan("Car standard", 10000, 10000, 5000, carBands));
+    defaultPlan[Vehicle::BIKE] = addPlan(TariffPlan("Bike standard", 5000, 5000, 5000, bikeBands));
+}
+
+int TariffEngine::addPlan(const TariffPlan& plan) {
+    plans.push_back(plan);
+    return static_cast<int>(plans.size()) - 1;
+}
+
+void TariffEngine::setDefaultPlan(Vehicle::VehicleType type, int planIndex) {
+    if (planIndex >= 0 && planIndex < static_cast<int>(plans.size()))
+        defaultPlan[type] = planIndex;
+}
+
+void TariffEngine::setZonePlan(int zoneId, Vehicle::VehicleType type, int planIndex) {
+    if (zoneId < 1 || planIndex < -1 || planIndex >= static_cast<int>(plans.size()))
+        return;
+    if (static_cast<int>(zonePlan[type].size()) <= zoneId)
+        zonePlan[type].resize(zoneId + 1, -1);
+    zonePlan[type][zoneId] = planIndex;
+}
+
+void TariffEngine::setUtcOffsetSeconds(int64_t offset) {
+    utcOffsetSeconds = offset;
+}
+
+int TariffEngine::planFor(int zoneId, Vehicle::VehicleType type) const {
+    const std::vector<int>& overrides = zonePlan[type];
+    if (zoneId >= 0 && zoneId < static_cast<int>(overrides.size()) && overrides[zoneId] >= 0)
+        return overrides[zoneId];
+    return defaultPlan[type];
+}
+
+const TariffPlan& TariffEngine::getPlan(int zoneId, Vehicle::VehicleType type) const {
+    return plans[planFor(zoneId, type)];
+}
+
+int64_t TariffEngine::price(int zoneId, Vehicle::VehicleType type, bool crossZone,
+                            int64_t occupyNanos, int64_t releaseNanos) const {
+    int64_t start = occupyNanos / 1000000000LL + utcOffsetSeconds;
+    int64_t end = releaseNanos / 1000000000LL + utcOffsetSeconds;
+    return plans[planFor(zoneId, type)].priceStay(start, end, crossZone);
+}
+
+// Column-at-a-time: per row, the plan lookup and priceStay's two
+// cumulative-cost lookups. Band boundaries are already folded into the
+// plan's minute table; each row still branches on its zone override, an
+// empty stay, the cross-zone surcharge and the minimum charge.
+int64_t TariffEngine::priceBatch(SessionColumns& sessions) const {
+    size_t n = sessions.size();
+    sessions.charge.resize(n);
+
+    const int32_t* zone = sessions.zoneId.data();
+    const uint8_t* type = sessions.vehicleType.data();
+    const uint8_t* cross = sessions.crossZone.data();
+    const int64_t* occupy = sessions.occupySeconds.data();
+    const int64_t* release = sessions.releaseSeconds.data();
+    int64_t* charge = sessions.charge.data();
+
+    int64_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        const TariffPlan& plan = plans[planFor(zone[i], static_cast<Vehicle::VehicleType>(type[i]))];
+        charge[i] = plan.priceStay(occupy[i] + utcOffsetSeconds, release[i] + utcOffsetSeconds, cross[i] != 0);
+        total += charge[i];
+    }
+    return total;
+}
@@ -0,0 +1,117 @@
+#ifndef TARIFF_ENGINE_H
+#define TARIFF_ENGINE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Vehicle.h"
+
+// Duration- and time-of-day-based parking tariffs.
+//
+// All amounts are in paisa (1 Rs = 100 paisa) so settlement never
+// rounds per session more than once. A plan is a set of daily time bands,
+// each with an hourly rate. It is compiled into a per-minute cumulative
+// cost table, so pricing a session of any length is two table lookups.
+
+// Rate from startMinute (minute of day, local time) until the next band
+struct TariffBand {
+    int startMinute;
+    int64_t ratePerHour;
+};
+
+class TariffPlan {
+public:
+    static const int MINUTES_PER_DAY = 24 * 60;
+
+private:
+    std::string name;
+    int64_t entryFee;             // charged once per session
+    int64_t minimumCharge;        // floor for the whole session
+    int64_t crossZoneSurcharge;   // added when parked outside the requested zone
+    std::vector<TariffBand> bands;
+
+    // rate (paisa/hour) of each minute of the day, and the running cost in
+    // paisa*seconds/hour up to the start of each minute
+    std::vector<int64_t> minuteRate;
+    std::vector<int64_t> cumulative;
+
+    void compile();
+
+public:
+    TariffPlan(const std::string& name, int64_t entryFee, int64_t minimumCharge,
+               int64_t crossZoneSurcharge, const std::vector<TariffBand>& bands);
+
+    const std::string& getName() const;
+    int64_t getEntryFee() const;
+    int64_t getCrossZoneSurcharge() const;
+    const std::vector<TariffBand>& getBands() const;
+
+    // Cumulative time cost from local midnight of day 0 to localSeconds,
+    // in paisa*seconds/hour; the difference of two values prices a stay
+    int64_t costUpTo(int64_t localSeconds) const {
+        int64_t day = localSeconds / 86400;
+        int64_t second = localSeconds - day * 86400;
+        int minute = static_cast<int>(second / 60);
+        return day * cumulative[MINUTES_PER_DAY] + cumulative[minute] +
+               minuteRate[minute] * (second - minute * 60);
+    }
+
+    int64_t priceStay(int64_t startLocalSeconds, int64_t endLocalSeconds, bool crossZone) const {
+        int64_t timeCost = 0;
+        if (endLocalSeconds > startLocalSeconds)
+            timeCost = (costUpTo(endLocalSeconds) - costUpTo(startLocalSeconds) + 1800) / 3600;
+
+        int64_t total = entryFee + timeCost + (crossZone ? crossZoneSurcharge : 0);
+        return total > minimumCharge ? total : minimumCharge;
+    }
+};
+
+// -------- Columnar session batch --------
+// One row per completed session; priceBatch fills `charge`.
+struct SessionColumns {
+    std::vector<int32_t> zoneId;
+    std::vector<uint8_t> vehicleType;
+    std::vector<uint8_t> crossZone;
+    std::vector<int64_t> occupySeconds;   // Unix seconds
+    std::vector<int64_t> releaseSeconds;
+    std::vector<int64_t> charge;          // paisa
+
+    void reserve(size_t n);
+    void add(int zone, Vehicle::VehicleType type, bool cross, int64_t occupy, int64_t release);
+    size_t size() const;
+    void clear();
+};
+
+class TariffEngine {
+private:
+    std::vector<TariffPlan> plans;
+    std::vector<int> zonePlan[2];   // [type][zoneId] -> plan index, -1 = default
+    int defaultPlan[2];
+    int64_t utcOffsetSeconds;       // local time = UTC + offset, for the time bands
+
+    int planFor(int zoneId, Vehicle::VehicleType type) const;
+
+public:
+    // Default tariff: the allocation quote (Car 100 Rs, Bike 50 Rs,
+    // +50 Rs cross-zone) as the entry fee, plus day/evening/night hourly
+    // rates. Local time defaults to PKT (UTC+5).
+    TariffEngine();
+
+    // -------- Configuration --------
+    int addPlan(const TariffPlan& plan);                          // returns plan index
+    void setDefaultPlan(Vehicle::VehicleType type, int planIndex);
+    void setZonePlan(int zoneId, Vehicle::VehicleType type, int planIndex);
+    void setUtcOffsetSeconds(int64_t offset);
+
+    const TariffPlan& getPlan(int zoneId, Vehicle::VehicleType type) const;
+
+    // -------- Pricing --------
+    // Price of one stay from occupy to release (Unix nanoseconds), in paisa
+    int64_t price(int zoneId, Vehicle::VehicleType type, bool crossZone,
+                  int64_t occupyNanos, int64_t releaseNanos) const;
+
+    // Prices every row in one pass over the columns; returns the total
+    int64_t priceBatch(SessionColumns& sessions) const;
+};
+
+#endif
@@ -0,0 +1,421 @@
+#include "TrafficSimulator.h"
+#include "CommandParser.h"
+#include "ConsoleMute.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+
+typedef std::chrono::steady_clock WallClock;
+
+static const int64_t NANOS_PER_HOUR = 3600LL * Clock::NANOS_PER_SECOND;
+
+// Relative arrival intensity per hour of day (morning and evening peaks)
+static const double DAILY_PROFILE[24] = {
+    0.2, 0.1, 0.1, 0.1, 0.2, 0.4, 0.8, 1.6, 2.0, 1.6, 1.2, 1.2,
+    1.4, 1.3, 1.1, 1.1, 1.4, 1.9, 1.8, 1.3, 0.9, 0.7, 0.5, 0.3
+};
+static const double DAILY_PROFILE_MAX = 2.0;
+
+struct SimEvent {
+    enum Kind { ARRIVAL, OCCUPY, CANCEL, RELEASE, SAMPLE };
+
+    int64_t time;
+    Kind kind;
+    int zoneId;
+    VehiclePlate plate;
+    Vehicle::VehicleType type;
+
+    bool operator>(const SimEvent& other) const { return time > other.time; }
+};
+
+static int64_t elapsedNanos(WallClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(WallClock::now() - start).count();
+}
+
+static void captureAnalytics(const ParkingSystem& system, int64_t start, SimulationReport& report) {
+    const OccupancyAnalytics& analytics = system.getAnalytics();
+    OccupancyPoint peak;
+    if (analytics.getPeak(0, 0, RESOLUTION_HOUR, system.getClock().nowNanos(), peak) &&
+        peak.averageOccupied > 0) {
+        report.peakHourOffset = static_cast<double>(peak.startNanos - start) / NANOS_PER_HOUR;
+        report.peakHourUtilization = peak.getAverageUtilization();
+    }
+    report.dwell = analytics.getDwellHistogram(0);
+    report.wait = analytics.getWaitHistogram(0);
+}
+
+static double cityUtilization(const ParkingSystem& system) {
+    long long total = 0, occupied = 0;
+    for (auto zone : system.getZones()) {
+        total += zone->getTotalSlots();
+        occupied += zone->getOccupiedSlots();
+    }
+    return total ? static_cast<double>(occupied) / total : 0.0;
+}
+
+// -------- ZoneProfile / SimulationConfig --------
+ZoneProfile::ZoneProfile()
+    : arrivalsPerHour(20.0),
+      meanDwellHours(2.0),
+      dwellSpread(0.8),
+      meanWaitMinutes(10.0),
+      cancelProbability(0.05),
+      bikeRatio(0.3),
+      areaPreferenceRatio(0.3) {}
+
+SimulationConfig::SimulationConfig()
+    : durationHours(24.0), sampleMinutes(60.0), dailyPeaks(true), seed(42) {}
+
+const ZoneProfile& SimulationConfig::profileFor(int zoneId) const {
+    if (zoneId >= 1 && zoneId <= static_cast<int>(zoneProfiles.size()))
+        return zoneProfiles[zoneId - 1];
+    return defaultProfile;
+}
+
+// -------- SimulationReport --------
+SimulationReport::SimulationReport()
+    : wallSeconds(0.0), simulatedHours(0.0),
+      parkAttempts(0), parkRejected(0), crossZoneAllocations(0),
+      peakHourOffset(-1.0), peakHourUtilization(0.0) {}
+
+long long SimulationReport::getTotalOperations() const {
+    return park.getCount() + occupy.getCount() + release.getCount() +
+           cancel.getCount() + rollback.getCount();
+}
+
+double SimulationReport::getOperationsPerSecond() const {
+    return wallSeconds > 0 ? getTotalOperations() / wallSeconds : 0.0;
+}
+
+static void printLatencyRow(std::ostream& out, const char* name, const LatencyStats& stats) {
+    static const double PS[] = { 50.0, 90.0, 99.0, 99.9, 100.0 };
+    int64_t values[5];
+    stats.percentiles(PS, 5, values);
+
+    out << std::left << std::setw(10) << name << std::right
+        << std::setw(10) << stats.getCount()
+        << std::setw(8) << stats.getFailures();
+    for (int i = 0; i < 5; i++)
+        out << std::setw(10) << values[i];
+    out << "\n";
+}
+
+void SimulationReport::print(std::ostream& out) const {
+    long long parked = parkAttempts - parkRejected;
+
+    out << "\n========== SIMULATION REPORT ==========\n";
+    out << std::fixed << std::setprecision(2);
+    out << "Simulated: " << simulatedHours << " h in " << wallSeconds << " s wall\n";
+    out << "Operations: " << getTotalOperations()
+        << " (" << std::setprecision(0) << getOperationsPerSecond() << " ops/sec)\n";
+
+    out << "\nLatency (ns)\n";
+    out << std::left << std::setw(10) << "Op" << std::right
+        << std::setw(10) << "count" << std::setw(8) << "fail"
+        << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+        << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+    printLatencyRow(out, "PARK", park);
+    printLatencyRow(out, "OCCUPY", occupy);
+    printLatencyRow(out, "RELEASE", release);
+    printLatencyRow(out, "CANCEL", cancel);
+    printLatencyRow(out, "ROLLBACK", rollback);
+
+    out << std::setprecision(2);
+    out << "\nRejection rate: "
+        << (parkAttempts ? 100.0 * parkRejected / parkAttempts : 0.0) << "%"
+        << " (" << parkRejected << "/" << parkAttempts << ")\n";
+    out << "Cross-zone rate: "
+        << (parked ? 100.0 * crossZoneAllocations / parked : 0.0) << "%"
+        << " (" << crossZoneAllocations << "/" << parked << ")\n";
+
+    if (peakHourOffset >= 0) {
+        out << "Peak hour (last " << OccupancyAnalytics::HOUR_BUCKETS << " h): starts t="
+            << peakHourOffset << "h, mean utilization " << peakHourUtilization * 100.0 << "%\n";
+    }
+    out << "Dwell (min): p50 " << dwell.percentile(50) / 60e9
+        << "  p90 " << dwell.percentile(90) / 60e9
+        << "  p99 " << dwell.percentile(99) / 60e9 << "  (" << dwell.getCount() << " sessions)\n";
+    out << "Wait (min):  p50 " << wait.percentile(50) / 60e9
+        << "  p90 " << wait.percentile(90) / 60e9
+        << "  p99 " << wait.percentile(99) / 60e9 << "\n";
+
+    out << "\nUtilization over time\n";
+    for (const auto& sample : utilization) {
+        out << "  t=" << std::setw(7) << sample.hours << "h  "
+            << std::setw(6) << sample.utilization * 100.0 << "%"
+            << "  active " << sample.activeSessions << "\n";
+    }
+    out << "=======================================\n";
+    out.unsetf(std::ios::floatfield);
+}
+
+// -------- TrafficSimulator --------
+TrafficSimulator::TrafficSimulator(const SimulationConfig& c) : config(c) {}
+
+SimulationReport TrafficSimulator::runSynthetic(std::ostream* trace) {
+    VirtualClock clock;
+    ParkingSystem system(config.layout, &clock);
+    SimulationReport report;
+    ConsoleMute mute;
+
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent> > events;
+
+    const int64_t start = clock.nowNanos();
+    const int64_t end = start + static_cast<int64_t>(config.durationHours * NANOS_PER_HOUR);
+    const int64_t sampleStep = static_cast<int64_t>(config.sampleMinutes * 60.0 * Clock::NANOS_PER_SECOND);
+    long long plateCounter = 0;
+    long long activeSessions = 0;
+
+    // Non-homogeneous Poisson arrivals by thinning against the daily profile
+    auto nextArrival = [&](int zoneId, int64_t from) -> int64_t {
+        const ZoneProfile& profile = config.profileFor(zoneId);
+        if (profile.arrivalsPerHour <= 0.0)
+            return -1;
+
+        double peak = config.dailyPeaks ? DAILY_PROFILE_MAX : 1.0;
+        std::exponential_distribution<double> gap(profile.arrivalsPerHour * peak);
+        int64_t t = from;
+        while (true) {
+            t += static_cast<int64_t>(gap(rng) * NANOS_PER_HOUR);
+            if (t > end || !config.dailyPeaks)
+                return t;
+            int hour = static_cast<int>(((t / Clock::NANOS_PER_SECOND) % 86400) / 3600);
+            if (uniform(rng) * peak <= DAILY_PROFILE[hour])
+                return t;
+        }
+    };
+
+    auto writeTrace = [&](int64_t t, const char* text) {
+        if (trace)
+            *trace << std::fixed << std::setprecision(3)
+                   << static_cast<double>(t - start) / Clock::NANOS_PER_SECOND << " " << text << "\n";
+    };
+
+    for (int z = 1; z <= config.layout.zoneCount; z++) {
+        int64_t t = nextArrival(z, start);
+        if (t >= 0) {
+            SimEvent e = { t, SimEvent::ARRIVAL, z, VehiclePlate(), Vehicle::CAR };
+            events.push(e);
+        }
+    }
+    if (sampleStep > 0) {
+        SimEvent e = { start + sampleStep, SimEvent::SAMPLE, 0, VehiclePlate(), Vehicle::CAR };
+        events.push(e);
+    }
+
+    auto wallStart = WallClock::now();
+    char line[96];
+
+    while (!events.empty() && events.top().time <= end) {
+        SimEvent e = events.top();
+        events.pop();
+        clock.set(e.time);
+
+        switch (e.kind) {
+            case SimEvent::ARRIVAL: {
+                const ZoneProfile& profile = config.profileFor(e.zoneId);
+                char plateText[24];
+                std::snprintf(plateText, sizeof(plateText), "S%lld", ++plateCounter);
+                VehiclePlate plate(plateText);
+                Vehicle::VehicleType type = (uniform(rng) < profile.bikeRatio) ? Vehicle::BIKE : Vehicle::CAR;
+
+                int area = 0;
+                if (uniform(rng) < profile.areaPreferenceRatio)
+                    area = 1 + static_cast<int>(uniform(rng) * config.layout.areasPerZone) % config.layout.areasPerZone;
+
+                std::snprintf(line, sizeof(line), "PARK %s %d %d %d",
+                              plate.c_str(), type == Vehicle::CAR ? 1 : 2, e.zoneId, area);
+                writeTrace(e.time, line);
+
+                int fee = 0;
+                bool crossZone = false;
+                auto t0 = WallClock::now();
+                bool ok = (area == 0)
+                    ? system.createParkingRequest(plate, type, e.zoneId, fee, crossZone)
+                    : system.createParkingRequestWithArea(plate, type, e.zoneId, area, fee, crossZone);
+                report.park.record(elapsedNanos(t0), ok);
+
+                report.parkAttempts++;
+                if (!ok) {
+                    report.parkRejected++;
+                } else {
+                    activeSessions++;
+                    if (crossZone) report.crossZoneAllocations++;
+
+                    std::exponential_distribution<double> wait(1.0 / std::max(profile.meanWaitMinutes, 0.01));
+                    int64_t gateTime = e.time + static_cast<int64_t>(wait(rng) * 60.0 * Clock::NANOS_PER_SECOND);
+                    SimEvent next = { gateTime,
+                                      uniform(rng) < profile.cancelProbability ? SimEvent::CANCEL : SimEvent::OCCUPY,
+                                      e.zoneId, plate, type };
+                    events.push(next);
+                }
+
+                int64_t t = nextArrival(e.zoneId, e.time);
+                if (t >= 0) {
+                    SimEvent next = { t, SimEvent::ARRIVAL, e.zoneId, VehiclePlate(), Vehicle::CAR };
+                    events.push(next);
+                }
+                break;
+            }
+
+            case SimEvent::OCCUPY: {
+                std::snprintf(line, sizeof(line), "OCCUPY %s %d", e.plate.c_str(), e.type == Vehicle::CAR ? 1 : 2);
+                writeTrace(e.time, line);
+
+                auto t0 = WallClock::now();
+                bool ok = system.occupyParking(e.plate, e.type);
+                report.occupy.record(elapsedNanos(t0), ok);
+
+                if (ok) {
+                    const ZoneProfile& profile = config.profileFor(e.zoneId);
+                    double sigma = profile.dwellSpread;
+                    double mu = std::log(std::max(profile.meanDwellHours, 0.001)) - sigma * sigma / 2.0;
+                    std::lognormal_distribution<double> dwell(mu, sigma);
+                    SimEvent next = { e.time + static_cast<int64_t>(dwell(rng) * NANOS_PER_HOUR),
+                                      SimEvent::RELEASE, e.zoneId, e.plate, e.type };
+                    events.push(next);
+                }
+                break;
+            }
+
+            case SimEvent::CANCEL: {
+                std::snprintf(line, sizeof(line), "CANCEL %s %d", e.plate.c_str(), e.type == Vehicle::CAR ? 1 : 2);
+                writeTrace(e.time, line);
+
+                auto t0 = WallClock::now();
+                bool ok = system.cancelRequest(e.plate, e.type);
+                report.cancel.record(elapsedNanos(t0), ok);
+                if (ok) activeSessions--;
+                break;
+            }
+
+            case SimEvent::RELEASE: {
+                std::snprintf(line, sizeof(line), "RELEASE %s %d", e.plate.c_str(), e.type == Vehicle::CAR ? 1 : 2);
+                writeTrace(e.time, line);
+
+                auto t0 = WallClock::now();
+                bool ok = system.releaseParking(e.plate, e.type);
+                report.release.record(elapsedNanos(t0), ok);
+                if (ok) activeSessions--;
+                break;
+            }
+
+            case SimEvent::SAMPLE: {
+                UtilizationSample sample = { static_cast<double>(e.time - start) / NANOS_PER_HOUR,
+                                             cityUtilization(system), activeSessions };
+                report.utilization.push_back(sample);
+                SimEvent next = { e.time + sampleStep, SimEvent::SAMPLE, 0, VehiclePlate(), Vehicle::CAR };
+                events.push(next);
+                break;
+            }
+        }
+    }
+
+    captureAnalytics(system, start, report);
+    report.wallSeconds = elapsedNanos(wallStart) / 1e9;
+    report.simulatedHours = config.durationHours;
+    return report;
+}
+
+SimulationReport TrafficSimulator::replayTrace(std::istream& trace) {
+    VirtualClock clock;
+    ParkingSystem system(config.layout, &clock);
+    SimulationReport report;
+    ConsoleMute mute;
+
+    const int64_t start = clock.nowNanos();
+    const int64_t sampleStep = static_cast<int64_t>(config.sampleMinutes * 60.0 * Clock::NANOS_PER_SECOND);
+    int64_t nextSample = start + sampleStep;
+    int64_t lastTime = start;
+    long long activeSessions = 0;
+
+    std::string line;
+    Command cmd;
+    auto wallStart = WallClock::now();
+
+    while (std::getline(trace, line)) {
+        const char* text = line.c_str();
+        char* rest = nullptr;
+        double seconds = std::strtod(text, &rest);
+        if (rest == text || line[0] == '#')
+            continue;
+        if (!CommandParser::parse(rest, line.size() - (rest - text), cmd))
+            continue;
+
+        int64_t now = start + static_cast<int64_t>(seconds * Clock::NANOS_PER_SECOND);
+        while (sampleStep > 0 && nextSample <= now) {
+            clock.set(nextSample);
+            UtilizationSample sample = { static_cast<double>(nextSample - start) / NANOS_PER_HOUR,
+                                         cityUtilization(system), activeSessions };
+            report.utilization.push_back(sample);
+            nextSample += sampleStep;
+        }
+        clock.set(now);
+        if (now > lastTime) lastTime = now;
+
+        auto t0 = WallClock::now();
+        switch (cmd.type) {
+            case Command::PARK: {
+                int fee = 0;
+                bool crossZone = false;
+                bool ok = (cmd.requiredAttributes != 0 || cmd.preferredAttributes != 0)
+                    ? system.createParkingRequestWithAttributes(cmd.plate, cmd.vehicleType, cmd.zoneId, cmd.areaId,
+                                                                cmd.requiredAttributes, cmd.preferredAttributes,
+                                                                fee, crossZone)
+                    : (cmd.areaId == 0)
+                    ? system.createParkingRequest(cmd.plate, cmd.vehicleType, cmd.zoneId, fee, crossZone)
+                    : system.createParkingRequestWithArea(cmd.plate, cmd.vehicleType, cmd.zoneId,
+                                                          cmd.areaId, fee, crossZone);
+                report.park.record(elapsedNanos(t0), ok);
+                report.parkAttempts++;
+                if (!ok) {
+                    report.parkRejected++;
+                } else {
+                    activeSessions++;
+                    if (crossZone) report.crossZoneAllocations++;
+                }
+                break;
+            }
+            case Command::OCCUPY: {
+                bool ok = system.occupyParking(cmd.plate, cmd.vehicleType);
+                report.occupy.record(elapsedNanos(t0), ok);
+                break;
+            }
+            case Command::RELEASE: {
+                bool ok = system.releaseParking(cmd.plate, cmd.vehicleType);
+                report.release.record(elapsedNanos(t0), ok);
+                if (ok) activeSessions--;
+                break;
+            }
+            case Command::CANCEL: {
+                bool ok = system.cancelRequest(cmd.plate, cmd.vehicleType);
+                report.cancel.record(elapsedNanos(t0), ok);
+                if (ok) activeSessions--;
+                break;
+            }
+            case Command::ROLLBACK: {
+                bool ok = system.rollbackLast(cmd.count);
+                report.rollback.record(elapsedNanos(t0), ok);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    captureAnalytics(system, start, report);
+    report.wallSeconds = elapsedNanos(wallStart) / 1e9;
+    report.simulatedHours = static_cast<double>(lastTime - start) / NANOS_PER_HOUR;
+    return report;
+}
@@ -0,0 +1,90 @@
+#ifndef TRAFFIC_SIMULATOR_H
+#define TRAFFIC_SIMULATOR_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "ParkingSystem.h"
+#include "LatencyStats.h"
+
+// Traffic shape for one zone
+struct ZoneProfile {
+    double arrivalsPerHour;
+    double meanDwellHours;
+    double dwellSpread;          // log-normal sigma of dwell time
+    double meanWaitMinutes;      // PARK request -> vehicle reaches the gate
+    double cancelProbability;    // request cancelled instead of occupied
+    double bikeRatio;
+    double areaPreferenceRatio;  // share of requests naming a specific area
+
+    ZoneProfile();
+};
+
+struct SimulationConfig {
+    CityLayout layout;
+    std::vector<ZoneProfile> zoneProfiles;   // index = zoneId - 1; missing zones use defaultProfile
+    ZoneProfile defaultProfile;
+    double durationHours;
+    double sampleMinutes;                    // utilization sampling interval
+    bool dailyPeaks;                         // modulate arrivals by hour of day
+    unsigned int seed;
+
+    SimulationConfig();
+    const ZoneProfile& profileFor(int zoneId) const;
+};
+
+struct UtilizationSample {
+    double hours;
+    double utilization;
+    long long activeSessions;
+};
+
+struct SimulationReport {
+    double wallSeconds;
+    double simulatedHours;
+
+    LatencyStats park;
+    LatencyStats occupy;
+    LatencyStats release;
+    LatencyStats cancel;
+    LatencyStats rollback;
+
+    long long parkAttempts;
+    long long parkRejected;
+    long long crossZoneAllocations;
+
+    std::vector<UtilizationSample> utilization;
+
+    // From the system's OccupancyAnalytics at the end of the run
+    double peakHourOffset;        // hours since start; -1 if none
+    double peakHourUtilization;
+    LatencyHistogram dwell;       // nanoseconds
+    LatencyHistogram wait;
+
+    SimulationReport();
+    long long getTotalOperations() const;
+    double getOperationsPerSecond() const;
+    void print(std::ostream& out) const;
+};
+
+// Discrete-event driver for ParkingSystem running on a VirtualClock.
+// Events are processed in timestamp order with no sleeping, so the
+// simulation runs as fast as the engine allows.
+class TrafficSimulator {
+private:
+    SimulationConfig config;
+
+public:
+    explicit TrafficSimulator(const SimulationConfig& config);
+
+    // Synthetic Poisson arrivals with log-normal dwell per zone.
+    // If trace is non-null every generated operation is also written
+    // to it in replayable "<seconds> <command>" form.
+    SimulationReport runSynthetic(std::ostream* trace = nullptr);
+
+    // Replays a recorded gate trace: one "<seconds> <command>" per line,
+    // where <command> uses the text protocol (PARK/OCCUPY/RELEASE/...).
+    SimulationReport replayTrace(std::istream& trace);
+};
+
+#endif
@@ -1,9 +1,9 @@
 #include "Vehicle.h"
 
-Vehicle::Vehicle(const std::string& number, VehicleType t, int preferredZone)
+Vehicle::Vehicle(const VehiclePlate& number, VehicleType t, int preferredZone)
     : vehicleNumber(number), type(t), preferredZoneId(preferredZone) {}
 
-std::string Vehicle::getVehicleNumber() const {
+const VehiclePlate& Vehicle::getVehicleNumber() const {
     return vehicleNumber;
 }
 
@@ -20,5 +20,9 @@ bool Vehicle::isSameVehicle(const Vehicle& other) const {
 }
 
 std::string Vehicle::vehicleTypeToString(VehicleType type) {
+    return vehicleTypeName(type);
+}
+
+const char* Vehicle::vehicleTypeName(VehicleType type) {
     return (type == CAR) ? "Car" : "Bike";
 }
\ No newline at end of file
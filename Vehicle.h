@@ -2,6 +2,7 @@
 #define VEHICLE_H
 
 #include <string>
+#include "VehiclePlate.h"
 
 class Vehicle {
 public:
@@ -11,17 +12,18 @@ public:
     };
 
 private:
-    std::string vehicleNumber;
+    VehiclePlate vehicleNumber;
     VehicleType type;
     int preferredZoneId;
 
 public:
-    Vehicle(const std::string& number, VehicleType type, int preferredZone);
-    std::string getVehicleNumber() const;
+    Vehicle(const VehiclePlate& number, VehicleType type, int preferredZone);
+    const VehiclePlate& getVehicleNumber() const;
     VehicleType getVehicleType() const;
     int getPreferredZoneId() const;
     bool isSameVehicle(const Vehicle& other) const;
     static std::string vehicleTypeToString(VehicleType type);
+    static const char* vehicleTypeName(VehicleType type);   // same text, no allocation
 };
 
 #endif
@@ -0,0 +1,80 @@
+#include "VehiclePlate.h"
+#include <cstring>
+
+// -------- Normalize + Hash (FNV-1a) --------
+void VehiclePlate::assign(const char* text, size_t len) {
+    hash = 2166136261u;
+    length = 0;
+    valid = (text != nullptr && len > 0 && len <= static_cast<size_t>(CAPACITY));
+
+    if (!valid) {
+        chars[0] = '\0';
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        chars[i] = c;
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    chars[len] = '\0';
+    length = static_cast<uint8_t>(len);
+}
+
+// -------- Constructors --------
+VehiclePlate::VehiclePlate() {
+    assign(nullptr, 0);
+}
+
+VehiclePlate::VehiclePlate(const char* text) {
+    assign(text, text ? std::strlen(text) : 0);
+}
+
+VehiclePlate::VehiclePlate(const char* text, size_t len) {
+    assign(text, len);
+}
+
+VehiclePlate::VehiclePlate(const std::string& text) {
+    assign(text.data(), text.size());
+}
+
+// -------- Accessors --------
+const char* VehiclePlate::c_str() const {
+    return chars;
+}
+
+int VehiclePlate::size() const {
+    return length;
+}
+
+bool VehiclePlate::empty() const {
+    return length == 0;
+}
+
+bool VehiclePlate::isValid() const {
+    return valid;
+}
+
+uint32_t VehiclePlate::getHash() const {
+    return hash;
+}
+
+std::string VehiclePlate::toString() const {
+    return std::string(chars, length);
+}
+
+// -------- Comparison --------
+bool VehiclePlate::operator==(const VehiclePlate& other) const {
+    return hash == other.hash &&
+           length == other.length &&
+           std::memcmp(chars, other.chars, length) == 0;
+}
+
+bool VehiclePlate::operator!=(const VehiclePlate& other) const {
+    return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& out, const VehiclePlate& plate) {
+    return out.write(plate.c_str(), plate.size());
+}
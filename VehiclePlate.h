@@ -0,0 +1,53 @@
+#ifndef VEHICLE_PLATE_H
+#define VEHICLE_PLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Fixed-capacity licence plate stored inline (no heap).
+// Letters are normalized to upper case and the hash is computed once,
+// so copies are plain memcpy and comparisons usually stop at the hash.
+class VehiclePlate {
+public:
+    static const int CAPACITY = 15;   // + terminating '\0' = 16 bytes inline
+
+private:
+    char chars[CAPACITY + 1];
+    uint8_t length;
+    bool valid;                       // false if empty or longer than CAPACITY
+    uint32_t hash;
+
+    void assign(const char* text, size_t len);
+
+public:
+    // Constructors (implicit on purpose: existing string call sites keep working)
+    VehiclePlate();
+    VehiclePlate(const char* text);
+    VehiclePlate(const char* text, size_t len);
+    VehiclePlate(const std::string& text);
+
+    // -------- Accessors --------
+    const char* c_str() const;
+    int size() const;
+    bool empty() const;
+    bool isValid() const;
+    uint32_t getHash() const;
+    std::string toString() const;
+
+    // -------- Comparison --------
+    bool operator==(const VehiclePlate& other) const;
+    bool operator!=(const VehiclePlate& other) const;
+};
+
+// Hash functor for unordered containers keyed by plate
+struct VehiclePlateHash {
+    size_t operator()(const VehiclePlate& plate) const {
+        return plate.getHash();
+    }
+};
+
+std::ostream& operator<<(std::ostream& out, const VehiclePlate& plate);
+
+#endif
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include "CityState.h"
+#include "ParkingSystem.h"
+#include "WhatIfPlanner.h"
+
+// What-if planner: captures a live city once, then simulates every
+// scenario on its own O(1) fork of that state, in parallel.
+//
+//   WhatIf [--zones N] [--areas N] [--slots N] [--occupancy F]
+//          [--hours H] [--rate R] [--dwell M] [--seed S] [--threads T]
+//
+// --rate is city-wide arrivals per minute, --dwell the mean stay in
+// minutes. The scenarios compare closures of the busiest zone (zone 1
+// gets a triple share of demand) against leaving everything open.
+
+using namespace std;
+using WallClock = std::chrono::steady_clock;
+
+static void usage() {
+    cout << "Usage: WhatIf [--zones N] [--areas N] [--slots N] [--occupancy F]\n"
+         << "              [--hours H] [--rate R] [--dwell M] [--seed S] [--threads T]\n";
+}
+
+static double millisSince(WallClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(WallClock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    CityLayout layout(15, 3, 20);
+    PlanWorkload workload;
+    double occupancy = 0.6;
+    int threads = 4;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--help") == 0 || value == nullptr) {
+            usage();
+            return strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+
+        if (strcmp(arg, "--zones") == 0)          layout.zoneCount = atoi(value);
+        else if (strcmp(arg, "--areas") == 0)     layout.areasPerZone = atoi(value);
+        else if (strcmp(arg, "--slots") == 0)     layout.slotsPerArea = atoi(value);
+        else if (strcmp(arg, "--occupancy") == 0) occupancy = atof(value);
+        else if (strcmp(arg, "--hours") == 0)     workload.horizonMinutes = atof(value) * 60;
+        else if (strcmp(arg, "--rate") == 0)      workload.arrivalsPerMinute = atof(value);
+        else if (strcmp(arg, "--dwell") == 0)     workload.meanDwellMinutes = atof(value);
+        else if (strcmp(arg, "--seed") == 0)      workload.seed = static_cast<uint32_t>(atoi(value));
+        else if (strcmp(arg, "--threads") == 0)   threads = atoi(value);
+        else {
+            usage();
+            return 1;
+        }
+        i++;
+    }
+    if (layout.zoneCount < 2 || layout.areasPerZone < 2 || layout.slotsPerArea <= 0 || threads <= 0) {
+        cout << "❌ Need at least 2 zones, 2 areas, 1 slot and 1 thread\n";
+        return 1;
+    }
+
+    // -------- Live State --------
+    ParkingSystem system(layout);
+    std::mt19937 fill(workload.seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (auto zone : system.getZones())
+        for (auto& area : zone->getParkingAreas())
+            for (auto& slot : area.getSlots())
+                if (coin(fill) < occupancy)
+                    slot.markOccupied();
+
+    auto started = WallClock::now();
+    CityState base = CityState::capture(system);
+    double captureMillis = millisSince(started);
+
+    const int forks = 100000;
+    started = WallClock::now();
+    for (int i = 0; i < forks; i++) {
+        CityState fork = base;
+        if (!fork.sharesSlotsWith(base))
+            return 1;
+    }
+    double forkNanos = millisSince(started) * 1e6 / forks;
+
+    cout << "🏙️  " << layout.getTotalSlots() << " slots, " << base.getOccupiedSlots() << " occupied\n";
+    cout << "📸 Capture: " << captureMillis << " ms, fork: " << forkNanos << " ns\n";
+
+    // -------- Scenarios --------
+    workload.zoneWeights.assign(layout.zoneCount, 1.0);
+    workload.zoneWeights[0] = 3.0;
+    double eventStart = workload.horizonMinutes / 4;
+    double eventEnd = workload.horizonMinutes * 3 / 4;
+
+    std::vector<PlanScenario> scenarios;
+    scenarios.push_back(PlanScenario("baseline"));
+    scenarios.push_back(PlanScenario("close Z1-A2 for event").closeArea(eventStart, 1, 2).openArea(eventEnd, 1, 2));
+    scenarios.push_back(PlanScenario("close Z1-A1,A2 for event")
+                            .closeArea(eventStart, 1, 1).closeArea(eventStart, 1, 2)
+                            .openArea(eventEnd, 1, 1).openArea(eventEnd, 1, 2));
+    scenarios.push_back(PlanScenario("close Z1 for event").closeZone(eventStart, 1).openZone(eventEnd, 1));
+    scenarios.push_back(PlanScenario("close Z1 all day").closeZone(0, 1));
+    scenarios.push_back(PlanScenario("close Z2 for event").closeZone(eventStart, 2).openZone(eventEnd, 2));
+    scenarios.push_back(PlanScenario("demand +20%", 1.2));
+    scenarios.push_back(PlanScenario("demand +20%, close Z1", 1.2).closeZone(eventStart, 1).openZone(eventEnd, 1));
+
+    std::vector<ScenarioResult> results;
+    int occupiedBefore = base.getOccupiedSlots();
+    started = WallClock::now();
+    WhatIfPlanner::run(base, workload, scenarios, threads, results);
+    double runMillis = millisSince(started);
+
+    WhatIfPlanner::printComparison(results, cout);
+
+    double simulateMillis = 0;
+    for (const ScenarioResult& result : results)
+        simulateMillis += result.millis;
+    cout << "⏱️  " << scenarios.size() << " scenarios on " << threads << " threads: "
+         << runMillis << " ms wall, " << simulateMillis << " ms simulated\n";
+
+    if (base.getOccupiedSlots() != occupiedBefore) {
+        cout << "❌ Base state changed during planning\n";
+        return 1;
+    }
+    return 0;
+}
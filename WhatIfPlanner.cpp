@@ -0,0 +1,176 @@
+#include "WhatIfPlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <random>
+#include <thread>
+
+// -------- Scenario Builder --------
+PlanScenario::PlanScenario(const std::string& n, double scale) : name(n), demandScale(scale) {}
+
+PlanScenario& PlanScenario::closeArea(double atMinutes, int zoneId, int areaId) {
+    events.push_back(PlanEvent{ PlanEvent::CLOSE_AREA, atMinutes, zoneId, areaId });
+    return *this;
+}
+
+PlanScenario& PlanScenario::openArea(double atMinutes, int zoneId, int areaId) {
+    events.push_back(PlanEvent{ PlanEvent::OPEN_AREA, atMinutes, zoneId, areaId });
+    return *this;
+}
+
+PlanScenario& PlanScenario::closeZone(double atMinutes, int zoneId) {
+    events.push_back(PlanEvent{ PlanEvent::CLOSE_ZONE, atMinutes, zoneId, 0 });
+    return *this;
+}
+
+PlanScenario& PlanScenario::openZone(double atMinutes, int zoneId) {
+    events.push_back(PlanEvent{ PlanEvent::OPEN_ZONE, atMinutes, zoneId, 0 });
+    return *this;
+}
+
+PlanWorkload::PlanWorkload()
+    : horizonMinutes(240.0), arrivalsPerMinute(10.0), meanDwellMinutes(90.0),
+      meanRemainingMinutes(60.0), seed(1) {}
+
+ScenarioResult::ScenarioResult()
+    : arrivals(0), parked(0), rejected(0), crossZone(0), peakUtilization(0.0), minFreeSlots(0), millis(0.0) {}
+
+// -------- Simulation --------
+struct Departure {
+    double atMinutes;
+    int slotId;
+
+    bool operator>(const Departure& other) const { return atMinutes > other.atMinutes; }
+};
+
+static void applyEvent(CityState& state, const PlanEvent& event) {
+    switch (event.type) {
+        case PlanEvent::CLOSE_AREA: state.closeArea(event.zoneId, event.areaId); break;
+        case PlanEvent::OPEN_AREA:  state.openArea(event.zoneId, event.areaId); break;
+        case PlanEvent::CLOSE_ZONE: state.closeZone(event.zoneId); break;
+        case PlanEvent::OPEN_ZONE:  state.openZone(event.zoneId); break;
+    }
+}
+
+void WhatIfPlanner::simulate(const CityState& base, const std::vector<int>& parkedAtStart,
+                             const PlanWorkload& workload, const PlanScenario& scenario,
+                             ScenarioResult& result) {
+    auto started = std::chrono::steady_clock::now();
+    CityState state = base;   // the fork: O(1), shares every node with base
+
+    std::mt19937 random(workload.seed);
+    std::exponential_distribution<double> remaining(1.0 / workload.meanRemainingMinutes);
+    std::exponential_distribution<double> dwell(1.0 / workload.meanDwellMinutes);
+    std::exponential_distribution<double> gap(workload.arrivalsPerMinute * scenario.demandScale);
+    std::discrete_distribution<int> pickZone;
+    if (workload.zoneWeights.empty())
+        pickZone = std::discrete_distribution<int>(state.getZoneCount(), 0.0, 1.0, [](double) { return 1.0; });
+    else
+        pickZone = std::discrete_distribution<int>(workload.zoneWeights.begin(), workload.zoneWeights.end());
+
+    std::priority_queue<Departure, std::vector<Departure>, std::greater<Departure>> departures;
+    for (int slotId : parkedAtStart)
+        departures.push(Departure{ remaining(random), slotId });
+
+    std::vector<PlanEvent> events = scenario.events;
+    std::stable_sort(events.begin(), events.end(),
+                     [](const PlanEvent& a, const PlanEvent& b) { return a.atMinutes < b.atMinutes; });
+    size_t nextEvent = 0;
+
+    result = ScenarioResult();
+    result.name = scenario.name;
+    result.rejectedByZone.assign(state.getZoneCount(), 0);
+    result.minFreeSlots = state.getFreeSlots();
+
+    double nextArrival = gap(random);
+    for (;;) {
+        double eventAt = nextEvent < events.size() ? events[nextEvent].atMinutes : workload.horizonMinutes;
+        double departureAt = departures.empty() ? workload.horizonMinutes : departures.top().atMinutes;
+        double now = std::min(std::min(eventAt, departureAt), nextArrival);
+        if (now >= workload.horizonMinutes)
+            break;
+
+        if (now == eventAt && nextEvent < events.size()) {
+            applyEvent(state, events[nextEvent++]);
+        } else if (now == departureAt && !departures.empty()) {
+            state.release(departures.top().slotId);
+            departures.pop();
+        } else {
+            // Draw everything for this arrival up front so the random
+            // stream does not depend on what the scenario did with it
+            int zoneId = pickZone(random) + 1;
+            double stay = dwell(random);
+            nextArrival = now + gap(random);
+
+            result.arrivals++;
+            bool crossZone = false;
+            int slotId = state.allocate(zoneId, 0, crossZone);
+            if (slotId < 0) {
+                result.rejected++;
+                result.rejectedByZone[zoneId - 1]++;
+            } else {
+                result.parked++;
+                if (crossZone) result.crossZone++;
+                departures.push(Departure{ now + stay, slotId });
+            }
+        }
+
+        if (state.getCapacity() > 0) {
+            double utilization = static_cast<double>(state.getOccupiedSlots()) / state.getCapacity();
+            if (utilization > result.peakUtilization) result.peakUtilization = utilization;
+        }
+        if (state.getFreeSlots() < result.minFreeSlots) result.minFreeSlots = state.getFreeSlots();
+    }
+
+    result.millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+void WhatIfPlanner::run(const CityState& base, const PlanWorkload& workload,
+                        const std::vector<PlanScenario>& scenarios, int threads,
+                        std::vector<ScenarioResult>& results) {
+    results.assign(scenarios.size(), ScenarioResult());
+    std::vector<int> parkedAtStart;
+    base.collectOccupied(parkedAtStart);
+
+    if (threads < 1) threads = 1;
+    if (threads > static_cast<int>(scenarios.size())) threads = static_cast<int>(scenarios.size());
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < scenarios.size(); i = next++)
+                simulate(base, parkedAtStart, workload, scenarios[i], results[i]);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+// -------- Report --------
+void WhatIfPlanner::printComparison(const std::vector<ScenarioResult>& results, std::ostream& out) {
+    if (results.empty())
+        return;
+    const ScenarioResult& baseline = results[0];
+
+    out << "\n========== WHAT-IF RESULTS ==========\n";
+    out << std::left << std::setw(26) << "Scenario" << std::right
+        << std::setw(9) << "Arrivals" << std::setw(9) << "Parked" << std::setw(9) << "Rejected"
+        << std::setw(10) << "vs base" << std::setw(8) << "Cross" << std::setw(8) << "Peak%"
+        << std::setw(9) << "MinFree" << "\n";
+    out << std::fixed << std::setprecision(1);
+    for (const ScenarioResult& result : results) {
+        out << std::left << std::setw(26) << result.name.substr(0, 25) << std::right
+            << std::setw(9) << result.arrivals << std::setw(9) << result.parked
+            << std::setw(9) << result.rejected
+            << std::setw(10) << std::showpos << (result.rejected - baseline.rejected) << std::noshowpos
+            << std::setw(8) << result.crossZone
+            << std::setw(8) << result.peakUtilization * 100
+            << std::setw(9) << result.minFreeSlots << "\n";
+    }
+    out << std::defaultfloat << std::setprecision(6);
+    out << "=====================================\n";
+}
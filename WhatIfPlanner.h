@@ -0,0 +1,82 @@
+#ifndef WHAT_IF_PLANNER_H
+#define WHAT_IF_PLANNER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "CityState.h"
+
+// One topology change at a point of the planning horizon
+struct PlanEvent {
+    enum Type { CLOSE_AREA, OPEN_AREA, CLOSE_ZONE, OPEN_ZONE };
+
+    Type type;
+    double atMinutes;
+    int zoneId;
+    int areaId;              // areas only
+};
+
+// A named list of changes to try against the live state, e.g.
+//   PlanScenario("event closure").closeArea(0, 4, 2).openArea(180, 4, 2)
+struct PlanScenario {
+    std::string name;
+    std::vector<PlanEvent> events;
+    double demandScale;      // multiplies PlanWorkload::arrivalsPerMinute
+
+    explicit PlanScenario(const std::string& name, double demandScale = 1.0);
+    PlanScenario& closeArea(double atMinutes, int zoneId, int areaId);
+    PlanScenario& openArea(double atMinutes, int zoneId, int areaId);
+    PlanScenario& closeZone(double atMinutes, int zoneId);
+    PlanScenario& openZone(double atMinutes, int zoneId);
+};
+
+// Demand model shared by every scenario of a run: Poisson arrivals,
+// exponential dwell, requested zone drawn by weight. Vehicles parked at
+// capture time leave after an exponential remaining time.
+struct PlanWorkload {
+    double horizonMinutes;
+    double arrivalsPerMinute;
+    double meanDwellMinutes;
+    double meanRemainingMinutes;
+    std::vector<double> zoneWeights;   // empty = uniform
+    uint32_t seed;
+
+    PlanWorkload();
+};
+
+struct ScenarioResult {
+    std::string name;
+    int arrivals;
+    int parked;
+    int rejected;            // no slot anywhere
+    int crossZone;
+    double peakUtilization;  // occupied / capacity, highest seen
+    int minFreeSlots;
+    std::vector<int> rejectedByZone;   // by requested zone, index zoneId - 1
+    double millis;           // simulation wall time
+
+    ScenarioResult();
+};
+
+// Runs scenarios against forks of one captured CityState on a pool of
+// worker threads. Every scenario draws the same random stream (common
+// random numbers), so differences between results come from the
+// scenario, not from sampling noise.
+class WhatIfPlanner {
+private:
+    static void simulate(const CityState& base, const std::vector<int>& parkedAtStart,
+                         const PlanWorkload& workload, const PlanScenario& scenario,
+                         ScenarioResult& result);
+
+public:
+    // results[i] belongs to scenarios[i]
+    static void run(const CityState& base, const PlanWorkload& workload,
+                    const std::vector<PlanScenario>& scenarios, int threads,
+                    std::vector<ScenarioResult>& results);
+
+    // Table of every scenario against the first one (the baseline)
+    static void printComparison(const std::vector<ScenarioResult>& results, std::ostream& out);
+};
+
+#endif
@@ -1,24 +1,24 @@
 #include "Zone.h"
-#include "ParkingArea.h"   // Full definition used here
 
 // -------- Constructor --------
-Zone::Zone(int id, const std::string& name)
-    : zoneId(id), zoneName(name) {}
+Zone::Zone(int id, const std::string& name, int areaCapacity)
+    : zoneId(id), zoneName(name), removed(false) {
+    parkingAreas.reserve(areaCapacity);
+}
 
 // -------- Identity --------
 int Zone::getZoneId() const {
     return zoneId;
 }
 
-std::string Zone::getZoneName() const {
+const std::string& Zone::getZoneName() const {
     return zoneName;
 }
 
 // -------- Parking Area Management --------
-void Zone::addParkingArea(ParkingArea* area) {
-    if (area != nullptr) {
-        parkingAreas.push_back(area);
-    }
+ParkingArea& Zone::addParkingArea(int areaId, const std::string& name, int slotCapacity) {
+    parkingAreas.push_back(ParkingArea(areaId, name, zoneId, slotCapacity));
+    return parkingAreas.back();
 }
 
 int Zone::getTotalParkingAreas() const {
@@ -28,16 +28,16 @@ int Zone::getTotalParkingAreas() const {
 // -------- Slot Statistics --------
 int Zone::getTotalSlots() const {
     int total = 0;
-    for (auto area : parkingAreas) {
-        total += area->getTotalSlots();
+    for (const auto& area : parkingAreas) {
+        total += area.getTotalSlots();
     }
     return total;
 }
 
 int Zone::getOccupiedSlots() const {
     int occupied = 0;
-    for (auto area : parkingAreas) {
-        occupied += area->getOccupiedSlots();
+    for (const auto& area : parkingAreas) {
+        occupied += area.getOccupiedSlots();
     }
     return occupied;
 }
@@ -51,15 +51,24 @@ bool Zone::isZoneFull() const {
 }
 
 // -------- Zone Adjacency & Preference --------
-void Zone::addNeighborZone(Zone* zone) {
-    if (zone != nullptr && zone != this) {
-        neighborZones.push_back(zone);
+void Zone::addNeighborZone(int id) {
+    if (id != zoneId) {
+        neighborZoneIds.push_back(id);
+    }
+}
+
+void Zone::removeNeighborZone(int id) {
+    for (size_t i = 0; i < neighborZoneIds.size(); i++) {
+        if (neighborZoneIds[i] == id) {
+            neighborZoneIds.erase(neighborZoneIds.begin() + i);
+            return;
+        }
     }
 }
 
 bool Zone::isNeighborZone(int id) const {
-    for (auto neighbor : neighborZones) {
-        if (neighbor->getZoneId() == id) {
+    for (auto neighbor : neighborZoneIds) {
+        if (neighbor == id) {
             return true;
         }
     }
@@ -79,7 +88,24 @@ double Zone::getUtilizationRate() const {
     return static_cast<double>(getOccupiedSlots()) / total;
 }
 
+// -------- Topology --------
+bool Zone::isRemoved() const {
+    return removed;
+}
+
+void Zone::markRemoved() {
+    removed = true;
+}
+
 // -------- Accessors --------
-const std::vector<ParkingArea*>& Zone::getParkingAreas() const {
+std::vector<ParkingArea>& Zone::getParkingAreas() {
     return parkingAreas;
+}
+
+const std::vector<ParkingArea>& Zone::getParkingAreas() const {
+    return parkingAreas;
+}
+
+const std::vector<int>& Zone::getNeighborZones() const {
+    return neighborZoneIds;
 }
\ No newline at end of file
@@ -4,30 +4,32 @@
 #include <string>
 #include <vector>
 
-// Forward declaration (definition comes in ParkingArea.h)
-class ParkingArea;
+#include "ParkingArea.h"
 
 class Zone {
 private:
     int zoneId;
     std::string zoneName;
 
-    // Parking areas inside this zone
-    std::vector<ParkingArea*> parkingAreas;
+    // Parking areas inside this zone, stored inline (area id = index + 1)
+    std::vector<ParkingArea> parkingAreas;
 
-    // Logical neighboring zones (custom adjacency, not graph)
-    std::vector<Zone*> neighborZones;
+    // Logical neighboring zones (custom adjacency, not graph), by zone id
+    std::vector<int> neighborZoneIds;
+
+    // Removed from the city: never reopened, kept so ids stay stable
+    bool removed;
 
 public:
     // Constructor
-    Zone(int id, const std::string& name);
+    Zone(int id, const std::string& name, int areaCapacity = 0);
 
     // -------- Zone Identity --------
     int getZoneId() const;
-    std::string getZoneName() const;
+    const std::string& getZoneName() const;
 
     // -------- Parking Area Management --------
-    void addParkingArea(ParkingArea* area);
+    ParkingArea& addParkingArea(int areaId, const std::string& name, int slotCapacity);
     int getTotalParkingAreas() const;
 
     // -------- Slot Statistics (Zone Level) --------
@@ -37,15 +39,22 @@ public:
     bool isZoneFull() const;
 
     // -------- Zone Preference / Cross-Zone Rules --------
-    void addNeighborZone(Zone* zone);
+    void addNeighborZone(int zoneId);
+    void removeNeighborZone(int zoneId);
     bool isNeighborZone(int zoneId) const;
     bool isCrossZoneAllowed() const;
 
     // -------- Utilization & Analytics --------
     double getUtilizationRate() const;
 
+    // -------- Topology --------
+    bool isRemoved() const;
+    void markRemoved();
+
     // -------- Accessors --------
-    const std::vector<ParkingArea*>& getParkingAreas() const;
+    std::vector<ParkingArea>& getParkingAreas();
+    const std::vector<ParkingArea>& getParkingAreas() const;
+    const std::vector<int>& getNeighborZones() const;
 };
 
 #endif
\ No newline at end of file